@@ -0,0 +1,441 @@
+#include "AtlasPacker.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <filesystem>
+#include <cstring>
+#include <cstdlib>
+#include <cassert>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kMinAtlasSize = 4; //!< block圧縮の4x4
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// SkylineNode structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct SkylineNode { //!< 埋まっている高さの輪郭の一区間
+		uint32_t x;
+		uint32_t y;
+		uint32_t width;
+	};
+
+	bool IsPowerOfTwo(uint32_t value) {
+		return value != 0 && (value & (value - 1)) == 0;
+	}
+
+	uint32_t AlignUp(uint32_t value, uint32_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	uint32_t NextPowerOfTwo(uint32_t value) {
+		uint32_t result = 1;
+
+		while (result < value) {
+			result <<= 1;
+		}
+
+		return result;
+	}
+
+	//! @brief skylineのindexの区間から幅widthを置いた場合の下端
+	//!
+	//! @retval true  置ける
+	//! @retval false 幅, 高さがatlasを超える
+	bool FitSkyline(const std::vector<SkylineNode>& skyline, size_t index, uint32_t width, uint32_t height, uint32_t atlasWidth, uint32_t atlasHeight, uint32_t& y) {
+		if (skyline[index].x + width > atlasWidth) {
+			return false;
+		}
+
+		y = 0;
+
+		uint32_t remain = width;
+
+		for (size_t i = index; remain > 0; ++i) {
+			assert(i < skyline.size()); //!< skylineはatlasの幅を覆っている
+
+			y      = (std::max)(y, skyline[i].y);
+			remain = remain > skyline[i].width ? remain - skyline[i].width : 0;
+		}
+
+		return y + height <= atlasHeight;
+	}
+
+	//! @brief skylineのindexの区間に(x, y, width)の区間を追加し, 隠れた区間を削る
+	void AddSkyline(std::vector<SkylineNode>& skyline, size_t index, uint32_t x, uint32_t y, uint32_t width) {
+		skyline.insert(skyline.begin() + index, { x, y, width });
+
+		uint32_t right = x + width;
+
+		for (size_t i = index + 1; i < skyline.size();) {
+			if (skyline[i].x >= right) {
+				break;
+			}
+
+			uint32_t nodeRight = skyline[i].x + skyline[i].width;
+
+			if (nodeRight <= right) {
+				skyline.erase(skyline.begin() + i);
+				continue;
+			}
+
+			skyline[i].width = nodeRight - right;
+			skyline[i].x     = right;
+			break;
+		}
+
+		// 同じ高さの区間を結合
+		for (size_t i = 0; i + 1 < skyline.size();) {
+			if (skyline[i].y == skyline[i + 1].y) {
+				skyline[i].width += skyline[i + 1].width;
+				skyline.erase(skyline.begin() + i + 1);
+				continue;
+			}
+
+			++i;
+		}
+	}
+
+	//! @brief 固定の大きさのatlasにcellを配置
+	//!
+	//! @param[in]  order      配置する順のcellのindex
+	//! @param[out] positions  cellの左上
+	//!
+	//! @retval true  全て配置できた
+	//! @retval false 収まらない
+	bool PackSkyline(
+		const std::vector<uint32_t>& cellWidths, const std::vector<uint32_t>& cellHeights, const std::vector<uint32_t>& order,
+		uint32_t atlasWidth, uint32_t atlasHeight, std::vector<std::pair<uint32_t, uint32_t>>& positions) {
+
+		std::vector<SkylineNode> skyline = { { 0, 0, atlasWidth } };
+
+		for (uint32_t index : order) {
+			uint32_t width  = cellWidths[index];
+			uint32_t height = cellHeights[index];
+
+			// 下端が最も低く, 同じ場合は最も左の位置
+			size_t   bestIndex = skyline.size();
+			uint32_t bestY     = UINT32_MAX;
+
+			for (size_t i = 0; i < skyline.size(); ++i) {
+				uint32_t y = 0;
+
+				if (FitSkyline(skyline, i, width, height, atlasWidth, atlasHeight, y) && y + height < bestY) {
+					bestIndex = i;
+					bestY     = y + height;
+				}
+			}
+
+			if (bestIndex == skyline.size()) {
+				return false;
+			}
+
+			uint32_t x = skyline[bestIndex].x;
+
+			positions[index] = { x, bestY - height };
+			AddSkyline(skyline, bestIndex, x, bestY, width);
+		}
+
+		return true;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// AtlasPacker methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool AtlasPacker::Pack(const std::vector<uint32_t>& widths, const std::vector<uint32_t>& heights, const AtlasOptions& options, AtlasLayout& layout) {
+	assert(widths.size() == heights.size());
+
+	if (!IsPowerOfTwo(options.padding)) {
+		return false;
+	}
+
+	uint32_t padding = options.padding;
+
+	// cellの大きさ. 画像をpaddingの倍数に切り上げ, 周囲にpaddingを加える
+	std::vector<uint32_t> cellWidths(widths.size());
+	std::vector<uint32_t> cellHeights(heights.size());
+
+	uint64_t area      = 0;
+	uint32_t maxWidth  = kMinAtlasSize;
+	uint32_t maxHeight = kMinAtlasSize;
+
+	for (size_t i = 0; i < widths.size(); ++i) {
+		assert(widths[i] != 0 && heights[i] != 0);
+
+		cellWidths[i]  = AlignUp(widths[i], padding) + padding * 2;
+		cellHeights[i] = AlignUp(heights[i], padding) + padding * 2;
+
+		area     += static_cast<uint64_t>(cellWidths[i]) * cellHeights[i];
+		maxWidth  = (std::max)(maxWidth, cellWidths[i]);
+		maxHeight = (std::max)(maxHeight, cellHeights[i]);
+	}
+
+	// 高い順, 同じ場合は幅の広い順に置く
+	std::vector<uint32_t> order(widths.size());
+	std::iota(order.begin(), order.end(), 0);
+
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+		if (cellHeights[a] != cellHeights[b]) {
+			return cellHeights[a] > cellHeights[b];
+		}
+
+		return cellWidths[a] > cellWidths[b];
+	});
+
+	uint32_t atlasWidth  = NextPowerOfTwo(maxWidth);
+	uint32_t atlasHeight = NextPowerOfTwo(maxHeight);
+
+	// 面積が足りない大きさは試さない
+	while (static_cast<uint64_t>(atlasWidth) * atlasHeight < area) {
+		if (atlasWidth <= atlasHeight) {
+			atlasWidth <<= 1;
+
+		} else {
+			atlasHeight <<= 1;
+		}
+	}
+
+	std::vector<std::pair<uint32_t, uint32_t>> positions(widths.size());
+
+	while (atlasWidth <= options.maxSize && atlasHeight <= options.maxSize) {
+		if (PackSkyline(cellWidths, cellHeights, order, atlasWidth, atlasHeight, positions)) {
+			layout.width   = atlasWidth;
+			layout.height  = atlasHeight;
+			layout.padding = padding;
+			layout.rects.resize(widths.size());
+
+			for (size_t i = 0; i < widths.size(); ++i) {
+				layout.rects[i] = { positions[i].first + padding, positions[i].second + padding, widths[i], heights[i] };
+			}
+
+			return true;
+		}
+
+		if (atlasWidth <= atlasHeight) {
+			atlasWidth <<= 1;
+
+		} else {
+			atlasHeight <<= 1;
+		}
+	}
+
+	return false;
+}
+
+uint32_t AtlasPacker::GetLevelCount(const AtlasLayout& layout) {
+	// level毎にpaddingが半分になり, 1pixelまで残るlevelまで
+	uint32_t paddingLevelCount = 1;
+
+	while ((layout.padding >> paddingLevelCount) != 0) {
+		++paddingLevelCount;
+	}
+
+	return (std::min)(paddingLevelCount, MipGenerator::GetLevelCount(layout.width, layout.height));
+}
+
+void AtlasPacker::Blit(const MipImage& source, const AtlasRect& rect, uint32_t level, uint32_t padding, const MipImage& atlas) {
+	assert((padding >> level) != 0); //!< GetLevelCountを超えたlevel
+
+	uint32_t left = rect.x >> level;
+	uint32_t top  = rect.y >> level;
+
+	// cellの範囲. 右, 下は切り捨てたmipの大きさより広く, uvの範囲を覆う
+	uint32_t cellLeft   = (rect.x - padding) >> level;
+	uint32_t cellTop    = (rect.y - padding) >> level;
+	uint32_t cellRight  = (rect.x + AlignUp(rect.width, padding) + padding) >> level;
+	uint32_t cellBottom = (rect.y + AlignUp(rect.height, padding) + padding) >> level;
+
+	assert(cellRight <= atlas.width && cellBottom <= atlas.height);
+
+	for (uint32_t ay = cellTop; ay < cellBottom; ++ay) {
+		uint32_t y = std::clamp(ay, top, top + source.height - 1) - top;
+
+		const uint8_t* sourceRow = source.pixels + source.rowPitch * y;
+		uint8_t*       atlasRow  = atlas.pixels + atlas.rowPitch * ay;
+
+		// 画像の行
+		std::memcpy(atlasRow + static_cast<size_t>(left) * 4, sourceRow, static_cast<size_t>(source.width) * 4);
+
+		// 左右の端を複製
+		for (uint32_t ax = cellLeft; ax < left; ++ax) {
+			std::memcpy(atlasRow + static_cast<size_t>(ax) * 4, sourceRow, 4);
+		}
+
+		for (uint32_t ax = left + source.width; ax < cellRight; ++ax) {
+			std::memcpy(atlasRow + static_cast<size_t>(ax) * 4, sourceRow + static_cast<size_t>(source.width - 1) * 4, 4);
+		}
+	}
+}
+
+MipChain AtlasPacker::Build(const std::vector<MipImage>& sources, const AtlasLayout& layout, const MipOptions& mipOptions, uint32_t threadCount) {
+	assert(sources.size() == layout.rects.size());
+
+	uint32_t levelCount = GetLevelCount(layout);
+
+	// 画像毎のmip. 元画像の1x1より多いlevelは1x1を使う
+	std::vector<MipChain> chains(sources.size());
+
+	for (size_t i = 0; i < sources.size(); ++i) {
+		const MipImage& source = sources[i];
+		assert(source.width == layout.rects[i].width && source.height == layout.rects[i].height);
+
+		chains[i] = MipGenerator::CreateChain(
+			source.width, source.height, (std::min)(levelCount, MipGenerator::GetLevelCount(source.width, source.height))
+		);
+
+		for (uint32_t y = 0; y < source.height; ++y) {
+			std::memcpy(chains[i].levels[0].pixels + chains[i].levels[0].rowPitch * y, source.pixels + source.rowPitch * y, static_cast<size_t>(source.width) * 4);
+		}
+	}
+
+	MipGenerator::Generate(chains, mipOptions, threadCount);
+
+	// 画像のない領域は0 (透明な黒)
+	MipChain result = MipGenerator::CreateChain(layout.width, layout.height, levelCount);
+	std::fill(result.pixels.begin(), result.pixels.end(), uint8_t(0));
+
+	for (uint32_t level = 0; level < levelCount; ++level) {
+		for (size_t i = 0; i < chains.size(); ++i) {
+			const MipChain& chain = chains[i];
+
+			Blit(chain.levels[(std::min)(level, static_cast<uint32_t>(chain.levels.size()) - 1)], layout.rects[i], level, layout.padding, result.levels[level]);
+		}
+	}
+
+	return result;
+}
+
+Matrix4x4 AtlasPacker::MakeUvTransform(const AtlasLayout& layout, uint32_t index) {
+	const AtlasRect& rect = layout.rects[index];
+
+	float width  = static_cast<float>(layout.width);
+	float height = static_cast<float>(layout.height);
+
+	return Matrix::MakeScale({ rect.width / width, rect.height / height, 1.0f })
+		* Matrix::MakeTranslate({ rect.x / width, rect.y / height, 0.0f });
+}
+
+bool AtlasPacker::WriteLayout(const std::string& filePath, const AtlasLayout& layout) {
+	assert(layout.rects.size() == layout.filePaths.size());
+
+	std::ofstream file(filePath, std::ios::trunc);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	file << "atlas " << layout.width << " " << layout.height << " " << layout.padding << "\n";
+
+	for (size_t i = 0; i < layout.rects.size(); ++i) {
+		const AtlasRect& rect = layout.rects[i];
+		file << rect.x << " " << rect.y << " " << rect.width << " " << rect.height << " " << layout.filePaths[i] << "\n";
+	}
+
+	return file.good();
+}
+
+bool AtlasPacker::ReadLayout(const std::string& filePath, AtlasLayout& layout) {
+	std::ifstream file(filePath);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	layout = {};
+
+	std::string line;
+
+	{ //!< header
+		std::getline(file, line);
+		std::istringstream stream(line);
+
+		std::string identifier;
+		stream >> identifier >> layout.width >> layout.height >> layout.padding;
+
+		if (stream.fail() || identifier != "atlas" || !IsPowerOfTwo(layout.padding)) {
+			return false;
+		}
+	}
+
+	while (std::getline(file, line)) {
+		if (line.empty()) {
+			continue;
+		}
+
+		std::istringstream stream(line);
+
+		AtlasRect rect = {};
+
+		if (!(stream >> rect.x >> rect.y >> rect.width >> rect.height)) {
+			return false;
+		}
+
+		// 残りをファイルパスとする. 空白を含むパスも扱える
+		std::string path;
+		std::getline(stream >> std::ws, path);
+
+		if (path.empty()) {
+			return false;
+		}
+
+		if (rect.x + rect.width > layout.width || rect.y + rect.height > layout.height) {
+			return false;
+		}
+
+		layout.rects.push_back(rect);
+		layout.filePaths.push_back(path);
+	}
+
+	return true;
+}
+
+bool AtlasPacker::IsLayoutFile(const std::string& filePath) {
+	return std::filesystem::path(filePath).extension() == kExtension;
+}
+
+bool AtlasPacker::ParseCommandLine(
+	const std::string& commandLine, std::string& outputPath, std::vector<std::string>& filePaths,
+	AtlasOptions& options, TextureCooker::CookOptions& cookOptions) {
+
+	std::vector<std::string> tokens = TextureCooker::SplitCommandLine(commandLine);
+
+	if (tokens.empty() || tokens[0] != kCommandLineArg) {
+		return false;
+	}
+
+	outputPath.clear();
+	filePaths.clear();
+	options     = {};
+	cookOptions = {};
+
+	for (size_t i = 1; i < tokens.size(); ++i) {
+		const std::string& token = tokens[i];
+
+		if (token == "--padding" && i + 1 < tokens.size()) {
+			options.padding = static_cast<uint32_t>(std::strtoul(tokens[++i].c_str(), nullptr, 10)); //!< 2の累乗でない場合はPackで失敗する
+
+		} else if (TextureCooker::ParseOption(token, cookOptions)) {
+			continue;
+
+		} else if (outputPath.empty()) { //!< 最初のファイルパスは出力先
+			outputPath = token;
+
+		} else {
+			filePaths.push_back(token);
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// engine
+#include <MipGenerator.h>
+#include <TextureCooker.h>
+
+// Geometry
+#include <Matrix4x4.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// AtlasRect structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct AtlasRect { //!< level0でのpixel範囲. paddingを含まない
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+	uint32_t height;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// AtlasOptions structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct AtlasOptions {
+	uint32_t padding = 16;   //!< level0で画像の周囲に複製する端のpixel数. 2の累乗. mip数はlog2(padding) + 1までとなる
+	uint32_t maxSize = 4096; //!< atlasの幅, 高さの上限
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// AtlasLayout structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct AtlasLayout { //!< 配置ファイルの内容
+	uint32_t width   = 0;
+	uint32_t height  = 0;
+	uint32_t padding = 0;
+
+	std::vector<AtlasRect>   rects;
+	std::vector<std::string> filePaths; //!< rectsと同じ順の元画像のファイルパス
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// AtlasPacker namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace AtlasPacker { //!< 小さいtextureを一枚にまとめる. D3D12に依存しない
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const char kExtension[]      = ".atlas";
+	static const char kCommandLineArg[] = "--build-atlas";
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief skyline (bottom-left) で配置する
+	//!
+	//! 画像は幅, 高さをpaddingの倍数に切り上げ, 周囲にpaddingを加えたcellに置くため, 位置はpaddingの倍数となる.
+	//! atlasは2の累乗で, 収まるまで幅, 高さの小さい方を倍にする
+	//!
+	//! @param[in]  widths  各画像の幅
+	//! @param[in]  heights 各画像の高さ
+	//! @param[in]  options padding, 大きさの上限
+	//! @param[out] layout  幅, 高さ, padding, 画像の範囲. filePathsは変更しない
+	//!
+	//! @retval true  配置できた
+	//! @retval false maxSizeに収まらない, またはpaddingが2の累乗ではない
+	bool Pack(const std::vector<uint32_t>& widths, const std::vector<uint32_t>& heights, const AtlasOptions& options, AtlasLayout& layout);
+
+	//! @brief 隣の画像の色が混ざらないmip数
+	uint32_t GetLevelCount(const AtlasLayout& layout);
+
+	//! @brief 画像のmipをatlasのmipに書き込み, cellの残りに端のpixelを複製する
+	//!
+	//! 左, 上はpadding, 右, 下は切り上げた分も含めてlevel分だけ縮めた幅となる
+	//!
+	//! @param[in] source  画像のlevelのmip
+	//! @param[in] rect    画像のlevel0での範囲
+	//! @param[in] level   書き込むlevel
+	//! @param[in] padding level0のpadding
+	//! @param[in] atlas   atlasのlevelのmip
+	void Blit(const MipImage& source, const AtlasRect& rect, uint32_t level, uint32_t padding, const MipImage& atlas);
+
+	//! @brief 画像毎にmipを生成し, atlasの各levelに書き込む
+	//!
+	//! mipは画像毎に生成するため, 隣の画像の色は混ざらない
+	//!
+	//! @param[in]  sources     8bit RGBAの画像. layout.rectsと同じ順, 同じ大きさ
+	//! @param[in]  layout      Packの結果
+	//! @param[in]  mipOptions  画像のmipの生成方法
+	//! @param[in]  threadCount mip生成に使用するスレッド数. 0の場合はParallel::GetThreadCount()
+	//!
+	//! @return GetLevelCount分のmipを持つatlasを返却
+	MipChain Build(const std::vector<MipImage>& sources, const AtlasLayout& layout, const MipOptions& mipOptions, uint32_t threadCount = 0);
+
+	//! @brief 元のuvをatlas上のuvに変換する行列. Material::uvTransformの右から掛ける
+	//!
+	//! 元のuvが[0, 1]の範囲の場合のみ正しい. samplerのwrapによる繰り返しはできない
+	Matrix4x4 MakeUvTransform(const AtlasLayout& layout, uint32_t index);
+
+	//! @brief 配置をテキストで書き込む. 一行目に"atlas 幅 高さ padding", 以降"x y 幅 高さ ファイルパス"
+	bool WriteLayout(const std::string& filePath, const AtlasLayout& layout);
+
+	//! @brief WriteLayoutで書き込んだ配置を読み込む
+	bool ReadLayout(const std::string& filePath, AtlasLayout& layout);
+
+	//! @brief 配置ファイルのパスか
+	bool IsLayoutFile(const std::string& filePath);
+
+	//! @brief "--build-atlas [--padding n] [--bc1|--bc3|--bc7] [--linear] [--kaiser] output files..." を解析
+	//!
+	//! @param[in]  commandLine コマンドライン引数
+	//! @param[out] outputPath  配置ファイルのパス. atlasはTextureCooker::GetCookedFilePathに書き込む
+	//! @param[out] filePaths   まとめる画像のファイルパス
+	//! @param[out] options     padding
+	//! @param[out] cookOptions 圧縮format
+	//!
+	//! @retval true  atlasの指定だった
+	//! @retval false atlasの指定ではない
+	bool ParseCommandLine(
+		const std::string& commandLine, std::string& outputPath, std::vector<std::string>& filePaths,
+		AtlasOptions& options, TextureCooker::CookOptions& cookOptions
+	);
+
+}
\ No newline at end of file
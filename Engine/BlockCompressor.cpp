@@ -0,0 +1,669 @@
+#include "BlockCompressor.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cassert>
+
+// simd
+#include <emmintrin.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kPixelCount  = 16; //!< 4x4
+	constexpr uint32_t kRefineCount = 2;  //!< endpointの補正回数
+
+	//! @brief BC7の4bit indexの補間の重み (/64)
+	constexpr uint32_t kBc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// BlockPixels structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct BlockPixels { //!< channel毎に16pixelを並べる
+		alignas(16) float values[4][kPixelCount];
+	};
+
+	BlockPixels LoadBlock(const uint8_t* pixels) {
+		BlockPixels result;
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			for (uint32_t c = 0; c < 4; ++c) {
+				result.values[c][i] = pixels[i * 4 + c];
+			}
+		}
+
+		return result;
+	}
+
+	//=========================================================================================
+	// endpoint
+	//=========================================================================================
+
+	//! @brief 主成分軸に射影した両端をendpointとする
+	//!
+	//! @param[out] e0 射影が最大のendpoint
+	//! @param[out] e1 射影が最小のendpoint
+	void FitEndpoints(const BlockPixels& block, uint32_t channelCount, float (&e0)[4], float (&e1)[4]) {
+		float mean[4] = {};
+
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			for (uint32_t i = 0; i < kPixelCount; ++i) {
+				mean[c] += block.values[c][i];
+			}
+
+			mean[c] /= kPixelCount;
+		}
+
+		// 共分散行列
+		float covariance[4][4] = {};
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			for (uint32_t a = 0; a < channelCount; ++a) {
+				for (uint32_t b = a; b < channelCount; ++b) {
+					covariance[a][b] += (block.values[a][i] - mean[a]) * (block.values[b][i] - mean[b]);
+				}
+			}
+		}
+
+		for (uint32_t a = 0; a < channelCount; ++a) {
+			for (uint32_t b = 0; b < a; ++b) {
+				covariance[a][b] = covariance[b][a];
+			}
+		}
+
+		// べき乗法で主成分軸を求める
+		float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		for (uint32_t iteration = 0; iteration < 8; ++iteration) {
+			float next[4] = {};
+			float length  = 0.0f;
+
+			for (uint32_t a = 0; a < channelCount; ++a) {
+				for (uint32_t b = 0; b < channelCount; ++b) {
+					next[a] += covariance[a][b] * axis[b];
+				}
+
+				length = (std::max)(length, std::abs(next[a]));
+			}
+
+			if (length < 1e-6f) { //!< 全pixelが同じ色
+				break;
+			}
+
+			for (uint32_t a = 0; a < channelCount; ++a) {
+				axis[a] = next[a] / length;
+			}
+		}
+
+		float minT = 0.0f;
+		float maxT = 0.0f;
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			float t = 0.0f;
+
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				t += (block.values[c][i] - mean[c]) * axis[c];
+			}
+
+			minT = (std::min)(minT, t);
+			maxT = (std::max)(maxT, t);
+		}
+
+		// axisは各成分の最大絶対値が1なので, 係数を射影の範囲に合わせる
+		float lengthSq = 0.0f;
+
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			lengthSq += axis[c] * axis[c];
+		}
+
+		for (uint32_t c = 0; c < 4; ++c) {
+			float direction = c < channelCount ? axis[c] / lengthSq : 0.0f;
+
+			e0[c] = std::clamp(mean[c] + direction * maxT, 0.0f, 255.0f);
+			e1[c] = std::clamp(mean[c] + direction * minT, 0.0f, 255.0f);
+		}
+	}
+
+	//! @brief paletteの最も近い色を選ぶ (SSE2)
+	//!
+	//! @return 二乗誤差の合計を返却
+	float SelectIndices(const BlockPixels& block, uint32_t channelCount, const float (*palette)[4], uint32_t paletteCount, uint8_t (&indices)[kPixelCount]) {
+		__m128 total = _mm_setzero_ps();
+
+		for (uint32_t quad = 0; quad < kPixelCount / 4; ++quad) {
+			__m128 channels[4];
+
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				channels[c] = _mm_load_ps(block.values[c] + quad * 4);
+			}
+
+			__m128 best      = _mm_set1_ps(3.4e38f);
+			__m128 bestIndex = _mm_setzero_ps();
+
+			for (uint32_t k = 0; k < paletteCount; ++k) {
+				__m128 distance = _mm_setzero_ps();
+
+				for (uint32_t c = 0; c < channelCount; ++c) {
+					__m128 diff = _mm_sub_ps(channels[c], _mm_set1_ps(palette[k][c]));
+					distance = _mm_add_ps(distance, _mm_mul_ps(diff, diff));
+				}
+
+				__m128 isBetter = _mm_cmplt_ps(distance, best);
+
+				best      = _mm_min_ps(distance, best);
+				bestIndex = _mm_or_ps(_mm_and_ps(isBetter, _mm_set1_ps(static_cast<float>(k))), _mm_andnot_ps(isBetter, bestIndex));
+			}
+
+			total = _mm_add_ps(total, best);
+
+			alignas(16) int32_t result[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(result), _mm_cvttps_epi32(bestIndex));
+
+			for (uint32_t i = 0; i < 4; ++i) {
+				indices[quad * 4 + i] = static_cast<uint8_t>(result[i]);
+			}
+		}
+
+		alignas(16) float sums[4];
+		_mm_store_ps(sums, total);
+
+		return sums[0] + sums[1] + sums[2] + sums[3];
+	}
+
+	//! @brief indexを固定し, 最小二乗法でendpointを求める
+	//!
+	//! @param[in] weights pixel毎のe1の重み. 色 = e0 * (1 - w) + e1 * w
+	//!
+	//! @return 解けない場合false
+	bool SolveEndpoints(const BlockPixels& block, uint32_t channelCount, const float (&weights)[kPixelCount], float (&e0)[4], float (&e1)[4]) {
+		float aa = 0.0f;
+		float ab = 0.0f;
+		float bb = 0.0f;
+
+		float rhs0[4] = {};
+		float rhs1[4] = {};
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			float b = weights[i];
+			float a = 1.0f - b;
+
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				rhs0[c] += a * block.values[c][i];
+				rhs1[c] += b * block.values[c][i];
+			}
+		}
+
+		float determinant = aa * bb - ab * ab;
+
+		if (std::abs(determinant) < 1e-6f) { //!< 全pixelが同じindex
+			return false;
+		}
+
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			e0[c] = std::clamp((bb * rhs0[c] - ab * rhs1[c]) / determinant, 0.0f, 255.0f);
+			e1[c] = std::clamp((aa * rhs1[c] - ab * rhs0[c]) / determinant, 0.0f, 255.0f);
+		}
+
+		return true;
+	}
+
+	//=========================================================================================
+	// BC1
+	//=========================================================================================
+
+	uint16_t QuantizeTo565(const float (&color)[4]) {
+		uint32_t r = static_cast<uint32_t>(color[0] * 31.0f / 255.0f + 0.5f);
+		uint32_t g = static_cast<uint32_t>(color[1] * 63.0f / 255.0f + 0.5f);
+		uint32_t b = static_cast<uint32_t>(color[2] * 31.0f / 255.0f + 0.5f);
+
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	void Expand565(uint16_t value, uint32_t (&color)[4]) {
+		uint32_t r = (value >> 11) & 0x1F;
+		uint32_t g = (value >> 5) & 0x3F;
+		uint32_t b = value & 0x1F;
+
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+		color[3] = 255;
+	}
+
+	//! @brief 4色modeのpalette
+	void BuildColorPalette(uint16_t c0, uint16_t c1, uint32_t (&palette)[4][4]) {
+		Expand565(c0, palette[0]);
+		Expand565(c1, palette[1]);
+
+		for (uint32_t c = 0; c < 4; ++c) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+	}
+
+	//! @brief BC1のcolor block. 常に4色mode
+	void EncodeColorBlock(const BlockPixels& block, uint8_t* result) {
+		float e0[4];
+		float e1[4];
+		FitEndpoints(block, 3, e0, e1);
+
+		float    bestError = 3.4e38f;
+		uint16_t bestC0    = 0;
+		uint16_t bestC1    = 0;
+		uint8_t  bestIndices[kPixelCount] = {};
+
+		// index -> e1の重み
+		constexpr float kWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+		for (uint32_t iteration = 0; iteration < kRefineCount; ++iteration) {
+			uint16_t c0 = QuantizeTo565(e0);
+			uint16_t c1 = QuantizeTo565(e1);
+
+			if (c0 < c1) { //!< c0 > c1 で4色mode
+				std::swap(c0, c1);
+			}
+
+			uint32_t palette[4][4];
+			BuildColorPalette(c0, c1, palette);
+
+			float paletteF[4][4];
+
+			for (uint32_t k = 0; k < 4; ++k) {
+				for (uint32_t c = 0; c < 4; ++c) {
+					paletteF[k][c] = static_cast<float>(palette[k][c]);
+				}
+			}
+
+			uint8_t indices[kPixelCount];
+			float   error = SelectIndices(block, 3, paletteF, c0 == c1 ? 1 : 4, indices);
+
+			if (error < bestError) {
+				bestError = error;
+				bestC0    = c0;
+				bestC1    = c1;
+				std::memcpy(bestIndices, indices, sizeof(indices));
+			}
+
+			if (c0 == c1) {
+				break;
+			}
+
+			float weights[kPixelCount];
+
+			for (uint32_t i = 0; i < kPixelCount; ++i) {
+				weights[i] = kWeights[indices[i]];
+			}
+
+			if (!SolveEndpoints(block, 3, weights, e0, e1)) {
+				break;
+			}
+		}
+
+		uint32_t indexBits = 0;
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			indexBits |= static_cast<uint32_t>(bestIndices[i]) << (i * 2);
+		}
+
+		std::memcpy(result + 0, &bestC0, sizeof(uint16_t));
+		std::memcpy(result + 2, &bestC1, sizeof(uint16_t));
+		std::memcpy(result + 4, &indexBits, sizeof(uint32_t));
+	}
+
+	void DecodeColorBlock(const uint8_t* block, uint8_t* pixels, bool isForceFourColor) {
+		uint16_t c0;
+		uint16_t c1;
+		uint32_t indexBits;
+		std::memcpy(&c0, block + 0, sizeof(uint16_t));
+		std::memcpy(&c1, block + 2, sizeof(uint16_t));
+		std::memcpy(&indexBits, block + 4, sizeof(uint32_t));
+
+		uint32_t palette[4][4];
+		BuildColorPalette(c0, c1, palette);
+
+		if (c0 <= c1 && !isForceFourColor) { //!< 3色mode + 透明
+			for (uint32_t c = 0; c < 3; ++c) {
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+
+			palette[3][3] = 0;
+		}
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			uint32_t index = (indexBits >> (i * 2)) & 0x3;
+
+			for (uint32_t c = 0; c < 4; ++c) {
+				pixels[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+			}
+		}
+	}
+
+	//=========================================================================================
+	// BC4
+	//=========================================================================================
+
+	//! @brief 一つのchannelをBC4の8段階modeで圧縮
+	void EncodeChannelBlock(const uint8_t* pixels, uint32_t channel, uint8_t* result) {
+		uint32_t minValue = 255;
+		uint32_t maxValue = 0;
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			minValue = (std::min)(minValue, static_cast<uint32_t>(pixels[i * 4 + channel]));
+			maxValue = (std::max)(maxValue, static_cast<uint32_t>(pixels[i * 4 + channel]));
+		}
+
+		result[0] = static_cast<uint8_t>(maxValue);
+		result[1] = static_cast<uint8_t>(minValue);
+
+		uint64_t indexBits = 0;
+
+		if (maxValue != minValue) {
+			float scale = 7.0f / (maxValue - minValue);
+
+			for (uint32_t i = 0; i < kPixelCount; ++i) {
+				// min = 0, max = 7 の段階
+				uint32_t step = static_cast<uint32_t>((pixels[i * 4 + channel] - minValue) * scale + 0.5f);
+
+				// 段階 -> index. index 0 = e0(max), 1 = e1(min), 2..7 = maxからminへの補間
+				uint32_t index = (step == 7) ? 0 : (step == 0) ? 1 : 8 - step;
+
+				indexBits |= static_cast<uint64_t>(index) << (i * 3);
+			}
+		}
+
+		std::memcpy(result + 2, &indexBits, 6);
+	}
+
+	void DecodeChannelBlock(const uint8_t* block, uint8_t* pixels, uint32_t channel) {
+		uint32_t e0 = block[0];
+		uint32_t e1 = block[1];
+
+		uint32_t palette[8] = { e0, e1 };
+
+		if (e0 > e1) {
+			for (uint32_t i = 2; i < 8; ++i) {
+				palette[i] = ((8 - i) * e0 + (i - 1) * e1) / 7;
+			}
+
+		} else {
+			for (uint32_t i = 2; i < 6; ++i) {
+				palette[i] = ((6 - i) * e0 + (i - 1) * e1) / 5;
+			}
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		uint64_t indexBits = 0;
+		std::memcpy(&indexBits, block + 2, 6);
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			pixels[i * 4 + channel] = static_cast<uint8_t>(palette[(indexBits >> (i * 3)) & 0x7]);
+		}
+	}
+
+	//=========================================================================================
+	// BC7
+	//=========================================================================================
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// BitWriter structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct BitWriter { //!< 下位bitから詰める
+		uint8_t* data;
+		uint32_t position = 0;
+
+		void Write(uint32_t value, uint32_t count) {
+			for (uint32_t i = 0; i < count; ++i, ++position) {
+				if ((value >> i) & 1) {
+					data[position >> 3] |= static_cast<uint8_t>(1 << (position & 7));
+				}
+			}
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// BitReader structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct BitReader {
+		const uint8_t* data;
+		uint32_t       position = 0;
+
+		uint32_t Read(uint32_t count) {
+			uint32_t result = 0;
+
+			for (uint32_t i = 0; i < count; ++i, ++position) {
+				result |= ((data[position >> 3] >> (position & 7)) & 1u) << i;
+			}
+
+			return result;
+		}
+	};
+
+	//! @brief endpointを7bit + p-bitに量子化. p-bitは誤差の小さい方
+	void QuantizeEndpoint(const float (&endpoint)[4], uint32_t (&quantized)[4], uint32_t& pbit) {
+		float bestError = 3.4e38f;
+
+		for (uint32_t p = 0; p < 2; ++p) {
+			uint32_t candidate[4];
+			float    error = 0.0f;
+
+			for (uint32_t c = 0; c < 4; ++c) {
+				candidate[c] = static_cast<uint32_t>(std::clamp((endpoint[c] - p) * 0.5f + 0.5f, 0.0f, 127.0f));
+
+				float diff = static_cast<float>(candidate[c] * 2 + p) - endpoint[c];
+				error += diff * diff;
+			}
+
+			if (error < bestError) {
+				bestError = error;
+				pbit      = p;
+				std::memcpy(quantized, candidate, sizeof(candidate));
+			}
+		}
+	}
+
+	void BuildBc7Palette(const uint32_t (&q0)[4], uint32_t p0, const uint32_t (&q1)[4], uint32_t p1, uint32_t (&palette)[16][4]) {
+		for (uint32_t k = 0; k < 16; ++k) {
+			for (uint32_t c = 0; c < 4; ++c) {
+				uint32_t a = q0[c] * 2 + p0;
+				uint32_t b = q1[c] * 2 + p1;
+
+				palette[k][c] = ((64 - kBc7Weights[k]) * a + kBc7Weights[k] * b + 32) >> 6;
+			}
+		}
+	}
+
+	//! @brief BC7 mode 6 (1 subset, RGBA 7bit + p-bit, 4bit index)
+	void EncodeBc7Block(const BlockPixels& block, uint8_t* result) {
+		float e0[4];
+		float e1[4];
+		FitEndpoints(block, 4, e0, e1);
+
+		float    bestError = 3.4e38f;
+		uint32_t bestQ0[4] = {};
+		uint32_t bestQ1[4] = {};
+		uint32_t bestP0    = 0;
+		uint32_t bestP1    = 0;
+		uint8_t  bestIndices[kPixelCount] = {};
+
+		for (uint32_t iteration = 0; iteration < kRefineCount; ++iteration) {
+			uint32_t q0[4];
+			uint32_t q1[4];
+			uint32_t p0 = 0;
+			uint32_t p1 = 0;
+			QuantizeEndpoint(e0, q0, p0);
+			QuantizeEndpoint(e1, q1, p1);
+
+			uint32_t palette[16][4];
+			BuildBc7Palette(q0, p0, q1, p1, palette);
+
+			float paletteF[16][4];
+
+			for (uint32_t k = 0; k < 16; ++k) {
+				for (uint32_t c = 0; c < 4; ++c) {
+					paletteF[k][c] = static_cast<float>(palette[k][c]);
+				}
+			}
+
+			uint8_t indices[kPixelCount];
+			float   error = SelectIndices(block, 4, paletteF, 16, indices);
+
+			if (error < bestError) {
+				bestError = error;
+				bestP0    = p0;
+				bestP1    = p1;
+				std::memcpy(bestQ0, q0, sizeof(q0));
+				std::memcpy(bestQ1, q1, sizeof(q1));
+				std::memcpy(bestIndices, indices, sizeof(indices));
+			}
+
+			float weights[kPixelCount];
+
+			for (uint32_t i = 0; i < kPixelCount; ++i) {
+				weights[i] = kBc7Weights[indices[i]] / 64.0f;
+			}
+
+			if (!SolveEndpoints(block, 4, weights, e0, e1)) {
+				break;
+			}
+		}
+
+		// 先頭pixelのindexは最上位bitが0でなければならない
+		if (bestIndices[0] & 0x8) {
+			std::swap(bestQ0, bestQ1);
+			std::swap(bestP0, bestP1);
+
+			for (auto& index : bestIndices) {
+				index = static_cast<uint8_t>(15 - index);
+			}
+		}
+
+		std::memset(result, 0, 16);
+
+		BitWriter writer = { result };
+		writer.Write(1 << 6, 7); //!< mode 6
+
+		for (uint32_t c = 0; c < 4; ++c) {
+			writer.Write(bestQ0[c], 7);
+			writer.Write(bestQ1[c], 7);
+		}
+
+		writer.Write(bestP0, 1);
+		writer.Write(bestP1, 1);
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			writer.Write(bestIndices[i], i == 0 ? 3 : 4);
+		}
+	}
+
+	void DecodeBc7Block(const uint8_t* block, uint8_t* pixels) {
+		BitReader reader = { block };
+
+		if (reader.Read(7) != (1 << 6)) {
+			assert(false); //!< mode 6以外
+			std::memset(pixels, 0, kPixelCount * 4);
+			return;
+		}
+
+		uint32_t q0[4];
+		uint32_t q1[4];
+
+		for (uint32_t c = 0; c < 4; ++c) {
+			q0[c] = reader.Read(7);
+			q1[c] = reader.Read(7);
+		}
+
+		uint32_t p0 = reader.Read(1);
+		uint32_t p1 = reader.Read(1);
+
+		uint32_t palette[16][4];
+		BuildBc7Palette(q0, p0, q1, p1, palette);
+
+		for (uint32_t i = 0; i < kPixelCount; ++i) {
+			uint32_t index = reader.Read(i == 0 ? 3 : 4);
+
+			for (uint32_t c = 0; c < 4; ++c) {
+				pixels[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+			}
+		}
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// BlockCompressor methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t BlockCompressor::GetBlockSize(TextureCompression compression) {
+	return compression == TEXTURE_COMPRESSION_BC1 ? 8 : 16;
+}
+
+void BlockCompressor::Encode(TextureCompression compression, const uint8_t* pixels, uint8_t* block) {
+	switch (compression) {
+		case TEXTURE_COMPRESSION_BC1:
+			EncodeColorBlock(LoadBlock(pixels), block);
+			break;
+
+		case TEXTURE_COMPRESSION_BC3:
+			EncodeChannelBlock(pixels, 3, block);
+			EncodeColorBlock(LoadBlock(pixels), block + 8);
+			break;
+
+		case TEXTURE_COMPRESSION_BC5:
+			EncodeChannelBlock(pixels, 0, block);
+			EncodeChannelBlock(pixels, 1, block + 8);
+			break;
+
+		case TEXTURE_COMPRESSION_BC7:
+			EncodeBc7Block(LoadBlock(pixels), block);
+			break;
+
+		default:
+			assert(false); //!< 未対応のformat
+			break;
+	}
+}
+
+void BlockCompressor::Decode(TextureCompression compression, const uint8_t* block, uint8_t* pixels) {
+	switch (compression) {
+		case TEXTURE_COMPRESSION_BC1:
+			DecodeColorBlock(block, pixels, false);
+			break;
+
+		case TEXTURE_COMPRESSION_BC3:
+			DecodeColorBlock(block + 8, pixels, true);
+			DecodeChannelBlock(block, pixels, 3);
+			break;
+
+		case TEXTURE_COMPRESSION_BC5:
+			DecodeChannelBlock(block, pixels, 0);
+			DecodeChannelBlock(block + 8, pixels, 1);
+
+			for (uint32_t i = 0; i < kPixelCount; ++i) {
+				pixels[i * 4 + 2] = 0;
+				pixels[i * 4 + 3] = 255;
+			}
+			break;
+
+		case TEXTURE_COMPRESSION_BC7:
+			DecodeBc7Block(block, pixels);
+			break;
+
+		default:
+			assert(false); //!< 未対応のformat
+			break;
+	}
+}
\ No newline at end of file
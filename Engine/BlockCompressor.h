@@ -0,0 +1,49 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+
+//-----------------------------------------------------------------------------------------
+// enum
+//-----------------------------------------------------------------------------------------
+enum TextureCompression {
+	TEXTURE_COMPRESSION_BC1, //!< RGB. alphaは1になる
+	TEXTURE_COMPRESSION_BC3, //!< RGBA
+	TEXTURE_COMPRESSION_BC5, //!< RG. normal map用. 常にlinear
+	TEXTURE_COMPRESSION_BC7, //!< RGBA. mode 6のみ
+
+	kTextureCompressionCount
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// BlockCompressor namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace BlockCompressor {
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 4x4 blockのbyteサイズを取得
+	uint32_t GetBlockSize(TextureCompression compression);
+
+	//! @brief 4x4 pixelを圧縮 (SSE2)
+	//!
+	//! endpointは主成分軸の両端から求め, 最小二乗法で一度補正する
+	//!
+	//! @param[in]  compression 圧縮format
+	//! @param[in]  pixels      8bit RGBAの4x4 pixel. 行順に64byte
+	//! @param[out] block       GetBlockSize分の領域が必要
+	void Encode(TextureCompression compression, const uint8_t* pixels, uint8_t* block);
+
+	//! @brief 4x4 blockを復元. BC7はmode 6のみ
+	//!
+	//! @param[in]  compression 圧縮format
+	//! @param[in]  block       圧縮されたblock
+	//! @param[out] pixels      8bit RGBAの4x4 pixel. 64byte必要
+	void Decode(TextureCompression compression, const uint8_t* block, uint8_t* pixels);
+
+}
\ No newline at end of file
@@ -28,10 +28,13 @@ void DirectXCommon::Init(WinApp* winApp, int32_t clientWidth, int32_t clientHeig
 
 	pipelineManager_ = std::make_unique<DxObject::PipelineManager>(devices_.get(), command_.get(), blendState_.get(), clientWidth, clientHeight);
 
+	stagingQueue_ = std::make_unique<DxObject::StagingQueue>();
+
 }
 
 void DirectXCommon::Term() {
 	// DxObjectの解放
+	stagingQueue_.reset(); //!< EndFrame, SentでGPUの完了を待っているので全て解放できる
 	pipelineManager_.reset();
 	depthStencil_.reset();
 	blendState_.reset();
@@ -97,6 +100,9 @@ void DirectXCommon::EndFrame() {
 
 	fences_->WaitGPU();
 
+	// 転送が終わったstaging bufferの解放
+	stagingQueue_->Release(fences_->GetFence()->GetCompletedValue());
+
 	command_->Reset();
 }
 
@@ -110,9 +116,22 @@ void DirectXCommon::Sent() {
 
 	fences_->WaitGPU();
 
+	// 転送が終わったstaging bufferの解放
+	stagingQueue_->Release(fences_->GetFence()->GetCompletedValue());
+
 	command_->Reset();
 }
 
+void DirectXCommon::UploadBuffer(DxObject::BufferIndex* buffer) {
+	// commandListはEndFrame, Sentで次のfenceValueをsignalする
+	buffer->Upload(command_->GetCommandList(), stagingQueue_.get(), fences_->GetFenceValue() + 1);
+}
+
+void DirectXCommon::PushStaging(ComPtr<ID3D12Resource>&& staging) {
+	uint64_t byteSize = staging->GetDesc().Width;
+	stagingQueue_->Push(std::move(staging), fences_->GetFenceValue() + 1, byteSize);
+}
+
 DirectXCommon* DirectXCommon::GetInstance() {
 	static DirectXCommon instance;
 	return &instance;
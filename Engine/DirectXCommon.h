@@ -16,6 +16,8 @@
 #include <DxRootSignature.h>
 #include <DxPipelineState.h>
 #include <DxPipelineManager.h>
+#include <DxStagingQueue.h>
+#include <DxBufferResource.h>
 
 // c++
 #include <memory>
@@ -56,6 +58,20 @@ public:
 	//!
 	void Sent();
 
+	//! @brief BUFFER_USAGE_STATIC のbufferの転送をcommandListに積む
+	//! 
+	//! staging bufferは転送を積んだcommandListのfence通過後, EndFrame, Sentで解放される
+	//! 
+	//! @param[in] buffer 転送前のstatic buffer
+	void UploadBuffer(DxObject::BufferIndex* buffer);
+
+	//! @brief commandListに転送を積んだstaging bufferを登録
+	//! 
+	//! EndFrame, Sentでfence通過後に解放される
+	//! 
+	//! @param[in] staging 転送元のresource
+	void PushStaging(ComPtr<ID3D12Resource>&& staging);
+
 	// ---- pipeline関係 ---- //
 
 	void SetPipelineType(PipelineType type) {
@@ -66,6 +82,10 @@ public:
 		pipelineManager_->SetBlendMode(mode);
 	}
 
+	void SetVertexFormat(VertexFormat format) {
+		pipelineManager_->SetVertexFormat(format);
+	}
+
 	void SetPipelineState() {
 		pipelineManager_->CreatePipeline();
 		pipelineManager_->SetPipeline();
@@ -79,6 +99,7 @@ public:
 	DxObject::Devices* GetDeviceObj() const { return devices_.get(); }
 	DxObject::DescriptorHeaps* GetDescriptorsObj() const { return descriptorHeaps_.get(); }
 	DxObject::SwapChain* GetSwapChainObj() const { return swapChains_.get(); } //!< ImGuiManagerで使う kBufferCount
+	const DxObject::StagingQueue* GetStagingQueue() const { return stagingQueue_.get(); }
 
 private:
 
@@ -98,6 +119,8 @@ private:
 
 	std::unique_ptr<DxObject::PipelineManager> pipelineManager_;
 
+	std::unique_ptr<DxObject::StagingQueue> stagingQueue_; //!< fence通過待ちのstaging buffer
+
 	UINT backBufferIndex_;
 
 	//=========================================================================================
@@ -0,0 +1,106 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+#include <cassert>
+#include <deque>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// DxObject namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace DxObject {
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// BasicStagingQueue class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	template <typename Resource>
+	class BasicStagingQueue { //!< 転送元のstaging bufferを, 転送を積んだcommandListのfenceを通過するまで保持する. Resourceはmoveできる型
+	public:
+
+		//=========================================================================================
+		// public methods
+		//=========================================================================================
+
+		//! @brief デストラクタ
+		~BasicStagingQueue() { Clear(); }
+
+		//! @brief staging bufferを登録
+		//!
+		//! @param[in] staging    転送元のresource
+		//! @param[in] fenceValue 転送を積んだcommandListが完了した時のfenceValue
+		//! @param[in] byteSize   resourceのbyteサイズ
+		void Push(Resource&& staging, uint64_t fenceValue, uint64_t byteSize);
+
+		//! @brief GPUが通過したfenceValue以下のstaging bufferを解放
+		//!
+		//! @param[in] completedFenceValue ID3D12Fence::GetCompletedValue
+		//!
+		//! @return 解放した数を返却
+		uint32_t Release(uint64_t completedFenceValue);
+
+		//! @brief 全て解放. GPUの完了を待ってから呼び出すこと
+		void Clear();
+
+		//! @brief 解放待ちの数を取得
+		size_t GetPendingCount() const { return entries_.size(); }
+
+		//! @brief 解放待ちのbyteサイズの合計を取得
+		uint64_t GetPendingByteSize() const { return pendingByteSize_; }
+
+	private:
+
+		////////////////////////////////////////////////////////////////////////////////////////////
+		// Entry structure
+		////////////////////////////////////////////////////////////////////////////////////////////
+		struct Entry {
+			Resource resource;
+			uint64_t fenceValue;
+			uint64_t byteSize;
+		};
+
+		//=========================================================================================
+		// private variables
+		//=========================================================================================
+
+		std::deque<Entry> entries_; //!< fenceValueの昇順
+		uint64_t          pendingByteSize_ = 0;
+
+	};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// BasicStagingQueue class methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Resource>
+void DxObject::BasicStagingQueue<Resource>::Push(Resource&& staging, uint64_t fenceValue, uint64_t byteSize) {
+	assert(entries_.empty() || entries_.back().fenceValue <= fenceValue); //!< fenceValueが戻っている
+
+	entries_.push_back({ std::move(staging), fenceValue, byteSize });
+	pendingByteSize_ += byteSize;
+}
+
+template <typename Resource>
+uint32_t DxObject::BasicStagingQueue<Resource>::Release(uint64_t completedFenceValue) {
+	uint32_t result = 0;
+
+	while (!entries_.empty() && entries_.front().fenceValue <= completedFenceValue) {
+		pendingByteSize_ -= entries_.front().byteSize;
+		entries_.pop_front();
+
+		++result;
+	}
+
+	return result;
+}
+
+template <typename Resource>
+void DxObject::BasicStagingQueue<Resource>::Clear() {
+	entries_.clear();
+	pendingByteSize_ = 0;
+}
\ No newline at end of file
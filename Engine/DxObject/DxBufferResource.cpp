@@ -19,7 +19,7 @@ void DxObject::BufferIndex::Term() {
 	indexSize_ = NULL;
 }
 
-bool DxObject::BufferIndex::CheckIndex(uint32_t index) {
+bool DxObject::BufferIndex::CheckIndex(uint32_t index) const {
 	if (index > indexSize_ - 1) {
 		assert(false); //!< indexがsize以上
 		return false;
@@ -28,6 +28,56 @@ bool DxObject::BufferIndex::CheckIndex(uint32_t index) {
 	return true;
 }
 
+void* DxObject::BufferIndex::CreateResource(ID3D12Device* device, size_t byteSize, BufferUsage usage, D3D12_RESOURCE_STATES readState) {
+	usage_     = usage;
+	readState_ = readState;
+
+	void* result = nullptr;
+
+	if (usage == BUFFER_USAGE_STATIC) {
+		// GPU専用のresourceと, 書き込み用のstaging buffer
+		resource_ = DxObjectMethod::CreateDefaultBufferResource(device, byteSize);
+		staging_  = DxObjectMethod::CreateBufferResource(device, byteSize);
+
+		staging_->Map(0, nullptr, &result);
+
+	} else {
+		resource_ = DxObjectMethod::CreateBufferResource(device, byteSize);
+
+		resource_->Map(0, nullptr, &result);
+	}
+
+	return result;
+}
+
+void DxObject::BufferIndex::Upload(ID3D12GraphicsCommandList* commandList, StagingQueue* stagingQueue, uint64_t fenceValue) {
+	if (staging_ == nullptr) {
+		assert(false); //!< BUFFER_USAGE_STATIC ではない, または転送済み
+		return;
+	}
+
+	uint64_t byteSize = staging_->GetDesc().Width;
+
+	staging_->Unmap(0, nullptr);
+
+	// staging buffer -> resource
+	commandList->CopyBufferRegion(resource_.Get(), 0, staging_.Get(), 0, byteSize);
+
+	D3D12_RESOURCE_BARRIER barrier = {};
+	barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.Transition.pResource   = resource_.Get();
+	barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+	barrier.Transition.StateAfter  = readState_;
+
+	commandList->ResourceBarrier(1, &barrier);
+
+	// GPUがコピーを終えるまでstaging bufferを保持
+	stagingQueue->Push(std::move(staging_), fenceValue, byteSize);
+	staging_ = nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // IndexBufferResource methods
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,10 +91,17 @@ DxObject::IndexBufferResource::IndexBufferResource(DxObject::Devices* devices, c
 
 	indexSize_ = (vertexBuffer->GetSize() - 2) * 3;
 	
-	Init(devices);
+	Init(devices, SelectFormat(vertexBuffer->GetSize()));
 }
 
-void DxObject::IndexBufferResource::Init(DxObject::Devices* devices) {
+void DxObject::IndexBufferResource::Init(DxObject::Devices* devices, DXGI_FORMAT format, BufferUsage usage) {
+
+	// formatの確認
+	if (format != DXGI_FORMAT_R16_UINT && format != DXGI_FORMAT_R32_UINT) {
+		assert(false); //!< indexに使えないformat
+	}
+
+	format_ = format;
 
 	// kMaxTrinagleCountの確認
 	if (indexSize_ % 3 != 0) {
@@ -56,16 +113,57 @@ void DxObject::IndexBufferResource::Init(DxObject::Devices* devices) {
 	// deviceを取り出す
 	ID3D12Device* device = devices->GetDevice();
 
-	// 配列分のBufferResourceを生成
-	resource_ = DxObjectMethod::CreateBufferResource(
+	// 配列分のBufferResourceを生成し, マッピング
+	dataArray32_ = static_cast<uint32_t*>(CreateResource(
 		device,
-		sizeof(uint32_t) * indexSize_
-	);
-
-	// resourceをマッピング
-	resource_->Map(0, nullptr, reinterpret_cast<void**>(&dataArray_));
+		GetStride() * indexSize_,
+		usage,
+		D3D12_RESOURCE_STATE_INDEX_BUFFER
+	));
 }
 
 void DxObject::IndexBufferResource::Term() {
 	resource_->Release();
 }
+
+void DxObject::IndexBufferResource::Memcpy(const uint32_t* value) {
+	assert(IsWritable()); //!< 転送済みのstatic buffer
+
+	if (format_ == DXGI_FORMAT_R32_UINT) {
+		memcpy(dataArray32_, value, sizeof(uint32_t) * indexSize_);
+		return;
+	}
+
+	for (uint32_t i = 0; i < indexSize_; ++i) {
+		assert(value[i] < kMaxIndex16VertexCount); //!< 16bitで表せない
+		dataArray16_[i] = static_cast<uint16_t>(value[i]);
+	}
+}
+
+void DxObject::IndexBufferResource::Memcpy(const uint16_t* value) {
+	assert(IsWritable()); //!< 転送済みのstatic buffer
+
+	if (format_ == DXGI_FORMAT_R16_UINT) {
+		memcpy(dataArray16_, value, sizeof(uint16_t) * indexSize_);
+		return;
+	}
+
+	for (uint32_t i = 0; i < indexSize_; ++i) {
+		dataArray32_[i] = value[i];
+	}
+}
+
+void DxObject::IndexBufferResource::Memcpy(uint32_t offset, const uint32_t* value, uint32_t count) {
+	assert(offset + count <= indexSize_); //!< 配列以上の範囲
+	assert(IsWritable());                 //!< 転送済みのstatic buffer
+
+	if (format_ == DXGI_FORMAT_R32_UINT) {
+		memcpy(dataArray32_ + offset, value, sizeof(uint32_t) * count);
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; ++i) {
+		assert(value[i] < kMaxIndex16VertexCount); //!< 16bitで表せない
+		dataArray16_[offset + i] = static_cast<uint16_t>(value[i]);
+	}
+}
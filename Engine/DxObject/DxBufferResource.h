@@ -15,6 +15,7 @@
 // DxObject
 #include <DxObjectMethod.h>
 #include <DxDevices.h>
+#include <DxStagingQueue.h>
 
 // ComPtr
 #include <ComPtr.h>
@@ -25,6 +26,16 @@
 #pragma comment(lib, "d3d12.lib")
 #pragma comment(lib, "dxgi.lib")
 
+////////////////////////////////////////////////////////////////////////////////////////////
+// BufferUsage enum
+////////////////////////////////////////////////////////////////////////////////////////////
+enum BufferUsage {
+	BUFFER_USAGE_DYNAMIC, //!< UPLOAD heap. マッピングしたままCPUから書き換える
+	BUFFER_USAGE_STATIC,  //!< DEFAULT heap. staging bufferに書き込み, Uploadで一度だけ転送する
+
+	kBufferUsageCount
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // DxObject namespace
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +70,21 @@ namespace DxObject {
 		//! @breif 配列のサイズを獲得
 		const uint32_t GetSize() const { return indexSize_; }
 
+		//! @brief BUFFER_USAGE_STATIC のstaging bufferからの転送をcommandListに積む
+		//! 
+		//! staging bufferはstagingQueueに渡され, fenceValueの通過後に解放される. 転送後はCPUから書き込めない
+		//! 
+		//! @param[in] commandList  転送を積むcommandList
+		//! @param[in] stagingQueue staging bufferの解放待ち
+		//! @param[in] fenceValue   commandListの完了時にsignalされるfenceValue
+		void Upload(ID3D12GraphicsCommandList* commandList, StagingQueue* stagingQueue, uint64_t fenceValue);
+
+		//! @brief bufferの使い方を取得
+		BufferUsage GetUsage() const { return usage_; }
+
+		//! @brief CPUから書き込めるか. BUFFER_USAGE_STATIC はUpload前のみ
+		bool IsWritable() const { return usage_ == BUFFER_USAGE_DYNAMIC || staging_ != nullptr; }
+
 	protected:
 
 		//=========================================================================================
@@ -66,12 +92,26 @@ namespace DxObject {
 		//=========================================================================================
 
 		ComPtr<ID3D12Resource> resource_;
+		ComPtr<ID3D12Resource> staging_; //!< BUFFER_USAGE_STATIC の転送元. Uploadまで保持
 
 		uint32_t indexSize_;
 
+		BufferUsage           usage_     = BUFFER_USAGE_DYNAMIC;
+		D3D12_RESOURCE_STATES readState_ = D3D12_RESOURCE_STATE_GENERIC_READ; //!< 転送後のresourceの状態
+
 		//=========================================================================================
 		// protected methods
 		//=========================================================================================
+
+		//! @brief usageに応じたresourceを生成し, CPUから書き込む先をマッピング
+		//! 
+		//! @param[in] device    ID3D12Device
+		//! @param[in] byteSize  バイトサイズ
+		//! @param[in] usage     bufferの使い方
+		//! @param[in] readState BUFFER_USAGE_STATIC の転送後の状態
+		//! 
+		//! @return マッピングした先頭アドレスを返却. BUFFER_USAGE_STATIC はstaging buffer
+		void* CreateResource(ID3D12Device* device, size_t byteSize, BufferUsage usage, D3D12_RESOURCE_STATES readState);
 		
 		//! @brief indexSizeより小さいか
 		//! 
@@ -79,7 +119,7 @@ namespace DxObject {
 		//! 
 		//! @retval true  正常終了
 		//! @retval false indexSizeを超過
-		bool CheckIndex(uint32_t index);
+		bool CheckIndex(uint32_t index) const;
 
 		BufferIndex() { indexSize_ = NULL; }
 
@@ -102,8 +142,9 @@ namespace DxObject {
 		//! 
 		//! @param[in] devices   DxObject::Devices
 		//! @param[in] indexSize 配列サイズ
-		BufferResource(DxObject::Devices* devices, uint32_t indexSize)
-			: BufferIndex(indexSize) { Init(devices); }
+		//! @param[in] usage     bufferの使い方. 書き換えないmeshはBUFFER_USAGE_STATIC
+		BufferResource(DxObject::Devices* devices, uint32_t indexSize, BufferUsage usage = BUFFER_USAGE_DYNAMIC)
+			: BufferIndex(indexSize) { Init(devices, usage); }
 
 		//! @brief デストラクタ
 		~BufferResource() { Term(); }
@@ -111,7 +152,8 @@ namespace DxObject {
 		//! @brief 初期化処理
 		//! 
 		//! @param[in] devices DxObject::Devices
-		void Init(DxObject::Devices* devices);
+		//! @param[in] usage   bufferの使い方
+		void Init(DxObject::Devices* devices, BufferUsage usage = BUFFER_USAGE_DYNAMIC);
 
 		//! @brief 終了処理
 		void Term();
@@ -155,15 +197,28 @@ namespace DxObject {
 		}*/
 
 		void Memcpy(const T* value) {
+			assert(IsWritable()); //!< 転送済みのstatic buffer
 			memcpy(dataArray_, value, sizeof(T) * indexSize_);
 		}
 
+		//! @brief [offset, offset + count) の範囲にコピー
+		//! 
+		//! @param[in] offset コピー先の先頭要素
+		//! @param[in] value  データ
+		//! @param[in] count  要素数
+		void Memcpy(uint32_t offset, const T* value, uint32_t count) {
+			assert(offset + count <= indexSize_); //!< 配列以上の範囲
+			assert(IsWritable());                 //!< 転送済みのstatic buffer
+			memcpy(dataArray_ + offset, value, sizeof(T) * count);
+		}
+
 		//=========================================================================================
 		// operator
 		//=========================================================================================
 
 		T& operator[](uint32_t index) {
 			CheckIndex(index);
+			assert(IsWritable()); //!< 転送済みのstatic buffer
 
 			return dataArray_[index];
 		}
@@ -266,22 +321,37 @@ namespace DxObject {
 		: public BufferIndex {
 	public:
 
+		//=========================================================================================
+		// public variables
+		//=========================================================================================
+
+		static const uint32_t kMaxIndex16VertexCount = 0x10000; //!< 16bit indexで参照できる頂点数
+
 		//=========================================================================================
 		// public methods
 		//=========================================================================================
 
-		//! @breif コンストラクタ
+		//! @breif コンストラクタ. vertexBufferの頂点数から16bit, 32bitを選択
 		//! 
 		//! @param[in] devices      DxObject::Devices
 		//! @param[in] vertexBuffer DxObject::BufferResource || DxObject::BufferPtrResorce の vertexBuffer
 		IndexBufferResource(DxObject::Devices* devices, const BufferIndex* vertexBuffer);
 
-		//! @breif コンストラクタ
+		//! @breif コンストラクタ. 常に32bit index
 		//! 
 		//! @param[in] devices   DxObject::Devices
 		//! @param[in] indexSize 配列サイズ
 		IndexBufferResource(DxObject::Devices* devices, uint32_t indexSize)
-			: BufferIndex(indexSize) { Init(devices); }
+			: BufferIndex(indexSize) { Init(devices, DXGI_FORMAT_R32_UINT); }
+
+		//! @breif コンストラクタ. 頂点数から16bit, 32bitを選択
+		//! 
+		//! @param[in] devices     DxObject::Devices
+		//! @param[in] indexSize   配列サイズ
+		//! @param[in] vertexCount 参照する頂点数. kMaxIndex16VertexCount以下なら16bit
+		//! @param[in] usage       bufferの使い方. 書き換えないmeshはBUFFER_USAGE_STATIC
+		IndexBufferResource(DxObject::Devices* devices, uint32_t indexSize, uint32_t vertexCount, BufferUsage usage = BUFFER_USAGE_DYNAMIC)
+			: BufferIndex(indexSize) { Init(devices, SelectFormat(vertexCount), usage); }
 
 		//! @brief デストラクタ
 		~IndexBufferResource() { Term(); }
@@ -289,7 +359,9 @@ namespace DxObject {
 		//! @brief 初期化処理
 		//! 
 		//! @param[in] devices DxObject::Devices
-		void Init(DxObject::Devices* devices);
+		//! @param[in] format  DXGI_FORMAT_R16_UINT || DXGI_FORMAT_R32_UINT
+		//! @param[in] usage   bufferの使い方
+		void Init(DxObject::Devices* devices, DXGI_FORMAT format, BufferUsage usage = BUFFER_USAGE_DYNAMIC);
 
 		//! @brief 終了処理
 		void Term();
@@ -300,47 +372,84 @@ namespace DxObject {
 		const D3D12_INDEX_BUFFER_VIEW GetIndexBufferView() const {
 			D3D12_INDEX_BUFFER_VIEW result = {};
 			result.BufferLocation = resource_->GetGPUVirtualAddress();
-			result.SizeInBytes    = sizeof(uint32_t) * indexSize_;
-			result.Format         = DXGI_FORMAT_R32_UINT;
+			result.SizeInBytes    = GetStride() * indexSize_;
+			result.Format         = format_;
 
 			return result;
 		}
 
+		//! @brief indexのformatを取得
+		DXGI_FORMAT GetFormat() const { return format_; }
+
+		//! @brief index一つあたりのbyteサイズ
+		uint32_t GetStride() const { return (format_ == DXGI_FORMAT_R16_UINT) ? sizeof(uint16_t) : sizeof(uint32_t); }
+
 		//! @brief dataArrayにvalueを設定
 		//! 
 		//! @param[in] index 要素数
-		//! @param[in] value データ
+		//! @param[in] value データ. 16bitの場合は0xFFFF以下
 		void Set(uint32_t index, uint32_t value) {
 			if (!CheckIndex(index)) {
 				return;
 			}
 
-			dataArray_[index] = value;
-		}
+			assert(IsWritable()); //!< 転送済みのstatic buffer
+
+			if (format_ == DXGI_FORMAT_R16_UINT) {
+				assert(value < kMaxIndex16VertexCount); //!< 16bitで表せない
+				dataArray16_[index] = static_cast<uint16_t>(value);
 
-		void Memcpy(const uint32_t* value) {
-			memcpy(dataArray_, value, sizeof(uint32_t) * indexSize_);
+			} else {
+				dataArray32_[index] = value;
+			}
 		}
 
-		//=========================================================================================
-		// operator
-		//=========================================================================================
+		//! @brief dataArrayのvalueを取得. BUFFER_USAGE_STATIC はUpload前のみ
+		uint32_t Get(uint32_t index) const {
+			if (!CheckIndex(index)) {
+				return 0;
+			}
 
-		uint32_t& operator[](uint32_t index) {
-			CheckIndex(index);
+			assert(IsWritable()); //!< 転送済みのstatic buffer
 
-			return dataArray_[index];
+			return (format_ == DXGI_FORMAT_R16_UINT) ? dataArray16_[index] : dataArray32_[index];
 		}
 
+		//! @brief indexSize分をコピー. 16bitの場合は変換しながらコピー
+		void Memcpy(const uint32_t* value);
+
+		//! @brief indexSize分をコピー. 32bitの場合は変換しながらコピー
+		void Memcpy(const uint16_t* value);
+
+		//! @brief [offset, offset + count) の範囲にコピー. 16bitの場合は変換しながらコピー
+		//! 
+		//! @param[in] offset コピー先の先頭要素
+		//! @param[in] value  データ
+		//! @param[in] count  要素数
+		void Memcpy(uint32_t offset, const uint32_t* value, uint32_t count);
+
 	private:
 
 		//=========================================================================================
 		// private variables
 		//=========================================================================================
 
-		uint32_t* dataArray_;
+		DXGI_FORMAT format_ = DXGI_FORMAT_R32_UINT;
+
+		union {
+			uint16_t* dataArray16_; //!< DXGI_FORMAT_R16_UINT
+			uint32_t* dataArray32_; //!< DXGI_FORMAT_R32_UINT
+		};
 
 		uint32_t kMaxTriangleCount_;
+
+		//=========================================================================================
+		// private methods
+		//=========================================================================================
+
+		static DXGI_FORMAT SelectFormat(uint32_t vertexCount) {
+			return (vertexCount <= kMaxIndex16VertexCount) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+		}
 	};
 
 }
@@ -350,19 +459,18 @@ namespace DxObject {
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 template<typename T>
-void DxObject::BufferResource<T>::Init(DxObject::Devices* devices) {
+void DxObject::BufferResource<T>::Init(DxObject::Devices* devices, BufferUsage usage) {
 
 	// deviceを取り出す
 	ID3D12Device* device = devices->GetDevice();
 
-	// 配列分のBufferResourceを生成
-	resource_ = DxObjectMethod::CreateBufferResource(
+	// 配列分のBufferResourceを生成し, マッピング
+	dataArray_ = static_cast<T*>(CreateResource(
 		device,
-		sizeof(T) * indexSize_
-	);
-
-	// resourceをマッピング
-	resource_->Map(0, nullptr, reinterpret_cast<void**>(&dataArray_));
+		sizeof(T) * indexSize_,
+		usage,
+		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER
+	));
 }
 
 template<typename T>
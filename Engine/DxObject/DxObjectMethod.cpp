@@ -133,6 +133,39 @@ ComPtr<ID3D12Resource> DxObjectMethod::CreateBufferResource(
 	return result;
 }
 
+ComPtr<ID3D12Resource> DxObjectMethod::CreateDefaultBufferResource(
+	ID3D12Device* device, size_t sizeInBytes) {
+
+	ComPtr<ID3D12Resource> result;
+
+	// GPUのみが読み書きするヒープの設定
+	D3D12_HEAP_PROPERTIES prop = {};
+	prop.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+	// リソースの設定
+	D3D12_RESOURCE_DESC desc = {};
+	desc.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+	desc.Width            = sizeInBytes;
+	desc.Height           = 1;
+	desc.DepthOrArraySize = 1;
+	desc.MipLevels        = 1;
+	desc.SampleDesc.Count = 1;
+	desc.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	auto hr = device->CreateCommittedResource(
+		&prop,
+		D3D12_HEAP_FLAG_NONE,
+		&desc,
+		D3D12_RESOURCE_STATE_COPY_DEST, //!< staging bufferからのコピー先
+		nullptr,
+		IID_PPV_ARGS(&result)
+	);
+
+	assert(SUCCEEDED(hr));
+
+	return result;
+}
+
 ComPtr<ID3D12Resource> DxObjectMethod::CreateDepthStencilTextureResource(
 	ID3D12Device* device, int32_t width, int32_t height) {
 
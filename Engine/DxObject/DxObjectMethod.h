@@ -71,6 +71,17 @@ namespace DxObjectMethod {
 		size_t sizeInBytes
 	);
 
+	//! @brief GPU専用(DEFAULT heap)のバッファResourceを生成. 初期状態はCOPY_DEST
+	//! 
+	//! @param[in] device      ID3D12Device
+	//! @param[in] sizeInBytes バイトサイズ
+	//! 
+	//! @return バッファ確保したResourceを返却
+	ComPtr<ID3D12Resource> CreateDefaultBufferResource(
+		ID3D12Device* device,
+		size_t sizeInBytes
+	);
+
 	//! @brief 深度バッファを作成
 	//! 
 	//! @param[in] device デバイス
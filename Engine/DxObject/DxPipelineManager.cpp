@@ -7,6 +7,24 @@
 #include <DxDevices.h>
 #include <DxCommand.h>
 
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief compactな頂点の復元用 (VertexQuantization). VSのb1にroot constantsで渡す
+	const D3D12_ROOT_PARAMETER kVertexQuantizationParam = [] {
+		D3D12_ROOT_PARAMETER result = {};
+		result.ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+		result.ShaderVisibility         = D3D12_SHADER_VISIBILITY_VERTEX;
+		result.Constants.ShaderRegister = 1;
+		result.Constants.Num32BitValues = 8;
+
+		return result;
+	}();
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // PipelineManager methods
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,7 +69,7 @@ void DxObject::PipelineManager::Init(
 	/// pipelineMenbersの初期化 ///
 	{
 		// rootSignatureDescsの初期化
-		DxObject::RootSignatureDescs desc(5, 1);
+		DxObject::RootSignatureDescs desc(6, 1);
 
 		// rangeの設定
 		D3D12_DESCRIPTOR_RANGE range[1] = {};
@@ -82,6 +100,8 @@ void DxObject::PipelineManager::Init(
 		desc.param[4].DescriptorTable.pDescriptorRanges   = range;
 		desc.param[4].DescriptorTable.NumDescriptorRanges = _countof(range);
 
+		desc.param[5] = kVertexQuantizationParam; //!< compactな頂点のみ使用
+
 		// samplerの設定
 		desc.sampler[0].Filter           = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
 		desc.sampler[0].AddressU         = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
@@ -100,12 +120,16 @@ void DxObject::PipelineManager::Init(
 			L"Object3d.VS.hlsl", L"Object3d.GS.hlsl", L"Object3dGS.PS.hlsl"
 		);
 
+		pipelineMenbers_[PipelineType::TEXTURE].compactShaderBlob = std::make_unique<DxObject::ShaderBlob>(
+			L"Object3dCompact.VS.hlsl", L"Object3d.GS.hlsl", L"Object3dGS.PS.hlsl"
+		);
+
 		pipelineMenbers_[PipelineType::TEXTURE].rootSignature = std::make_unique<DxObject::RootSignature>(devices_, desc);
 	}
 
 	{
 		// rootSignatureDescsの初期化
-		DxObject::RootSignatureDescs desc(4, 0);
+		DxObject::RootSignatureDescs desc(5, 0);
 
 		// parameterの設定
 		desc.param[0].ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
@@ -124,10 +148,16 @@ void DxObject::PipelineManager::Init(
 		desc.param[3].ShaderVisibility          = D3D12_SHADER_VISIBILITY_PIXEL;
 		desc.param[3].Descriptor.ShaderRegister = 2;
 
+		desc.param[4] = kVertexQuantizationParam; //!< compactな頂点のみ使用
+
 		pipelineMenbers_[PipelineType::POLYGON].shaderBlob = std::make_unique<DxObject::ShaderBlob>(
 			L"Object3d.VS.hlsl", L"Polygon3d.PS.hlsl"
 		);
 
+		pipelineMenbers_[PipelineType::POLYGON].compactShaderBlob = std::make_unique<DxObject::ShaderBlob>(
+			L"Object3dCompact.VS.hlsl", L"Polygon3d.PS.hlsl"
+		);
+
 		pipelineMenbers_[PipelineType::POLYGON].rootSignature = std::make_unique<DxObject::RootSignature>(devices_, desc);
 	}
 
@@ -231,26 +261,37 @@ void DxObject::PipelineManager::Term() {
 
 	/*pipelineState_.reset();*/
 
-	for (auto& it : pipelines_) {
-		it.pipeline.reset();
+	for (auto& pipelines : pipelines_) {
+		for (auto& it : pipelines) {
+			it.pipeline.reset();
+		}
 	}
 }
 
 void DxObject::PipelineManager::CreatePipeline() {
 
-	if ((pipelines_[pipelineType_].settingBlendMode_ != blendMode_) || (pipelines_[pipelineType_].pipeline == nullptr)) {
-		pipelines_[pipelineType_].pipeline = std::make_unique<PipelineState>(
+	PipelineData& pipeline = pipelines_[pipelineType_][vertexFormat_];
+
+	if ((pipeline.settingBlendMode_ != blendMode_) || (pipeline.pipeline == nullptr)) {
+		ShaderBlob* shaderBlob = (vertexFormat_ == VERTEX_FORMAT_DEFAULT)
+			? pipelineMenbers_[pipelineType_].shaderBlob.get()
+			: pipelineMenbers_[pipelineType_].compactShaderBlob.get();
+
+		assert(shaderBlob != nullptr); //!< このpipelineTypeはcompactな頂点に未対応
+
+		pipeline.pipeline = std::make_unique<PipelineState>(
 			devices_,
-			pipelineMenbers_[pipelineType_].shaderBlob.get(), pipelineMenbers_[pipelineType_].rootSignature.get(),
-			blendState_->operator[](blendMode_)
+			shaderBlob, pipelineMenbers_[pipelineType_].rootSignature.get(),
+			blendState_->operator[](blendMode_),
+			vertexFormat_
 		);
 
-		pipelines_[pipelineType_].settingBlendMode_ = blendMode_;
+		pipeline.settingBlendMode_ = blendMode_;
 	}
 }
 
 void DxObject::PipelineManager::SetPipeline() {
-	assert(pipelines_[pipelineType_].pipeline != nullptr);
+	assert(pipelines_[pipelineType_][vertexFormat_].pipeline != nullptr);
 
 	// commandListの取り出し
 	ID3D12GraphicsCommandList* commandList = command_->GetCommandList();
@@ -259,7 +300,7 @@ void DxObject::PipelineManager::SetPipeline() {
 	commandList->RSSetScissorRects(1, &scissorRect_);
 
 	commandList->SetGraphicsRootSignature(pipelineMenbers_[pipelineType_].rootSignature->GetRootSignature());
-	commandList->SetPipelineState(pipelines_[pipelineType_].pipeline->GetPipelineState());
+	commandList->SetPipelineState(pipelines_[pipelineType_][vertexFormat_].pipeline->GetPipelineState());
 
 	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
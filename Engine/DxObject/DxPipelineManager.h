@@ -87,6 +87,11 @@ namespace DxObject {
 			blendMode_ = mode;
 		}
 
+		//! @brief 頂点formatの設定. compactなformatはTEXTURE, POLYGONのみ対応
+		void SetVertexFormat(VertexFormat format) {
+			vertexFormat_ = format;
+		}
+
 		//! @brief pipelineを生成
 		void CreatePipeline();
 
@@ -100,11 +105,13 @@ namespace DxObject {
 		////////////////////////////////////////////////////////////////////////////////////////////
 		struct PipelineMenber {
 			std::unique_ptr<ShaderBlob>    shaderBlob;
+			std::unique_ptr<ShaderBlob>    compactShaderBlob; //!< VERTEX_FORMAT_PACKED, QUANTIZED用. nullptrの場合は未対応
 			std::unique_ptr<RootSignature> rootSignature;
 
 			//! @brief Reset処理
 			void Reset() {
 				shaderBlob.reset();
+				compactShaderBlob.reset();
 				rootSignature.reset();
 			}
 		};
@@ -133,9 +140,12 @@ namespace DxObject {
 		std::array<PipelineMenber, PipelineType::kCountOfPipeline> pipelineMenbers_;
 		PipelineType                                               pipelineType_ = PipelineType::TEXTURE;
 
+		// vertexFormat
+		VertexFormat vertexFormat_ = VERTEX_FORMAT_DEFAULT;
+
 		// pipelines
-		std::array<PipelineData, PipelineType::kCountOfPipeline> pipelines_;
-		//!< array[PipelineType]
+		std::array<std::array<PipelineData, kVertexFormatCount>, PipelineType::kCountOfPipeline> pipelines_;
+		//!< array[PipelineType][VertexFormat]
 
 		// viewports
 		D3D12_VIEWPORT viewport_;
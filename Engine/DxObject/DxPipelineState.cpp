@@ -16,34 +16,50 @@
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 DxObject::PipelineState::PipelineState(
-	Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc) {
+	Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc,
+	VertexFormat vertexFormat) {
 
-	Init(devices, shaderBlob, rootSignature, blendDesc);
+	Init(devices, shaderBlob, rootSignature, blendDesc, vertexFormat);
 }
 
 DxObject::PipelineState::~PipelineState() { Term(); }
 
 void DxObject::PipelineState::Init(
-	Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc) {
+	Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc,
+	VertexFormat vertexFormat) {
 
 	// deviceの取り出し
 	ID3D12Device* device = devices->GetDevice();
 
 	// inputLayoutの設定 TODO: inputLayout class
+	assert(vertexFormat < kVertexFormatCount);
+
+	static const DXGI_FORMAT kPositionFormats[kVertexFormatCount] = {
+		DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R16G16B16A16_UNORM
+	};
+
+	static const DXGI_FORMAT kTexcoordFormats[kVertexFormatCount] = {
+		DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R16G16_FLOAT, DXGI_FORMAT_R16G16_FLOAT
+	};
+
+	static const DXGI_FORMAT kNormalFormats[kVertexFormatCount] = { //!< compactなformatはoctahedral
+		DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R16G16_SNORM, DXGI_FORMAT_R16G16_SNORM
+	};
+
 	D3D12_INPUT_ELEMENT_DESC descIE[3] = {};
 	descIE[0].SemanticName      = "POSITION";
 	descIE[0].SemanticIndex     = 0;
-	descIE[0].Format            = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	descIE[0].Format            = kPositionFormats[vertexFormat];
 	descIE[0].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 
 	descIE[1].SemanticName      = "TEXCOORD";
 	descIE[1].SemanticIndex     = 0;
-	descIE[1].Format            = DXGI_FORMAT_R32G32_FLOAT;
+	descIE[1].Format            = kTexcoordFormats[vertexFormat];
 	descIE[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 
 	descIE[2].SemanticName      = "NORMAL";
 	descIE[2].SemanticIndex     = 0;
-	descIE[2].Format            = DXGI_FORMAT_R32G32B32_FLOAT;
+	descIE[2].Format            = kNormalFormats[vertexFormat];
 	descIE[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 
 	D3D12_INPUT_LAYOUT_DESC descIL = {};
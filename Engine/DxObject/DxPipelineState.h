@@ -20,6 +20,17 @@
 #pragma comment(lib, "d3d12.lib")
 #pragma comment(lib, "dxgi.lib")
 
+////////////////////////////////////////////////////////////////////////////////////////////
+// VertexFormat enum
+////////////////////////////////////////////////////////////////////////////////////////////
+enum VertexFormat {
+	VERTEX_FORMAT_DEFAULT,   //!< VertexData. float4 position, float2 texcoord, float3 normal (36byte)
+	VERTEX_FORMAT_PACKED,    //!< VertexDataPacked. float3 position, half2 texcoord, octahedral normal (20byte)
+	VERTEX_FORMAT_QUANTIZED, //!< VertexDataQuantized. unorm16 position, half2 texcoord, octahedral normal (16byte)
+
+	kVertexFormatCount
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // DxObject namespace
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -49,8 +60,10 @@ namespace DxObject {
 		//! @param[in] shaderBlob   DxObject::Shader
 		//! @param[in] clientWidth  クライアント領域横幅
 		//! @param[in] clientHeight クライアント領域縦幅
+		//! @param[in] vertexFormat 頂点のformat. inputLayoutが変わる
 		PipelineState(
-			Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc
+			Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc,
+			VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT
 		);
 
 		//! @brief デストラクタ
@@ -60,8 +73,10 @@ namespace DxObject {
 		//! 
 		//! @param[in] devices      DxObject::Device
 		//! @param[in] shaderBlob   DxObject::Shader
+		//! @param[in] vertexFormat 頂点のformat. inputLayoutが変わる
 		void Init(
-			Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc
+			Devices* devices, ShaderBlob* shaderBlob, RootSignature* rootSignature, const D3D12_BLEND_DESC& blendDesc,
+			VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT
 		);
 
 		//! @brief 終了処理
@@ -0,0 +1,25 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// directX
+#include <d3d12.h>
+
+// DxObject
+#include <DxBasicStagingQueue.h>
+
+// ComPtr
+#include <ComPtr.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// DxObject namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace DxObject {
+
+	//-----------------------------------------------------------------------------------------
+	// using
+	//-----------------------------------------------------------------------------------------
+	using StagingQueue = BasicStagingQueue<ComPtr<ID3D12Resource>>;
+
+}
\ No newline at end of file
@@ -0,0 +1,720 @@
+#include "GltfLoader.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <cstring>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+
+// engine
+#include <MappedFile.h>
+
+// lib
+#include <Json.h>
+#include <Matrix4x4.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//-----------------------------------------------------------------------------------------
+	// glb format
+	//-----------------------------------------------------------------------------------------
+	constexpr uint32_t kGlbMagic        = 0x46546C67; //!< "glTF"
+	constexpr uint32_t kGlbVersion      = 2;
+	constexpr uint32_t kChunkJson       = 0x4E4F534A; //!< "JSON"
+	constexpr uint32_t kChunkBin        = 0x004E4942; //!< "BIN\0"
+	constexpr size_t   kHeaderSize      = 12;         //!< magic, version, length
+	constexpr size_t   kChunkHeaderSize = 8;          //!< length, type
+
+	//-----------------------------------------------------------------------------------------
+	// accessor componentType
+	//-----------------------------------------------------------------------------------------
+	constexpr uint32_t kComponentUnsignedByte  = 5121;
+	constexpr uint32_t kComponentUnsignedShort = 5123;
+	constexpr uint32_t kComponentUnsignedInt   = 5125;
+	constexpr uint32_t kComponentFloat         = 5126;
+
+	constexpr uint32_t kModeTriangles = 4;
+
+	//! @brief 読み込み失敗の結果を作成
+	ModelRawData MakeFailed(const std::string& error) {
+		ModelRawData result;
+		result.error = error;
+		return result;
+	}
+
+	//! @brief jsonの配列にindexの要素があるか
+	bool Contains(const Json& json, const char* key, size_t index) {
+		return json.contains(key) && json[key].is_array() && index < json[key].size();
+	}
+
+	//! @brief jsonが要素数sizeの配列か
+	bool IsArray(const Json& json, const char* key, size_t size) {
+		return json.contains(key) && json[key].is_array() && json[key].size() == size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Accessor structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Accessor { //!< binary chunk内の要素の並び. マッピング中のメモリを直接指す
+		const char* data;
+		uint32_t    count;
+		uint32_t    stride;         //!< 要素間のbyte数
+		uint32_t    componentType;
+		uint32_t    componentCount; //!< SCALAR: 1, VEC2: 2, VEC3: 3, VEC4: 4
+	};
+
+	uint32_t GetComponentSize(uint32_t componentType) {
+		switch (componentType) {
+			case kComponentUnsignedByte:
+				return 1;
+
+			case kComponentUnsignedShort:
+				return 2;
+
+			case kComponentUnsignedInt:
+			case kComponentFloat:
+				return 4;
+
+			default: //!< 未対応のcomponentType
+				return 0;
+		}
+	}
+
+	uint32_t GetComponentCount(const std::string& type) {
+		if (type == "SCALAR") { return 1; }
+		if (type == "VEC2")   { return 2; }
+		if (type == "VEC3")   { return 3; }
+		if (type == "VEC4")   { return 4; }
+
+		return 0; //!< 未対応のtype
+	}
+
+	//! @brief accessorの範囲をbinary chunk内に解決
+	//!
+	//! @param[in]  json   glTFのjson
+	//! @param[in]  index  accessor番号
+	//! @param[in]  bin    binary chunkの先頭
+	//! @param[in]  size   binary chunkのbyte数
+	//! @param[out] result binary chunk内の範囲
+	//!
+	//! @retval true  解決できた
+	//! @retval false 未対応のaccessor, またはbinary chunkに収まらない
+	bool GetAccessor(const Json& json, size_t index, const char* bin, size_t size, Accessor& result) {
+		if (!Contains(json, "accessors", index)) {
+			return false;
+		}
+
+		const Json& accessor = json["accessors"][index];
+
+		if (!accessor.contains("bufferView") || accessor.contains("sparse")) { //!< bufferViewのないaccessor(全て0), sparse accessorは未対応
+			return false;
+		}
+
+		size_t bufferViewIndex = accessor["bufferView"].get<size_t>();
+
+		if (!Contains(json, "bufferViews", bufferViewIndex)) {
+			return false;
+		}
+
+		const Json& bufferView = json["bufferViews"][bufferViewIndex];
+
+		if (bufferView.value("buffer", 0) != 0) { //!< glbのBIN chunk以外のbufferは未対応
+			return false;
+		}
+
+		if (!accessor.contains("count") || !accessor.contains("componentType") || !accessor.contains("type")) { //!< 必須のpropertyがない
+			return false;
+		}
+
+		result = {};
+		result.count          = accessor["count"].get<uint32_t>();
+		result.componentType  = accessor["componentType"].get<uint32_t>();
+		result.componentCount = GetComponentCount(accessor["type"].get<std::string>());
+
+		uint32_t elementSize = GetComponentSize(result.componentType) * result.componentCount;
+
+		if (elementSize == 0) { //!< 未対応のcomponentType, type
+			return false;
+		}
+
+		result.stride = bufferView.value("byteStride", elementSize);
+
+		size_t offset = bufferView.value("byteOffset", static_cast<size_t>(0)) + accessor.value("byteOffset", static_cast<size_t>(0));
+		result.data = bin + offset;
+
+		// 最後の要素までbinary chunkに収まっているか
+		return result.count == 0 || offset + static_cast<size_t>(result.stride) * (result.count - 1) + elementSize <= size;
+	}
+
+	//! @brief float3の読み込み. 揃っていないアドレスもあるのでmemcpy
+	Vector3f ReadVector3(const Accessor& accessor, uint32_t index) {
+		Vector3f result;
+		std::memcpy(&result, accessor.data + static_cast<size_t>(accessor.stride) * index, sizeof(Vector3f));
+		return result;
+	}
+
+	//! @brief texcoordの読み込み. float, normalizedのunsigned byte/shortに対応
+	Vector2f ReadTexcoord(const Accessor& accessor, uint32_t index) {
+		const char* ptr = accessor.data + static_cast<size_t>(accessor.stride) * index;
+
+		Vector2f result = {};
+
+		switch (accessor.componentType) {
+			case kComponentFloat:
+				std::memcpy(&result, ptr, sizeof(Vector2f));
+				break;
+
+			case kComponentUnsignedByte:
+				result.x = static_cast<uint8_t>(ptr[0]) / 255.0f;
+				result.y = static_cast<uint8_t>(ptr[1]) / 255.0f;
+				break;
+
+			case kComponentUnsignedShort: {
+				uint16_t value[2];
+				std::memcpy(value, ptr, sizeof(value));
+				result.x = value[0] / 65535.0f;
+				result.y = value[1] / 65535.0f;
+				break;
+			}
+
+			default:
+				assert(false); //!< AppendPrimitiveで確認済み
+				break;
+		}
+
+		return result;
+	}
+
+	//! @brief indexの読み込み. uint32_tで詰まっている場合はそのままコピー
+	void ReadIndices(const Accessor& accessor, std::vector<uint32_t>& indices) {
+		indices.resize(accessor.count);
+
+		if (accessor.componentType == kComponentUnsignedInt && accessor.stride == sizeof(uint32_t)) {
+			std::memcpy(indices.data(), accessor.data, sizeof(uint32_t) * accessor.count);
+			return;
+		}
+
+		for (uint32_t i = 0; i < accessor.count; ++i) {
+			const char* ptr = accessor.data + static_cast<size_t>(accessor.stride) * i;
+
+			switch (accessor.componentType) {
+				case kComponentUnsignedByte:
+					indices[i] = static_cast<uint8_t>(*ptr);
+					break;
+
+				case kComponentUnsignedShort: {
+					uint16_t value;
+					std::memcpy(&value, ptr, sizeof(value));
+					indices[i] = value;
+					break;
+				}
+
+				case kComponentUnsignedInt:
+					std::memcpy(&indices[i], ptr, sizeof(uint32_t));
+					break;
+
+				default:
+					assert(false); //!< AppendPrimitiveで確認済み
+					break;
+			}
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// transform
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief nodeのlocal行列を取得. glTFの列優先の配列は, そのまま行ベクトル用の行列になる
+	//!
+	//! @param[in]  node   node
+	//! @param[out] result local行列
+	//!
+	//! @retval true  取得できた
+	//! @retval false matrix, scale, rotation, translationの要素数が違う
+	bool GetLocalMatrix(const Json& node, Matrix4x4& result) {
+		if (node.contains("matrix")) {
+			if (!IsArray(node, "matrix", 16)) {
+				return false;
+			}
+
+			for (int i = 0; i < 16; ++i) {
+				result.m[i / 4][i % 4] = node["matrix"][i].get<float>();
+			}
+
+			return true;
+		}
+
+		if ((node.contains("scale") && !IsArray(node, "scale", 3))
+			|| (node.contains("rotation") && !IsArray(node, "rotation", 4))
+			|| (node.contains("translation") && !IsArray(node, "translation", 3))) {
+			return false;
+		}
+
+		result = Matrix4x4::MakeIdentity();
+
+		if (node.contains("scale")) {
+			const Json& scale = node["scale"];
+			result *= Matrix::MakeScale({ scale[0].get<float>(), scale[1].get<float>(), scale[2].get<float>() });
+		}
+
+		if (node.contains("rotation")) { //!< quaternion (x, y, z, w)
+			const Json& rotation = node["rotation"];
+			float x = rotation[0].get<float>();
+			float y = rotation[1].get<float>();
+			float z = rotation[2].get<float>();
+			float w = rotation[3].get<float>();
+
+			Matrix4x4 rotate = Matrix4x4::MakeIdentity();
+			rotate.m[0][0] = 1.0f - 2.0f * (y * y + z * z);
+			rotate.m[0][1] = 2.0f * (x * y + z * w);
+			rotate.m[0][2] = 2.0f * (x * z - y * w);
+			rotate.m[1][0] = 2.0f * (x * y - z * w);
+			rotate.m[1][1] = 1.0f - 2.0f * (x * x + z * z);
+			rotate.m[1][2] = 2.0f * (y * z + x * w);
+			rotate.m[2][0] = 2.0f * (x * z + y * w);
+			rotate.m[2][1] = 2.0f * (y * z - x * w);
+			rotate.m[2][2] = 1.0f - 2.0f * (x * x + y * y);
+
+			result *= rotate;
+		}
+
+		if (node.contains("translation")) {
+			const Json& translation = node["translation"];
+			result *= Matrix::MakeTranslate({ translation[0].get<float>(), translation[1].get<float>(), translation[2].get<float>() });
+		}
+
+		return true;
+	}
+
+	bool IsIdentity(const Matrix4x4& matrix) {
+		Matrix4x4 identity = Matrix4x4::MakeIdentity();
+		return std::memcmp(&matrix, &identity, sizeof(Matrix4x4)) == 0;
+	}
+
+	//! @brief 行列の左上3x3の行列式. 負の場合は鏡像になる
+	float GetDeterminant3x3(const Matrix4x4& m) {
+		return m.m[0][0] * (m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1])
+			- m.m[0][1] * (m.m[1][0] * m.m[2][2] - m.m[1][2] * m.m[2][0])
+			+ m.m[0][2] * (m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0]);
+	}
+
+	//! @brief 方向ベクトルを左上3x3で変換
+	Vector3f TransformNormal(const Vector3f& v, const Matrix4x4& m) {
+		return {
+			v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+			v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+			v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2],
+		};
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// material
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief textureInfoから外部ファイルのパスを取得
+	//!
+	//! @param[in]  json          glTFのjson
+	//! @param[in]  textureInfo   textureInfo
+	//! @param[in]  directoryPath ディレクトリパス
+	//! @param[out] result        ファイルパス. 埋め込みimage, data uriの場合は空
+	//!
+	//! @retval true  取得できた
+	//! @retval false texture, imageが範囲外
+	bool GetTextureFilePath(const Json& json, const Json& textureInfo, const std::string& directoryPath, std::string& result) {
+		result.clear();
+
+		if (!textureInfo.contains("index") || !Contains(json, "textures", textureInfo["index"].get<size_t>())) {
+			return false;
+		}
+
+		const Json& texture = json["textures"][textureInfo["index"].get<size_t>()];
+
+		if (!texture.contains("source")) {
+			return true;
+		}
+
+		if (!Contains(json, "images", texture["source"].get<size_t>())) {
+			return false;
+		}
+
+		const Json& image = json["images"][texture["source"].get<size_t>()];
+
+		if (!image.contains("uri")) { //!< bufferViewに埋め込まれたimage
+			return true;
+		}
+
+		std::string uri = image["uri"].get<std::string>();
+
+		if (!uri.starts_with("data:")) {
+			result = directoryPath + "/" + uri;
+		}
+
+		return true;
+	}
+
+	//! @brief materialの読み込み
+	//!
+	//! @retval true  読み込めた
+	//! @retval false texture, imageが範囲外, またはbaseColorFactorの要素数が違う
+	bool LoadMaterial(const Json& json, const Json& material, const std::string& directoryPath, MaterialData& result) {
+		result = {};
+
+		if (material.contains("pbrMetallicRoughness")) {
+			const Json& pbr = material["pbrMetallicRoughness"];
+
+			if (pbr.contains("baseColorFactor")) {
+				if (!IsArray(pbr, "baseColorFactor", 4)) {
+					return false;
+				}
+
+				const Json& factor = pbr["baseColorFactor"];
+				result.color = { factor[0].get<float>(), factor[1].get<float>(), factor[2].get<float>(), factor[3].get<float>() };
+			}
+
+			if (pbr.contains("baseColorTexture")) {
+				if (!GetTextureFilePath(json, pbr["baseColorTexture"], directoryPath, result.textureFilePath)) {
+					return false;
+				}
+
+				result.isUseTexture = !result.textureFilePath.empty();
+			}
+		}
+
+		if (material.contains("normalTexture")) {
+			if (!GetTextureFilePath(json, material["normalTexture"], directoryPath, result.normalFilePath)) {
+				return false;
+			}
+
+			result.isUseNormalMap = !result.normalFilePath.empty();
+		}
+
+		return true;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// mesh
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief primitive一つをmeshとして追加
+	//!
+	//! @param[in]     json      glTFのjson
+	//! @param[in]     primitive primitive
+	//! @param[in]     world     nodeのworld行列
+	//! @param[in]     bin       binary chunkの先頭
+	//! @param[in]     size      binary chunkのbyte数
+	//! @param[in]     materials 読み込み済みのmaterial
+	//! @param[in,out] result    meshの追加先. 失敗した場合はerrorを設定
+	//!
+	//! @retval true  追加した, または三角形リスト以外なので読み飛ばした
+	//! @retval false 未対応のprimitive
+	bool AppendPrimitive(const Json& json, const Json& primitive, const Matrix4x4& world, const char* bin, size_t size, const std::vector<MaterialData>& materials, ModelRawData& result) {
+		if (primitive.value("mode", kModeTriangles) != kModeTriangles) { //!< 三角形リスト以外は描画できないので読み飛ばす
+			return true;
+		}
+
+		if (!primitive.contains("attributes")) { //!< 必須のproperty
+			result.error = "missing primitive attributes";
+			return false;
+		}
+
+		const Json& attributes = primitive["attributes"];
+
+		Accessor position;
+		if (!attributes.contains("POSITION") //!< 位置のないprimitive
+			|| !GetAccessor(json, attributes["POSITION"].get<size_t>(), bin, size, position)
+			|| position.componentType != kComponentFloat || position.componentCount != 3) {
+			result.error = "unsupported POSITION accessor";
+			return false;
+		}
+
+		MeshRawData mesh;
+		mesh.vertices.resize(position.count);
+
+		bool isIdentity = IsIdentity(world);
+
+		// 位置
+		for (uint32_t i = 0; i < position.count; ++i) {
+			Vector3f value = ReadVector3(position, i);
+
+			if (!isIdentity) {
+				value = Matrix::Transform(value, world);
+			}
+
+			// 左手座標に変換
+			mesh.vertices[i].position = { value.x, value.y, -value.z, 1.0f };
+		}
+
+		// 法線. 非一様scaleに対応するため逆転置行列で変換
+		if (attributes.contains("NORMAL")) {
+			Accessor normal;
+			if (!GetAccessor(json, attributes["NORMAL"].get<size_t>(), bin, size, normal)
+				|| normal.componentType != kComponentFloat || normal.componentCount != 3 || normal.count != position.count) {
+				result.error = "unsupported NORMAL accessor";
+				return false;
+			}
+
+			Matrix4x4 normalMatrix = isIdentity ? world : Matrix::Transpose(Matrix::Inverse(world));
+
+			for (uint32_t i = 0; i < normal.count; ++i) {
+				Vector3f value = ReadVector3(normal, i);
+
+				if (!isIdentity) {
+					value = Vector::Normalize(TransformNormal(value, normalMatrix));
+				}
+
+				// 左手座標に変換
+				mesh.vertices[i].normal = { value.x, value.y, -value.z };
+			}
+		}
+
+		// texcoord. glTFは左上原点なのでそのまま
+		if (attributes.contains("TEXCOORD_0")) {
+			Accessor texcoord;
+			if (!GetAccessor(json, attributes["TEXCOORD_0"].get<size_t>(), bin, size, texcoord)
+				|| texcoord.componentType == kComponentUnsignedInt || texcoord.componentCount != 2 || texcoord.count != position.count) {
+				result.error = "unsupported TEXCOORD_0 accessor";
+				return false;
+			}
+
+			for (uint32_t i = 0; i < texcoord.count; ++i) {
+				mesh.vertices[i].texcoord = ReadTexcoord(texcoord, i);
+			}
+		}
+
+		// index. 省略された場合は頂点順
+		if (primitive.contains("indices")) {
+			Accessor indices;
+			if (!GetAccessor(json, primitive["indices"].get<size_t>(), bin, size, indices)
+				|| indices.componentType == kComponentFloat || indices.componentCount != 1) {
+				result.error = "unsupported indices accessor";
+				return false;
+			}
+
+			ReadIndices(indices, mesh.indices);
+
+		} else {
+			mesh.indices.resize(position.count);
+
+			for (uint32_t i = 0; i < position.count; ++i) {
+				mesh.indices[i] = i;
+			}
+		}
+
+		mesh.indices.resize(mesh.indices.size() / 3 * 3);
+
+		if (!std::all_of(mesh.indices.begin(), mesh.indices.end(), [&](uint32_t index) { return index < position.count; })) {
+			result.error = "index out of range";
+			return false;
+		}
+
+		// z反転で三角形の向きが変わるので逆順にする. 鏡像のnodeは向きが戻るのでそのまま
+		if (GetDeterminant3x3(world) >= 0.0f) {
+			for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+				std::swap(mesh.indices[i], mesh.indices[i + 2]);
+			}
+		}
+
+		MaterialData material = {};
+		if (primitive.contains("material")) {
+			size_t index = primitive["material"].get<size_t>();
+
+			if (index >= materials.size()) {
+				result.error = "material out of range";
+				return false;
+			}
+
+			material = materials[index];
+		}
+
+		result.meshs.push_back(std::move(mesh));
+		result.materials.push_back(std::move(material));
+
+		return true;
+	}
+
+	//! @brief sceneのnodeを辿ってmeshを追加
+	//!
+	//! @param[in] json          glTFのjson
+	//! @param[in] bin           binary chunkの先頭
+	//! @param[in] binSize       binary chunkのbyte数
+	//! @param[in] directoryPath ディレクトリパス
+	//!
+	//! @return CPU側のmodelDataを返却. 範囲外の参照, 循環したnodeの場合はerrorを設定
+	ModelRawData ParseJson(const Json& json, const char* bin, size_t binSize, const std::string& directoryPath) {
+		ModelRawData result;
+
+		// material
+		std::vector<MaterialData> materials;
+
+		if (json.contains("materials")) {
+			for (const auto& material : json["materials"]) {
+				if (!LoadMaterial(json, material, directoryPath, materials.emplace_back())) {
+					return MakeFailed("invalid material");
+				}
+			}
+		}
+
+		// sceneのnodeを辿ってmeshを追加
+		std::vector<std::pair<size_t, Matrix4x4>> nodes; //!< node番号, 親のworld行列
+
+		if (json.contains("scenes")) {
+			size_t sceneIndex = json.value("scene", static_cast<size_t>(0));
+
+			if (!Contains(json, "scenes", sceneIndex)) {
+				return MakeFailed("scene out of range");
+			}
+
+			const Json& scene = json["scenes"][sceneIndex];
+
+			if (scene.contains("nodes")) {
+				for (const auto& node : scene["nodes"]) {
+					nodes.emplace_back(node.get<size_t>(), Matrix4x4::MakeIdentity());
+				}
+			}
+
+		} else if (json.contains("meshes")) { //!< sceneがない場合は全meshをそのまま
+			for (const auto& mesh : json["meshes"]) {
+				if (!mesh.contains("primitives")) {
+					return MakeFailed("missing mesh primitives");
+				}
+
+				for (const auto& primitive : mesh["primitives"]) {
+					if (!AppendPrimitive(json, primitive, Matrix4x4::MakeIdentity(), bin, binSize, materials, result)) {
+						return MakeFailed(result.error);
+					}
+				}
+			}
+		}
+
+		// nodeの階層は木なので, 二度目に辿ったnodeは循環, または複数の親を持つ
+		std::vector<bool> isVisited(json.contains("nodes") ? json["nodes"].size() : 0, false);
+
+		// ファイル順を保つため, 先頭から処理して子を直後に挿入する
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			if (!Contains(json, "nodes", nodes[i].first)) {
+				return MakeFailed("node out of range");
+			}
+
+			if (isVisited[nodes[i].first]) {
+				return MakeFailed("node hierarchy is not a tree");
+			}
+
+			isVisited[nodes[i].first] = true;
+
+			const Json& node = json["nodes"][nodes[i].first];
+
+			Matrix4x4 local;
+			if (!GetLocalMatrix(node, local)) {
+				return MakeFailed("invalid node transform");
+			}
+
+			Matrix4x4 world = local * nodes[i].second;
+
+			if (node.contains("mesh")) {
+				size_t meshIndex = node["mesh"].get<size_t>();
+
+				if (!Contains(json, "meshes", meshIndex)) {
+					return MakeFailed("mesh out of range");
+				}
+
+				if (!json["meshes"][meshIndex].contains("primitives")) {
+					return MakeFailed("missing mesh primitives");
+				}
+
+				for (const auto& primitive : json["meshes"][meshIndex]["primitives"]) {
+					if (!AppendPrimitive(json, primitive, world, bin, binSize, materials, result)) {
+						return MakeFailed(result.error);
+					}
+				}
+			}
+
+			if (node.contains("children")) {
+				size_t insert = i + 1;
+
+				for (const auto& child : node["children"]) {
+					nodes.emplace(nodes.begin() + insert, child.get<size_t>(), world);
+					++insert;
+				}
+			}
+		}
+
+		return result;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// GltfLoader methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+ModelRawData GltfLoader::ParseGlb(const std::string& directoryPath, const std::string& filename) {
+	// glbファイルをマッピング
+	MappedFile file(directoryPath + "/" + filename);
+	if (!file.IsOpen()) { //!< fileが見つからなかった.
+		return MakeFailed("file not found: " + directoryPath + "/" + filename);
+	}
+
+	const char* data = file.GetData();
+	size_t      size = file.GetSize();
+
+	if (size < kHeaderSize + kChunkHeaderSize) { //!< headerが足りない
+		return MakeFailed("truncated glb header");
+	}
+
+	uint32_t header[3];
+	std::memcpy(header, data, sizeof(header));
+
+	if (header[0] != kGlbMagic || header[1] != kGlbVersion) { //!< glbファイルではない, または未対応のversion
+		return MakeFailed("not a glb 2.0 file");
+	}
+	size = (std::min)(size, static_cast<size_t>(header[2]));
+
+	// chunkの読み込み. 最初はJSON, 次にBIN
+	const char* jsonData = nullptr;
+	size_t      jsonSize = 0;
+	const char* bin      = nullptr;
+	size_t      binSize  = 0;
+
+	for (size_t offset = kHeaderSize; offset + kChunkHeaderSize <= size;) {
+		uint32_t chunkHeader[2]; // length, type
+		std::memcpy(chunkHeader, data + offset, sizeof(chunkHeader));
+
+		const char* chunkData = data + offset + kChunkHeaderSize;
+		size_t      chunkSize = (std::min)(static_cast<size_t>(chunkHeader[0]), size - offset - kChunkHeaderSize);
+
+		if (chunkHeader[1] == kChunkJson && jsonData == nullptr) {
+			jsonData = chunkData;
+			jsonSize = chunkSize;
+
+		} else if (chunkHeader[1] == kChunkBin && bin == nullptr) {
+			bin     = chunkData;
+			binSize = chunkSize;
+		}
+
+		offset += kChunkHeaderSize + chunkSize;
+	}
+
+	if (jsonData == nullptr) { //!< JSON chunkがない
+		return MakeFailed("missing JSON chunk");
+	}
+
+	Json json = Json::parse(jsonData, jsonData + jsonSize, nullptr, false);
+
+	if (json.is_discarded()) {
+		return MakeFailed("invalid JSON chunk");
+	}
+
+	try {
+		return ParseJson(json, bin, binSize, directoryPath);
+
+	} catch (const Json::exception& exception) { //!< 型の異なるjsonの値
+		return MakeFailed(exception.what());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <cstdint>
+
+// structure
+#include <ModelRawData.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// GltfLoader namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace GltfLoader {
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief binary glTF (.glb) をマッピングし, accessorをbinary chunkから直接読み込む
+	//!
+	//! primitive一つを一つのmeshとし, nodeのtransformは頂点に焼き込む.
+	//! 右手座標系から左手座標系への変換はobjファイルと同じ (z反転, 三角形の逆順).
+	//! 外部ファイルを参照するimageのみtextureとして扱う
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      glbファイル名
+	//!
+	//! @return CPU側のmodelDataを返却. 未対応のformat, 範囲外の参照, 必須propertyの欠落, 型の異なる値, 循環したnodeの場合はerrorを設定
+	ModelRawData ParseGlb(const std::string& directoryPath, const std::string& filename);
+
+}
\ No newline at end of file
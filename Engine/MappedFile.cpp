@@ -0,0 +1,142 @@
+#include "MappedFile.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+#ifdef _WIN32
+#include <Logger.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MappedFile methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	std::wstring filePathW = ToWstring(filePath); //!< wstringに変換
+
+	file_ = CreateFileW(
+		filePathW.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr
+	);
+
+	if (file_ == INVALID_HANDLE_VALUE) { //!< ファイルが見つからなかった
+		return false;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	GetFileSizeEx(file_, &fileSize);
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+
+	if (size_ == 0) { //!< 空ファイルはマッピングできないので data_ = nullptr のまま
+		return true;
+	}
+
+	mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mapping_ == nullptr) {
+		Close();
+		return false;
+	}
+
+	data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+
+	if (data_ == nullptr) {
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_ != nullptr) {
+		UnmapViewOfFile(data_);
+		data_ = nullptr;
+	}
+
+	if (mapping_ != nullptr) {
+		CloseHandle(mapping_);
+		mapping_ = nullptr;
+	}
+
+	if (file_ != INVALID_HANDLE_VALUE) {
+		CloseHandle(file_);
+		file_ = INVALID_HANDLE_VALUE;
+	}
+
+	size_ = 0;
+}
+
+bool MappedFile::IsOpen() const {
+	return file_ != INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	file_ = ::open(filePath.c_str(), O_RDONLY);
+
+	if (file_ < 0) { //!< ファイルが見つからなかった
+		return false;
+	}
+
+	struct stat status = {};
+
+	if (::fstat(file_, &status) != 0) {
+		Close();
+		return false;
+	}
+
+	size_ = static_cast<size_t>(status.st_size);
+
+	if (size_ == 0) { //!< 空ファイルはマッピングできないので data_ = nullptr のまま
+		return true;
+	}
+
+	void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0);
+
+	if (data == MAP_FAILED) {
+		Close();
+		return false;
+	}
+
+	data_ = static_cast<const char*>(data);
+
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_ != nullptr) {
+		::munmap(const_cast<char*>(data_), size_);
+		data_ = nullptr;
+	}
+
+	if (file_ >= 0) {
+		::close(file_);
+		file_ = -1;
+	}
+
+	size_ = 0;
+}
+
+bool MappedFile::IsOpen() const {
+	return file_ >= 0;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// windows
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// c++
+#include <string>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MappedFile class
+////////////////////////////////////////////////////////////////////////////////////////////
+class MappedFile { //!< 読み取り専用のファイルマッピング
+public:
+
+	//=========================================================================================
+	// public methods
+	//=========================================================================================
+
+	//! @brief コンストラクタ
+	MappedFile() = default;
+
+	//! @brief コンストラクタ
+	//!
+	//! @param[in] filePath ファイルパス
+	MappedFile(const std::string& filePath) { Open(filePath); }
+
+	//! @brief デストラクタ
+	~MappedFile() { Close(); }
+
+	//! @brief ファイルを読み取り専用でマッピング
+	//!
+	//! @param[in] filePath ファイルパス
+	//!
+	//! @retval true  マッピング成功
+	//! @retval false ファイルが開けなかった
+	bool Open(const std::string& filePath);
+
+	//! @brief マッピングの解除
+	void Close();
+
+	//! @brief マッピングされたか
+	bool IsOpen() const;
+
+	//! @brief 先頭アドレスを取得
+	const char* GetData() const { return data_; }
+
+	//! @brief ファイルサイズを取得
+	size_t GetSize() const { return size_; }
+
+	// コピー禁止
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+
+	//=========================================================================================
+	// private variables
+	//=========================================================================================
+
+#ifdef _WIN32
+	HANDLE file_    = INVALID_HANDLE_VALUE;
+	HANDLE mapping_ = nullptr;
+#else
+	int file_ = -1; //!< file descriptor. tool, testのビルド用
+#endif
+
+	const char* data_ = nullptr;
+	size_t      size_ = 0;
+
+};
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "MaterialLibrary.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <mutex>
+#include <cstring>
+
+// engine
+#include <MappedFile.h>
+#include <MeshCache.h>
+#include <ObjLoader.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//-----------------------------------------------------------------------------------------
+	// 読み込み済みのtable
+	//-----------------------------------------------------------------------------------------
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// CachedTable structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct CachedTable {
+		uint64_t                             hash; //!< Parse時のmtlファイルのhash
+		std::shared_ptr<const MaterialTable> table;
+	};
+
+	std::mutex sMutex;
+	std::unordered_map<std::string, CachedTable> sTables; //!< key: mtlファイルパス
+
+	//! @brief 行の最後のtokenを取得. "map_Kd -s 1 1 1 file.png" などのoptionを読み飛ばす
+	std::string_view ReadLastToken(const char* ptr, const char* end) {
+		std::string_view result;
+
+		while (true) {
+			std::string_view token = ObjLoader::ReadToken(ptr, end);
+
+			if (token.empty()) {
+				break;
+			}
+
+			result = token;
+		}
+
+		return result;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MaterialLibrary methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+MaterialTable MaterialLibrary::Parse(const std::string& directoryPath, const std::string& filename) {
+	using namespace ObjLoader;
+
+	MaterialTable result;
+
+	// mtlファイルをマッピング
+	MappedFile file(directoryPath + "/" + filename);
+	if (!file.IsOpen()) { //!< ファイルが開けない. 全てのmaterialがtextureなしとなる
+		return result;
+	}
+
+	const char* ptr = file.GetData();
+	const char* end = ptr + file.GetSize();
+
+	MaterialData* material = nullptr; //!< 書き込み中のmaterial. "newmtl"より前の行は無視
+
+	while (ptr < end) {
+		// 一列分の範囲を取得
+		const char* lineEnd = static_cast<const char*>(std::memchr(ptr, '\n', static_cast<size_t>(end - ptr)));
+		if (lineEnd == nullptr) {
+			lineEnd = end;
+		}
+
+		std::string_view identifier = ReadToken(ptr, lineEnd);
+
+		if (identifier == "newmtl") { //!< material名
+			material = &result[std::string(ReadToken(ptr, lineEnd))];
+			*material = {};
+
+		} else if (material == nullptr) {
+			// materialの定義前なので飛ばす
+
+		} else if (identifier == "Kd") { //!< diffuse color
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, material->color.r);
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, material->color.g);
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, material->color.b);
+
+		} else if (identifier == "d") { //!< 不透明度
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, material->color.a);
+
+		} else if (identifier == "Ns") { //!< specular exponent
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, material->specPow);
+
+		} else if (identifier == "map_Kd") { //!< 使うtextureの名前
+			// 連結してファイルパスに変換
+			material->textureFilePath = directoryPath + "/" + std::string(ReadLastToken(ptr, lineEnd));
+			material->isUseTexture    = true;
+
+		} else if (identifier == "map_Bump" || identifier == "bump") { //!< normal map
+			material->normalFilePath = directoryPath + "/" + std::string(ReadLastToken(ptr, lineEnd));
+			material->isUseNormalMap = true;
+		}
+
+		// 次の列へ
+		ptr = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	return result;
+}
+
+std::shared_ptr<const MaterialTable> MaterialLibrary::Load(const std::string& directoryPath, const std::string& filename) {
+	std::string filePath = directoryPath + "/" + filename;
+
+	// cooked meshと同じhashで更新を判定する. mtlファイルは小さいのでlockの外で毎回計算
+	uint64_t hash = MeshCache::HashFile(filePath);
+
+	std::lock_guard<std::mutex> lock(sMutex);
+
+	auto it = sTables.find(filePath);
+	if (it != sTables.end() && it->second.hash == hash) { //!< 読み込み済みで, 変更されていない
+		return it->second.table;
+	}
+
+	auto table = std::make_shared<const MaterialTable>(Parse(directoryPath, filename));
+	sTables[filePath] = { hash, table }; //!< 変更された場合は置き換える. 古いtableは参照中のmodelが保持する
+
+	return table;
+}
+
+MaterialData MaterialLibrary::Find(const MaterialTable& table, const std::string& usemtl) {
+	auto it = table.find(usemtl);
+
+	if (it == table.end()) { //!< mtlファイルに定義されていない
+		return {};
+	}
+
+	return it->second;
+}
+
+void MaterialLibrary::Clear() {
+	std::lock_guard<std::mutex> lock(sMutex);
+	sTables.clear();
+}
\ No newline at end of file
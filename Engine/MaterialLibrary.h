@@ -0,0 +1,51 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <unordered_map>
+#include <memory>
+
+// structure
+#include <ModelRawData.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// using
+////////////////////////////////////////////////////////////////////////////////////////////
+using MaterialTable = std::unordered_map<std::string, MaterialData>; //!< key: newmtl名
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MaterialLibrary namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace MaterialLibrary {
+
+	//! @brief mtlファイルを全て読み込み, material名で引けるtableを作成
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      mtlファイル名
+	//!
+	//! @return materialTableを返却. ファイルが開けない場合は空
+	MaterialTable Parse(const std::string& directoryPath, const std::string& filename);
+
+	//! @brief 読み込み済みのtableを取得. 初めて参照された, または内容が変更されたmtlファイルのみParseする
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      mtlファイル名
+	//!
+	//! @return 同じmtlファイルを参照するmodel間で共有されるtableを返却
+	std::shared_ptr<const MaterialTable> Load(const std::string& directoryPath, const std::string& filename);
+
+	//! @brief tableからmaterialを検索
+	//!
+	//! @param[in] table  materialTable
+	//! @param[in] usemtl material名
+	//!
+	//! @return materialDataを返却. 見つからない場合はtextureなしのmaterial
+	MaterialData Find(const MaterialTable& table, const std::string& usemtl);
+
+	//! @brief 読み込み済みのtableを全て破棄
+	void Clear();
+
+}
\ No newline at end of file
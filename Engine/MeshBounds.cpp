@@ -0,0 +1,158 @@
+#include "MeshBounds.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+// simd
+#include <emmintrin.h>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief 頂点の位置 (x, y, z, w) を読み込む
+	__m128 LoadPosition(const VertexData& vertex) {
+		return _mm_loadu_ps(&vertex.position.x);
+	}
+
+	Vector3f StoreVector3(__m128 value) {
+		alignas(16) float values[4];
+		_mm_store_ps(values, value);
+
+		return { values[0], values[1], values[2] };
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshBounds methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+AABB MeshBounds::ComputeAABB(const VertexData* vertices, uint32_t count) {
+	if (count == 0) {
+		return { origin, origin };
+	}
+
+	// 依存を減らすため, 2頂点ずつ別のregisterで集計する
+	__m128 min0 = LoadPosition(vertices[0]);
+	__m128 max0 = min0;
+	__m128 min1 = min0;
+	__m128 max1 = min0;
+
+	uint32_t i = 1;
+
+	for (; i + 1 < count; i += 2) {
+		__m128 p0 = LoadPosition(vertices[i + 0]);
+		__m128 p1 = LoadPosition(vertices[i + 1]);
+
+		min0 = _mm_min_ps(min0, p0);
+		max0 = _mm_max_ps(max0, p0);
+		min1 = _mm_min_ps(min1, p1);
+		max1 = _mm_max_ps(max1, p1);
+	}
+
+	if (i < count) {
+		__m128 p = LoadPosition(vertices[i]);
+
+		min0 = _mm_min_ps(min0, p);
+		max0 = _mm_max_ps(max0, p);
+	}
+
+	return { StoreVector3(_mm_min_ps(min0, min1)), StoreVector3(_mm_max_ps(max0, max1)) };
+}
+
+Sphere MeshBounds::ComputeSphere(const VertexData* vertices, uint32_t count, const AABB& aabb) {
+	Sphere result = {};
+	result.center = (aabb.min + aabb.max) * 0.5f;
+	result.radius = 0.0f;
+
+	if (count == 0) {
+		return result;
+	}
+
+	// 距離の二乗の最大値. wは0にして無視する
+	const __m128 center = _mm_setr_ps(result.center.x, result.center.y, result.center.z, 0.0f);
+	const __m128 mask   = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+	__m128 maxLengthSq = _mm_setzero_ps();
+
+	for (uint32_t i = 0; i < count; ++i) {
+		__m128 d = _mm_and_ps(_mm_sub_ps(LoadPosition(vertices[i]), center), mask);
+		d = _mm_mul_ps(d, d);
+
+		// 水平加算
+		__m128 sum = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+		sum = _mm_add_ss(sum, _mm_movehl_ps(sum, sum));
+
+		maxLengthSq = _mm_max_ss(maxLengthSq, sum);
+	}
+
+	result.radius = std::sqrt(_mm_cvtss_f32(maxLengthSq));
+
+	return result;
+}
+
+AABB MeshBounds::Merge(const AABB& a, const AABB& b) {
+	return {
+		{ (std::min)(a.min.x, b.min.x), (std::min)(a.min.y, b.min.y), (std::min)(a.min.z, b.min.z) },
+		{ (std::max)(a.max.x, b.max.x), (std::max)(a.max.y, b.max.y), (std::max)(a.max.z, b.max.z) },
+	};
+}
+
+void MeshBounds::Union(const AABB* aabbs, const Sphere* spheres, uint32_t count, AABB& aabb, Sphere& sphere) {
+	if (count == 0) {
+		aabb   = { origin, origin };
+		sphere = { origin, 0.0f };
+		return;
+	}
+
+	aabb = aabbs[0];
+
+	for (uint32_t i = 1; i < count; ++i) {
+		aabb = Merge(aabb, aabbs[i]);
+	}
+
+	sphere.center = (aabb.min + aabb.max) * 0.5f;
+	sphere.radius = 0.0f;
+
+	for (uint32_t i = 0; i < count; ++i) {
+		sphere.radius = (std::max)(sphere.radius, Vector::Length(spheres[i].center - sphere.center) + spheres[i].radius);
+	}
+}
+
+void MeshBounds::Compute(ModelRawData& rawData) {
+	uint32_t meshCount = static_cast<uint32_t>(rawData.meshs.size());
+
+	Parallel::For(meshCount, [&](uint32_t index) {
+		MeshRawData& mesh = rawData.meshs[index];
+		uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+
+		mesh.aabb   = ComputeAABB(mesh.vertices.data(), vertexCount);
+		mesh.sphere = ComputeSphere(mesh.vertices.data(), vertexCount, mesh.aabb);
+	});
+
+	Union(rawData);
+}
+
+void MeshBounds::Union(ModelRawData& rawData) {
+	uint32_t meshCount = static_cast<uint32_t>(rawData.meshs.size());
+
+	std::vector<AABB>   aabbs(meshCount);
+	std::vector<Sphere> spheres(meshCount);
+
+	for (uint32_t i = 0; i < meshCount; ++i) {
+		aabbs[i]   = rawData.meshs[i].aabb;
+		spheres[i] = rawData.meshs[i].sphere;
+	}
+
+	Union(aabbs.data(), spheres.data(), meshCount, rawData.aabb, rawData.sphere);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+
+// structure
+#include <ModelRawData.h>
+
+// lib
+#include <Collider.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshBounds namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace MeshBounds {
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 頂点の位置のAABBを計算 (SSE2のmin/max)
+	//!
+	//! @param[in] vertices 頂点
+	//! @param[in] count    頂点数
+	//!
+	//! @return AABBを返却. 頂点がない場合は原点で大きさ0
+	AABB ComputeAABB(const VertexData* vertices, uint32_t count);
+
+	//! @brief AABBの中心から最も遠い頂点までの境界球を計算 (SSE2)
+	//!
+	//! @param[in] vertices 頂点
+	//! @param[in] count    頂点数
+	//! @param[in] aabb     ComputeAABBの結果
+	//!
+	//! @return 境界球を返却
+	Sphere ComputeSphere(const VertexData* vertices, uint32_t count, const AABB& aabb);
+
+	//! @brief 二つのAABBを含むAABB
+	AABB Merge(const AABB& a, const AABB& b);
+
+	//! @brief 各meshの境界を含む境界を計算
+	//!
+	//! @param[in]  aabbs   meshのAABB
+	//! @param[in]  spheres meshの境界球
+	//! @param[in]  count   mesh数
+	//! @param[out] aabb    全体のAABB
+	//! @param[out] sphere  全体の境界球. 中心は全体のAABBの中心
+	void Union(const AABB* aabbs, const Sphere* spheres, uint32_t count, AABB& aabb, Sphere& sphere);
+
+	//! @brief 計算済みのmesh毎の境界からmodel全体の境界を計算
+	//!
+	//! @param[in,out] rawData CPU側のmodelData
+	void Union(ModelRawData& rawData);
+
+	//! @brief mesh毎とmodel全体の境界を計算
+	//!
+	//! @param[in,out] rawData CPU側のmodelData
+	void Compute(ModelRawData& rawData);
+
+}
\ No newline at end of file
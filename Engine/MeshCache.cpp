@@ -0,0 +1,537 @@
+#include "MeshCache.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <cstring>
+#include <cassert>
+#include <atomic>
+#include <unordered_map>
+#include <memory>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//-----------------------------------------------------------------------------------------
+	// hash用定数
+	//-----------------------------------------------------------------------------------------
+	constexpr uint64_t kHashSeed   = 0xCBF29CE484222325ull;
+	constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ull;
+	constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4Full;
+
+	constexpr size_t kHashWindowSize = 64ull << 10; //!< HashFileの読み込み窓. 8の倍数
+
+	uint64_t RotateLeft(uint64_t value, int shift) {
+		return (value << shift) | (value >> (64 - shift));
+	}
+
+	uint64_t HashRound(uint64_t hash, uint64_t word) {
+		hash ^= RotateLeft(word * kHashPrime2, 31) * kHashPrime1;
+		return RotateLeft(hash, 27) * kHashPrime1 + kHashPrime2;
+	}
+
+	//! @brief 4byte境界までのpadding数
+	uint32_t GetPadding(size_t size) {
+		return static_cast<uint32_t>((4 - (size % 4)) % 4);
+	}
+
+	//! @brief mapping中のバッファを先頭から読み進める
+	class BinaryReader {
+	public:
+
+		BinaryReader(const char* data, size_t size) : ptr_(data), end_(data + size) {}
+
+		//! @brief sizeByte分を読み込めるか
+		bool CanRead(size_t sizeByte) const { return static_cast<size_t>(end_ - ptr_) >= sizeByte; }
+
+		//! @brief 値をコピーして読み進める
+		template <typename T>
+		bool Read(T& value) {
+			if (!CanRead(sizeof(T))) {
+				return false;
+			}
+
+			std::memcpy(&value, ptr_, sizeof(T));
+			ptr_ += sizeof(T);
+			return true;
+		}
+
+		//! @brief 現在位置を返して読み進める
+		const char* Skip(size_t sizeByte) {
+			if (!CanRead(sizeByte)) {
+				return nullptr;
+			}
+
+			const char* result = ptr_;
+			ptr_ += sizeByte;
+			return result;
+		}
+
+		bool IsEnd() const { return ptr_ >= end_; }
+
+	private:
+
+		const char* ptr_;
+		const char* end_;
+	};
+
+	//! @brief 長さ付き文字列 + paddingを読み込む
+	bool ReadString(BinaryReader& reader, std::string& value) {
+		uint32_t length = 0;
+		if (!reader.Read(length)) {
+			return false;
+		}
+
+		const char* str = reader.Skip(length + GetPadding(length));
+		if (str == nullptr) {
+			return false;
+		}
+
+		value.assign(str, length);
+		return true;
+	}
+
+	//! @brief 値をそのまま書き込む
+	template <typename T>
+	void WriteValue(std::vector<char>& buffer, const T& value) {
+		buffer.insert(buffer.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value) + sizeof(T));
+	}
+
+	//! @brief 長さ付き文字列 + paddingを書き込む
+	void WriteString(std::vector<char>& buffer, const std::string& value) {
+		uint32_t length = static_cast<uint32_t>(value.size());
+		WriteValue(buffer, length);
+		buffer.insert(buffer.end(), value.begin(), value.end());
+		buffer.insert(buffer.end(), GetPadding(length), '\0');
+	}
+
+	//! @brief chunkの書き込み
+	void WriteChunk(std::ofstream& file, MeshCache::ChunkType type, const std::vector<char>& data) {
+		MeshCache::ChunkHeader chunk = {};
+		chunk.type = type;
+		chunk.size = static_cast<uint32_t>(data.size());
+
+		file.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+		file.write(data.data(), data.size());
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// CookedFile class methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool MeshCache::CookedFile::Open(const std::string& filePath) {
+	Close();
+
+	if (!file_.Open(filePath) || file_.GetData() == nullptr) {
+		return false;
+	}
+
+	BinaryReader reader(file_.GetData(), file_.GetSize());
+
+	// headerの確認
+	if (!reader.Read(header_) || header_.magic != kMagic || header_.version != kVersion) {
+		Close();
+		return false;
+	}
+
+	// chunkの読み込み
+	while (!reader.IsEnd()) {
+		ChunkHeader chunk = {};
+		const char* data = nullptr;
+
+		if (!reader.Read(chunk) || (data = reader.Skip(chunk.size)) == nullptr) {
+			Close();
+			return false; //!< 書き込み途中のファイル
+		}
+
+		BinaryReader chunkReader(data, chunk.size);
+		bool isSuccess = true;
+
+		switch (chunk.type) {
+			case CHUNK_MTLLIB:
+				isSuccess = ReadString(chunkReader, mtlFilename_);
+				break;
+
+			case CHUNK_MATERIAL:
+				{
+					uint32_t materialCount = 0;
+					isSuccess = chunkReader.Read(materialCount);
+
+					for (uint32_t i = 0; isSuccess && i < materialCount; ++i) {
+						MaterialData material = {};
+						uint32_t isUseTexture   = 0;
+						uint32_t isUseNormalMap = 0;
+
+						isSuccess = chunkReader.Read(isUseTexture) && ReadString(chunkReader, material.textureFilePath)
+							&& chunkReader.Read(material.color) && chunkReader.Read(material.specPow)
+							&& chunkReader.Read(isUseNormalMap) && ReadString(chunkReader, material.normalFilePath);
+
+						material.isUseTexture   = (isUseTexture != 0);
+						material.isUseNormalMap = (isUseNormalMap != 0);
+
+						materials_.push_back(std::move(material));
+					}
+				}
+				break;
+
+			case CHUNK_MESH:
+				{
+					MeshView mesh = {};
+					isSuccess = chunkReader.Read(mesh.vertexCount) && chunkReader.Read(mesh.indexCount);
+
+					if (isSuccess) {
+						mesh.vertices = reinterpret_cast<const VertexData*>(chunkReader.Skip(sizeof(VertexData) * mesh.vertexCount));
+						mesh.indices  = reinterpret_cast<const uint32_t*>(chunkReader.Skip(sizeof(uint32_t) * mesh.indexCount));
+
+						isSuccess = (mesh.vertices != nullptr && mesh.indices != nullptr);
+					}
+
+					meshs_.push_back(mesh);
+				}
+				break;
+
+			case CHUNK_MESHLET:
+				{
+					if (meshs_.empty()) { //!< 対応するmeshがない
+						isSuccess = false;
+						break;
+					}
+
+					MeshView& mesh = meshs_.back();
+					isSuccess = chunkReader.Read(mesh.meshletCount);
+
+					if (isSuccess) {
+						mesh.meshlets = reinterpret_cast<const Meshlet*>(chunkReader.Skip(sizeof(Meshlet) * mesh.meshletCount));
+						isSuccess = (mesh.meshlets != nullptr);
+					}
+				}
+				break;
+
+			case CHUNK_LOD:
+				{
+					if (meshs_.empty()) { //!< 対応するmeshがない
+						isSuccess = false;
+						break;
+					}
+
+					MeshView& mesh = meshs_.back();
+					isSuccess = chunkReader.Read(mesh.lodCount);
+
+					if (isSuccess) {
+						mesh.lods = reinterpret_cast<const MeshLod*>(chunkReader.Skip(sizeof(MeshLod) * mesh.lodCount));
+						isSuccess = (mesh.lods != nullptr);
+					}
+				}
+				break;
+
+			case CHUNK_BOUNDS:
+				{
+					if (meshs_.empty()) { //!< 対応するmeshがない
+						isSuccess = false;
+						break;
+					}
+
+					MeshView& mesh = meshs_.back();
+					mesh.aabb   = reinterpret_cast<const AABB*>(chunkReader.Skip(sizeof(AABB)));
+					mesh.sphere = reinterpret_cast<const Sphere*>(chunkReader.Skip(sizeof(Sphere)));
+
+					isSuccess = (mesh.aabb != nullptr && mesh.sphere != nullptr);
+				}
+				break;
+
+			default:
+				break; //!< 未知のchunkは読み飛ばす
+		}
+
+		if (!isSuccess) {
+			Close();
+			return false;
+		}
+	}
+
+	if (meshs_.size() != materials_.size()) { //!< meshsとmaterialsのsizeは同じ
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MeshCache::CookedFile::Close() {
+	file_.Close();
+
+	header_ = {};
+	mtlFilename_.clear();
+	materials_.clear();
+	meshs_.clear();
+}
+
+bool MeshCache::CookedFile::IsFresh(const std::string& directoryPath, uint64_t objHash) const {
+	if (header_.objHash != objHash) {
+		return false;
+	}
+
+	if (mtlFilename_.empty()) { //!< mtlを参照していない
+		return header_.mtlHash == 0;
+	}
+
+	return header_.mtlHash == HashFile(directoryPath + "/" + mtlFilename_);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Writer class methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool MeshCache::Writer::Open(const std::string& filePath, uint64_t objHash) {
+	Abort();
+
+	// 書き込み途中のファイルを読まないよう, 一時ファイルに書き込んでから置き換える
+	filePath_     = filePath;
+	tempFilePath_ = MakeTempFilePath(filePath);
+
+	file_.open(tempFilePath_, std::ios::binary | std::ios::trunc);
+
+	if (!file_.is_open()) {
+		return false;
+	}
+
+	// header. mtlHashはCloseで書き直す
+	header_ = {};
+	header_.magic   = kMagic;
+	header_.version = kVersion;
+	header_.objHash = objHash;
+
+	file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+
+	return file_.good();
+}
+
+void MeshCache::Writer::WriteMesh(const MeshRawData& mesh) {
+	assert(file_.is_open()); //!< Open前に呼び出された
+
+	uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+	uint32_t indexCount  = static_cast<uint32_t>(mesh.indices.size());
+
+	ChunkHeader chunk = {};
+	chunk.type = CHUNK_MESH;
+	chunk.size = static_cast<uint32_t>(sizeof(uint32_t) * 2 + sizeof(VertexData) * vertexCount + sizeof(uint32_t) * indexCount);
+
+	file_.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+	file_.write(reinterpret_cast<const char*>(&vertexCount), sizeof(vertexCount));
+	file_.write(reinterpret_cast<const char*>(&indexCount), sizeof(indexCount));
+	file_.write(reinterpret_cast<const char*>(mesh.vertices.data()), sizeof(VertexData) * vertexCount);
+	file_.write(reinterpret_cast<const char*>(mesh.indices.data()), sizeof(uint32_t) * indexCount);
+
+	// meshlet
+	if (!mesh.meshlets.empty()) {
+		uint32_t meshletCount = static_cast<uint32_t>(mesh.meshlets.size());
+
+		chunk.type = CHUNK_MESHLET;
+		chunk.size = static_cast<uint32_t>(sizeof(uint32_t) + sizeof(Meshlet) * meshletCount);
+
+		file_.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+		file_.write(reinterpret_cast<const char*>(&meshletCount), sizeof(meshletCount));
+		file_.write(reinterpret_cast<const char*>(mesh.meshlets.data()), sizeof(Meshlet) * meshletCount);
+	}
+
+	// lod
+	if (!mesh.lods.empty()) {
+		uint32_t lodCount = static_cast<uint32_t>(mesh.lods.size());
+
+		chunk.type = CHUNK_LOD;
+		chunk.size = static_cast<uint32_t>(sizeof(uint32_t) + sizeof(MeshLod) * lodCount);
+
+		file_.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+		file_.write(reinterpret_cast<const char*>(&lodCount), sizeof(lodCount));
+		file_.write(reinterpret_cast<const char*>(mesh.lods.data()), sizeof(MeshLod) * lodCount);
+	}
+
+	// bounds
+	chunk.type = CHUNK_BOUNDS;
+	chunk.size = static_cast<uint32_t>(sizeof(AABB) + sizeof(Sphere));
+
+	file_.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+	file_.write(reinterpret_cast<const char*>(&mesh.aabb), sizeof(AABB));
+	file_.write(reinterpret_cast<const char*>(&mesh.sphere), sizeof(Sphere));
+}
+
+bool MeshCache::Writer::Close(const std::string& mtlFilename, const std::vector<MaterialData>& materials, uint64_t mtlHash) {
+	assert(file_.is_open()); //!< Open前に呼び出された
+
+	std::vector<char> buffer;
+
+	// mtllib
+	WriteString(buffer, mtlFilename);
+	WriteChunk(file_, CHUNK_MTLLIB, buffer);
+
+	// material table. meshの後でも読み込み側は順序に依存しない
+	buffer.clear();
+	uint32_t materialCount = static_cast<uint32_t>(materials.size());
+	WriteValue(buffer, materialCount);
+
+	for (const auto& material : materials) {
+		uint32_t isUseTexture = material.isUseTexture ? 1 : 0;
+		WriteValue(buffer, isUseTexture);
+		WriteString(buffer, material.isUseTexture ? material.textureFilePath : std::string());
+
+		WriteValue(buffer, material.color);
+		WriteValue(buffer, material.specPow);
+
+		uint32_t isUseNormalMap = material.isUseNormalMap ? 1 : 0;
+		WriteValue(buffer, isUseNormalMap);
+		WriteString(buffer, material.isUseNormalMap ? material.normalFilePath : std::string());
+	}
+
+	WriteChunk(file_, CHUNK_MATERIAL, buffer);
+
+	// headerのmtlHashを書き直す
+	header_.mtlHash = mtlHash;
+
+	file_.seekp(0);
+	file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+
+	if (!file_.good()) {
+		Abort();
+		return false;
+	}
+
+	file_.close();
+
+	std::error_code error;
+	std::filesystem::rename(tempFilePath_, filePath_, error);
+
+	if (error) {
+		std::filesystem::remove(tempFilePath_, error);
+		return false;
+	}
+
+	return true;
+}
+
+void MeshCache::Writer::Abort() {
+	if (!file_.is_open()) {
+		return;
+	}
+
+	file_.close();
+
+	std::error_code error;
+	std::filesystem::remove(tempFilePath_, error);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshCache methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string MeshCache::GetCookedFilePath(const std::string& directoryPath, const std::string& filename) {
+	return directoryPath + "/" + filename + kExtension;
+}
+
+std::string MeshCache::MakeTempFilePath(const std::string& filePath) {
+	static std::atomic<uint32_t> sTempCount = 0;
+
+#ifdef _WIN32
+	int processId = _getpid();
+#else
+	int processId = static_cast<int>(getpid());
+#endif
+
+	return filePath + "." + std::to_string(processId) + "." + std::to_string(sTempCount.fetch_add(1)) + ".tmp";
+}
+
+std::unique_lock<std::mutex> MeshCache::LockCook(const std::string& filePath) {
+	static std::mutex sMapMutex;
+	static std::unordered_map<std::string, std::unique_ptr<std::mutex>> sCookMutexs; //!< modelの数だけなので削除しない
+
+	std::mutex* cookMutex = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(sMapMutex);
+
+		auto& element = sCookMutexs[filePath];
+
+		if (element == nullptr) {
+			element = std::make_unique<std::mutex>();
+		}
+
+		cookMutex = element.get();
+	}
+
+	return std::unique_lock<std::mutex>(*cookMutex);
+}
+
+uint64_t MeshCache::HashFile(const std::string& filePath) {
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+
+	if (!file.is_open()) {
+		return 0;
+	}
+
+	uint64_t size = static_cast<uint64_t>(file.tellg());
+	file.seekg(0);
+
+	uint64_t hash = kHashSeed ^ (size * kHashPrime1);
+
+	// ファイル全体をメモリに置かないよう, 固定サイズの窓で読み進める
+	std::vector<char> window(kHashWindowSize);
+
+	while (true) {
+		file.read(window.data(), static_cast<std::streamsize>(window.size()));
+		size_t readSize = static_cast<size_t>(file.gcount());
+
+		// 8byteずつ処理. 窓は8の倍数なので, 途中の窓で端数は出ない
+		size_t wordCount = readSize / sizeof(uint64_t);
+		for (size_t i = 0; i < wordCount; ++i) {
+			uint64_t word;
+			std::memcpy(&word, window.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+			hash = HashRound(hash, word);
+		}
+
+		// 残りのbyte
+		size_t tailSize = readSize % sizeof(uint64_t);
+		if (tailSize != 0) {
+			uint64_t tail = 0;
+			std::memcpy(&tail, window.data() + wordCount * sizeof(uint64_t), tailSize);
+			hash = HashRound(hash, tail);
+		}
+
+		if (readSize < window.size()) { //!< ファイルの終端
+			break;
+		}
+	}
+
+	// avalanche
+	hash ^= hash >> 33;
+	hash *= kHashPrime2;
+	hash ^= hash >> 29;
+
+	return (hash == 0) ? 1 : hash; //!< 0はファイルなしとして扱う
+}
+
+bool MeshCache::Write(const std::string& filePath, const ModelRawData& rawData, uint64_t objHash, uint64_t mtlHash) {
+	Writer writer;
+
+	if (!writer.Open(filePath, objHash)) {
+		return false;
+	}
+
+	for (const auto& mesh : rawData.meshs) {
+		writer.WriteMesh(mesh);
+	}
+
+	return writer.Close(rawData.mtlFilename, rawData.materials, mtlHash);
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+
+// engine
+#include <MappedFile.h>
+#include <ModelRawData.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshCache namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace MeshCache {
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	//! @brief 4文字の識別子をuint32_tに変換 (ファイル上では文字列順に並ぶ)
+	constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+		return static_cast<uint32_t>(static_cast<uint8_t>(a))
+			| (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8)
+			| (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16)
+			| (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+	}
+
+	static const uint32_t kMagic   = MakeFourCC('C', 'M', 'S', 'H');
+	static const uint32_t kVersion = 6; //!< formatを変更したら更新
+
+	static const char kExtension[] = ".cmesh";
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Header structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t objHash; //!< 元objファイルのhash
+		uint64_t mtlHash; //!< 元mtlファイルのhash
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ChunkType enum
+	////////////////////////////////////////////////////////////////////////////////////////////
+	enum ChunkType : uint32_t {
+		CHUNK_MTLLIB   = MakeFourCC('M', 'T', 'L', 'B'), //!< mtlファイル名
+		CHUNK_MATERIAL = MakeFourCC('M', 'A', 'T', 'L'), //!< material table
+		CHUNK_MESH     = MakeFourCC('M', 'E', 'S', 'H'), //!< vertex, index blob
+		CHUNK_MESHLET  = MakeFourCC('M', 'S', 'L', 'T'), //!< 直前のmeshのmeshlet
+		CHUNK_LOD      = MakeFourCC('M', 'L', 'O', 'D'), //!< 直前のmeshのLOD範囲
+		CHUNK_BOUNDS   = MakeFourCC('B', 'N', 'D', 'S'), //!< 直前のmeshのAABB, 境界球
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ChunkHeader structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ChunkHeader {
+		uint32_t type; //!< ChunkType参照
+		uint32_t size; //!< ChunkHeaderを除いたbyteサイズ (4byte境界)
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// MeshView structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct MeshView { //!< mapping中のファイルを直接参照
+		const VertexData* vertices;
+		uint32_t          vertexCount;
+		const uint32_t*   indices;
+		uint32_t          indexCount;
+		const Meshlet*    meshlets;
+		uint32_t          meshletCount;
+		const MeshLod*    lods;
+		uint32_t          lodCount;
+		const AABB*       aabb;   //!< chunkがない場合はnullptr
+		const Sphere*     sphere;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// CookedFile class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	class CookedFile {
+	public:
+
+		//=========================================================================================
+		// public methods
+		//=========================================================================================
+
+		//! @brief cookedファイルをマッピングし, 各chunkを読み込む
+		//!
+		//! @param[in] filePath cookedファイルパス
+		//!
+		//! @retval true  正常なcookedファイル
+		//! @retval false ファイルがない, またはformatが異なる
+		bool Open(const std::string& filePath);
+
+		//! @brief マッピングの解除
+		void Close();
+
+		//! @brief 元ファイルから変更されていないか
+		//!
+		//! @param[in] directoryPath ディレクトリパス
+		//! @param[in] objHash       現在のobjファイルのhash
+		bool IsFresh(const std::string& directoryPath, uint64_t objHash) const;
+
+		const std::vector<MeshView>& GetMeshs() const { return meshs_; }
+
+		const std::vector<MaterialData>& GetMaterials() const { return materials_; }
+
+		const std::string& GetMtlFilename() const { return mtlFilename_; }
+
+	private:
+
+		//=========================================================================================
+		// private variables
+		//=========================================================================================
+
+		MappedFile file_;
+
+		Header                    header_ = {};
+		std::string               mtlFilename_;
+		std::vector<MaterialData> materials_;
+		std::vector<MeshView>     meshs_;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Writer class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	class Writer { //!< meshを一つずつ書き出す. model全体をメモリに置かずにcookedファイルを作成できる
+	public:
+
+		//=========================================================================================
+		// public methods
+		//=========================================================================================
+
+		//! @brief デストラクタ. Closeされていない場合は一時ファイルを削除
+		~Writer() { Abort(); }
+
+		//! @brief 一時ファイルを作成し, headerを書き込む
+		//!
+		//! @param[in] filePath cookedファイルパス
+		//! @param[in] objHash  元objファイルのhash
+		//!
+		//! @retval true  作成成功
+		//! @retval false 作成失敗
+		bool Open(const std::string& filePath, uint64_t objHash);
+
+		//! @brief meshと, そのmeshlet, LOD, 境界のchunkを書き込む
+		void WriteMesh(const MeshRawData& mesh);
+
+		//! @brief mtllib, material tableを書き込み, cookedファイルに置き換える
+		//!
+		//! @param[in] mtlFilename mtlファイル名
+		//! @param[in] materials   mesh毎のmaterial. WriteMeshした数と同じ
+		//! @param[in] mtlHash     元mtlファイルのhash
+		//!
+		//! @retval true  書き込み成功
+		//! @retval false 書き込み失敗. 一時ファイルは削除される
+		bool Close(const std::string& mtlFilename, const std::vector<MaterialData>& materials, uint64_t mtlHash);
+
+		//! @brief 書き込みを中断し, 一時ファイルを削除
+		void Abort();
+
+	private:
+
+		//=========================================================================================
+		// private variables
+		//=========================================================================================
+
+		std::ofstream file_;
+		std::string   filePath_;
+		std::string   tempFilePath_;
+		Header        header_ = {};
+
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief objファイルに対応するcookedファイルパスを取得
+	std::string GetCookedFilePath(const std::string& directoryPath, const std::string& filename);
+
+	//! @brief 書き込み用の一時ファイルパスを取得. process, 呼び出し毎に異なるので, 同じcookedファイルを同時に書き込んでも衝突しない
+	//!
+	//! @param[in] filePath 置き換え先のファイルパス
+	std::string MakeTempFilePath(const std::string& filePath);
+
+	//! @brief cookedファイル毎のlockを取得. 同じファイルのcookをprocess内で直列化する
+	//!
+	//! @param[in] filePath cookedファイルパス
+	//!
+	//! @return lockを返却. 破棄で解放
+	std::unique_lock<std::mutex> LockCook(const std::string& filePath);
+
+	//! @brief ファイル内容のhashを計算. ファイルは固定サイズの窓で読み進めるため, 大きさによらず使用メモリは一定
+	//!
+	//! @return hashを返却. ファイルがない場合は0
+	uint64_t HashFile(const std::string& filePath);
+
+	//! @brief cookedファイルの書き込み
+	//!
+	//! @param[in] filePath cookedファイルパス
+	//! @param[in] rawData  書き込むmodelData
+	//! @param[in] objHash  元objファイルのhash
+	//! @param[in] mtlHash  元mtlファイルのhash
+	//!
+	//! @retval true  書き込み成功
+	//! @retval false 書き込み失敗
+	bool Write(const std::string& filePath, const ModelRawData& rawData, uint64_t objHash, uint64_t mtlHash);
+
+}
\ No newline at end of file
@@ -0,0 +1,460 @@
+#include "MeshOptimizer.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+
+// engine
+#include <ScratchMemory.h>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kInvalidVertex = UINT32_MAX;
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// TriangleAdjacency structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct TriangleAdjacency { //!< 頂点 -> 頂点を含む三角形 (CSR形式)
+		ScratchMemory::Vector<uint32_t> offsets;   //!< size: vertexCount + 1
+		ScratchMemory::Vector<uint32_t> triangles; //!< offsets[v] ~ offsets[v + 1] が頂点vの三角形
+
+		TriangleAdjacency(const uint32_t* indices, size_t indexCount, uint32_t vertexCount) {
+			offsets.assign(vertexCount + 1, 0);
+
+			for (size_t i = 0; i < indexCount; ++i) {
+				offsets[indices[i] + 1]++;
+			}
+
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+			triangles.resize(indexCount);
+
+			ScratchMemory::Vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < indexCount; ++i) {
+				triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// FifoCache class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	class FifoCache { //!< timestampによるFIFO cacheのsimulation
+	public:
+
+		FifoCache(uint32_t vertexCount, uint32_t cacheSize)
+			: timestamps_(vertexCount, 0), cacheSize_(cacheSize), time_(cacheSize + 1) {
+		}
+
+		//! @brief 頂点を参照
+		//!
+		//! @retval true  cache miss
+		//! @retval false cache hit
+		bool Access(uint32_t vertex) {
+			if (time_ - timestamps_[vertex] > cacheSize_) {
+				timestamps_[vertex] = time_++;
+				return true;
+			}
+
+			return false;
+		}
+
+		//! @brief cacheを空にする
+		void Reset() { time_ += cacheSize_ + 1; }
+
+	private:
+
+		ScratchMemory::Vector<uint32_t> timestamps_;
+		uint32_t                        cacheSize_;
+		uint32_t                        time_;
+	};
+
+	Vector3f ToVector3(const Vector4f& v) {
+		return { v.x, v.y, v.z };
+	}
+
+	//! @brief cacheが全てmissする三角形の位置でclusterを区切る
+	ScratchMemory::Vector<uint32_t> GenerateHardBoundaries(const uint32_t* indices, size_t indexCount, uint32_t vertexCount, uint32_t cacheSize) {
+		ScratchMemory::Vector<uint32_t> result;
+
+		FifoCache cache(vertexCount, cacheSize);
+		uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+
+		for (uint32_t t = 0; t < triangleCount; ++t) {
+			uint32_t missCount = 0;
+			for (uint32_t k = 0; k < 3; ++k) {
+				missCount += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+			}
+
+			if (t == 0 || missCount == 3) {
+				result.push_back(t);
+			}
+		}
+
+		result.push_back(triangleCount);
+
+		return result;
+	}
+
+	//! @brief hard boundary内を, ACMRが悪化しすぎない範囲で更に細かく区切る
+	ScratchMemory::Vector<uint32_t> GenerateSoftBoundaries(const uint32_t* indices, size_t indexCount, uint32_t vertexCount, const ScratchMemory::Vector<uint32_t>& hardBoundaries, float threshold, uint32_t cacheSize) {
+		ScratchMemory::Vector<uint32_t> result;
+
+		FifoCache cache(vertexCount, cacheSize);
+
+		for (size_t c = 0; c + 1 < hardBoundaries.size(); ++c) {
+			uint32_t start = hardBoundaries[c];
+			uint32_t end   = hardBoundaries[c + 1];
+
+			// cluster全体のACMR
+			cache.Reset();
+
+			uint32_t clusterMiss = 0;
+			for (uint32_t i = start * 3; i < end * 3; ++i) {
+				clusterMiss += cache.Access(indices[i]) ? 1 : 0;
+			}
+
+			float targetAcmr = static_cast<float>(clusterMiss) / static_cast<float>(end - start) * threshold;
+
+			// 先頭から走査し, 目標のACMRを下回った位置で区切る
+			cache.Reset();
+			result.push_back(start);
+
+			uint32_t clusterStart = start;
+			uint32_t missCount    = 0;
+
+			for (uint32_t t = start; t < end; ++t) {
+				for (uint32_t k = 0; k < 3; ++k) {
+					missCount += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+				}
+
+				float acmr = static_cast<float>(missCount) / static_cast<float>(t - clusterStart + 1);
+
+				if (t + 1 < end && acmr <= targetAcmr) {
+					cache.Reset();
+					result.push_back(t + 1);
+
+					clusterStart = t + 1;
+					missCount    = 0;
+				}
+			}
+		}
+
+		result.push_back(static_cast<uint32_t>(indexCount / 3));
+
+		return result;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// 範囲毎の処理. 一時バッファはScratchMemoryで数え, 結果は同じ範囲に書き戻す
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief FIFO cacheをsimulateし, index順の効率を計測
+	MeshOptimizer::CacheStats AnalyzeRange(const uint32_t* indices, size_t indexCount, uint32_t vertexCount, uint32_t cacheSize) {
+		MeshOptimizer::CacheStats result = {};
+
+		if (indexCount == 0 || vertexCount == 0) {
+			return result;
+		}
+
+		FifoCache cache(vertexCount, cacheSize);
+
+		uint32_t missCount = 0;
+		for (size_t i = 0; i < indexCount; ++i) {
+			missCount += cache.Access(indices[i]) ? 1 : 0;
+		}
+
+		result.acmr = static_cast<float>(missCount) / static_cast<float>(indexCount / 3);
+		result.atvr = static_cast<float>(missCount) / static_cast<float>(vertexCount);
+
+		return result;
+	}
+
+	//! @brief Tipsifyによる三角形の並び替え
+	void OptimizeVertexCacheRange(uint32_t* indices, size_t indexCount, uint32_t vertexCount, uint32_t cacheSize) {
+		uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+
+		if (triangleCount == 0) {
+			return;
+		}
+
+		TriangleAdjacency adjacency(indices, indexCount, vertexCount);
+
+		// 頂点毎の未出力の三角形数
+		ScratchMemory::Vector<uint32_t> liveTriangles(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; ++v) {
+			liveTriangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+		}
+
+		ScratchMemory::Vector<uint32_t> cacheTimes(vertexCount, 0);
+		ScratchMemory::Vector<bool>     isEmitted(triangleCount, false);
+
+		ScratchMemory::Vector<uint32_t> deadEnd; //!< 出力した頂点のstack. 行き詰まった時に戻る
+		deadEnd.reserve(indexCount);
+
+		ScratchMemory::Vector<uint32_t> candidates;
+
+		ScratchMemory::Vector<uint32_t> result;
+		result.reserve(indexCount);
+
+		uint32_t time   = cacheSize + 1;
+		uint32_t cursor = 0; //!< 未出力の頂点の走査位置
+
+		uint32_t fanning = 0;
+
+		while (fanning != kInvalidVertex) {
+			candidates.clear();
+
+			// fanning頂点の三角形を全て出力
+			for (uint32_t a = adjacency.offsets[fanning]; a < adjacency.offsets[fanning + 1]; ++a) {
+				uint32_t t = adjacency.triangles[a];
+
+				if (isEmitted[t]) {
+					continue;
+				}
+
+				for (uint32_t k = 0; k < 3; ++k) {
+					uint32_t vertex = indices[t * 3 + k];
+
+					result.push_back(vertex);
+					deadEnd.push_back(vertex);
+					candidates.push_back(vertex);
+
+					liveTriangles[vertex]--;
+
+					if (time - cacheTimes[vertex] > cacheSize) { //!< cacheに入っていない
+						cacheTimes[vertex] = time++;
+					}
+				}
+
+				isEmitted[t] = true;
+			}
+
+			// 次のfanning頂点の選択. cacheに残っている間に三角形を使い切れる頂点を優先
+			uint32_t next     = kInvalidVertex;
+			int32_t  priority = -1;
+
+			for (uint32_t vertex : candidates) {
+				if (liveTriangles[vertex] == 0) {
+					continue;
+				}
+
+				int32_t p = 0;
+				if (time - cacheTimes[vertex] + 2 * liveTriangles[vertex] <= cacheSize) {
+					p = static_cast<int32_t>(time - cacheTimes[vertex]);
+				}
+
+				if (p > priority) {
+					priority = p;
+					next     = vertex;
+				}
+			}
+
+			if (next == kInvalidVertex) { //!< 行き詰まった場合
+				while (!deadEnd.empty()) {
+					uint32_t vertex = deadEnd.back();
+					deadEnd.pop_back();
+
+					if (liveTriangles[vertex] > 0) {
+						next = vertex;
+						break;
+					}
+				}
+			}
+
+			if (next == kInvalidVertex) { //!< stackにもない場合は未出力の頂点から
+				while (cursor < vertexCount) {
+					if (liveTriangles[cursor] > 0) {
+						next = cursor;
+						break;
+					}
+
+					++cursor;
+				}
+			}
+
+			fanning = next;
+		}
+
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+	//! @brief clusterに分け, 外側を向いたclusterから描画されるよう並び替え
+	void OptimizeOverdrawRange(uint32_t* indices, size_t indexCount, const std::vector<VertexData>& vertices, float threshold, uint32_t cacheSize) {
+		uint32_t vertexCount   = static_cast<uint32_t>(vertices.size());
+		uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+
+		if (triangleCount == 0) {
+			return;
+		}
+
+		// clusterに分割
+		ScratchMemory::Vector<uint32_t> hardBoundaries = GenerateHardBoundaries(indices, indexCount, vertexCount, cacheSize);
+		ScratchMemory::Vector<uint32_t> boundaries     = GenerateSoftBoundaries(indices, indexCount, vertexCount, hardBoundaries, threshold, cacheSize);
+
+		size_t clusterCount = boundaries.size() - 1;
+
+		if (clusterCount <= 1) {
+			return;
+		}
+
+		// mesh全体の重心 (面積で重み付け)
+		Vector3f meshCentroid = origin;
+		float    meshArea     = 0.0f;
+
+		ScratchMemory::Vector<Vector3f> clusterCentroids(clusterCount, origin);
+		ScratchMemory::Vector<Vector3f> clusterNormals(clusterCount, origin);
+
+		for (size_t c = 0; c < clusterCount; ++c) {
+			float clusterArea = 0.0f;
+
+			for (uint32_t t = boundaries[c]; t < boundaries[c + 1]; ++t) {
+				Vector3f p0 = ToVector3(vertices[indices[t * 3 + 0]].position);
+				Vector3f p1 = ToVector3(vertices[indices[t * 3 + 1]].position);
+				Vector3f p2 = ToVector3(vertices[indices[t * 3 + 2]].position);
+
+				Vector3f normal = Vector::Cross(p1 - p0, p2 - p0);
+				float    area   = Vector::Length(normal);
+
+				Vector3f center = (p0 + p1 + p2) * (1.0f / 3.0f);
+
+				clusterCentroids[c] += center * area;
+				clusterNormals[c]   += normal;
+				clusterArea         += area;
+			}
+
+			meshCentroid += clusterCentroids[c];
+			meshArea     += clusterArea;
+
+			clusterCentroids[c] *= (clusterArea == 0.0f) ? 0.0f : 1.0f / clusterArea;
+		}
+
+		meshCentroid *= (meshArea == 0.0f) ? 0.0f : 1.0f / meshArea;
+
+		// 外側を向いているclusterほど先に描画 (手前の面で奥の面を隠す)
+		ScratchMemory::Vector<float> sortKeys(clusterCount);
+		for (size_t c = 0; c < clusterCount; ++c) {
+			float length = Vector::Length(clusterNormals[c]);
+			Vector3f normal = (length == 0.0f) ? origin : clusterNormals[c] * (1.0f / length);
+
+			sortKeys[c] = Vector::Dot(clusterCentroids[c] - meshCentroid, normal);
+		}
+
+		ScratchMemory::Vector<uint32_t> order(clusterCount);
+		std::iota(order.begin(), order.end(), 0);
+
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			return sortKeys[a] > sortKeys[b];
+		});
+
+		ScratchMemory::Vector<uint32_t> result;
+		result.reserve(indexCount);
+
+		for (uint32_t c : order) {
+			result.insert(result.end(), indices + boundaries[c] * 3, indices + boundaries[c + 1] * 3);
+		}
+
+		// cluster境界でのcache missが多く, 全体のACMRが許容値を超える場合は並び替えない
+		float beforeAcmr = AnalyzeRange(indices, indexCount, vertexCount, cacheSize).acmr;
+		float afterAcmr  = AnalyzeRange(result.data(), result.size(), vertexCount, cacheSize).acmr;
+
+		if (afterAcmr > beforeAcmr * threshold) {
+			return;
+		}
+
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshOptimizer methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize) {
+	return AnalyzeRange(indices.data(), indices.size(), vertexCount, cacheSize);
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize) {
+	assert(indices.size() % 3 == 0); //!< 三角形リストではない
+
+	OptimizeVertexCacheRange(indices.data(), indices.size(), vertexCount, cacheSize);
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices, float threshold, uint32_t cacheSize) {
+	OptimizeOverdrawRange(indices.data(), indices.size(), vertices, threshold, cacheSize);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<VertexData>& vertices, std::vector<uint32_t>& indices) {
+	ScratchMemory::Vector<uint32_t> remap(vertices.size(), kInvalidVertex);
+
+	ScratchMemory::Vector<VertexData> result;
+	result.reserve(vertices.size());
+
+	for (auto& index : indices) {
+		if (remap[index] == kInvalidVertex) { //!< 初めて参照された頂点
+			remap[index] = static_cast<uint32_t>(result.size());
+			result.push_back(vertices[index]);
+		}
+
+		index = remap[index];
+	}
+
+	vertices.assign(result.begin(), result.end()); //!< 呼び出し側が確保したcapacityは保持
+}
+
+MeshOptimizer::OptimizeResult MeshOptimizer::Optimize(MeshRawData& mesh) {
+	uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+
+	// LODがない場合はindex全体を一段として扱う
+	ScratchMemory::Vector<MeshLod> lods(mesh.lods.begin(), mesh.lods.end());
+
+	if (lods.empty()) {
+		lods.push_back({ 0, static_cast<uint32_t>(mesh.indices.size()), 0.0f });
+	}
+
+	OptimizeResult result = {};
+
+	// LOD毎に三角形を並び替え. 範囲は変わらない
+	for (size_t lod = 0; lod < lods.size(); ++lod) {
+		uint32_t* indices    = mesh.indices.data() + lods[lod].indexOffset;
+		size_t    indexCount = lods[lod].indexCount;
+
+		ScratchMemory::Vector<uint32_t> original(indices, indices + indexCount);
+		CacheStats before = AnalyzeRange(indices, indexCount, vertexCount, kDefaultCacheSize);
+
+		OptimizeVertexCacheRange(indices, indexCount, vertexCount, kDefaultCacheSize);
+
+		if (AnalyzeRange(indices, indexCount, vertexCount, kDefaultCacheSize).acmr >= before.acmr) { //!< 元の順番の方が良い場合はそのまま
+			std::copy(original.begin(), original.end(), indices);
+		}
+
+		if (lod == 0) { //!< overdrawは近距離で描画されるLOD0のみ
+			result.before = before;
+			OptimizeOverdrawRange(indices, indexCount, mesh.vertices, kDefaultOverdrawThreshold, kDefaultCacheSize);
+		}
+	}
+
+	// 頂点は全LODで共有. LOD0で最初に参照される順に並ぶ
+	OptimizeVertexFetch(mesh.vertices, mesh.indices);
+
+	result.after = AnalyzeRange(mesh.indices.data() + lods[0].indexOffset, lods[0].indexCount, static_cast<uint32_t>(mesh.vertices.size()), kDefaultCacheSize);
+
+	return result;
+}
+
+void MeshOptimizer::Optimize(ModelRawData& rawData) {
+	Parallel::For(static_cast<uint32_t>(rawData.meshs.size()), [&](uint32_t index) {
+		Optimize(rawData.meshs[index]);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <cstdint>
+
+// structure
+#include <ModelRawData.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshOptimizer namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace MeshOptimizer {
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const uint32_t kDefaultCacheSize        = 16;    //!< post-transform cacheのentry数 (FIFO)
+	static const float    kDefaultOverdrawThreshold = 1.05f; //!< overdraw最適化で許容するACMRの悪化率
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// CacheStats structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct CacheStats {
+		float acmr; //!< average cache miss ratio. 変換頂点数 / 三角形数 (0.5 ~ 3.0)
+		float atvr; //!< average transformed vertex ratio. 変換頂点数 / 頂点数 (1.0 ~)
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// OptimizeResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct OptimizeResult {
+		CacheStats before;
+		CacheStats after;
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief FIFO cacheをsimulateし, index順の効率を計測
+	//!
+	//! @param[in] indices     三角形リストのindex
+	//! @param[in] vertexCount 頂点数
+	//! @param[in] cacheSize   cacheのentry数
+	//!
+	//! @return 計測結果を返却
+	CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = kDefaultCacheSize);
+
+	//! @brief Tipsifyによる三角形の並び替え. 三角形内の頂点順(winding)は保持
+	//!
+	//! @param[in,out] indices     三角形リストのindex
+	//! @param[in]     vertexCount 頂点数
+	//! @param[in]     cacheSize   cacheのentry数
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = kDefaultCacheSize);
+
+	//! @brief cache最適化後の三角形をclusterに分け, 外側を向いたclusterから描画されるよう並び替え
+	//!
+	//! @param[in,out] indices   OptimizeVertexCache済みのindex
+	//! @param[in]     vertices  頂点
+	//! @param[in]     threshold clusterを細かく分ける際に許容するACMRの悪化率
+	//! @param[in]     cacheSize cacheのentry数
+	void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices, float threshold = kDefaultOverdrawThreshold, uint32_t cacheSize = kDefaultCacheSize);
+
+	//! @brief 頂点をindexで最初に参照される順に並び替え. 参照されない頂点は削除
+	//!
+	//! @param[in,out] vertices 頂点
+	//! @param[in,out] indices  三角形リストのindex
+	void OptimizeVertexFetch(std::vector<VertexData>& vertices, std::vector<uint32_t>& indices);
+
+	//! @brief vertex cache, overdraw, vertex fetch の順に最適化
+	//!
+	//! LODがある場合は各LODの範囲内で並び替え, overdrawはLOD0のみ
+	//!
+	//! @param[in,out] mesh CPU側のmesh
+	//!
+	//! @return 最適化前後の計測結果を返却 (LOD0)
+	OptimizeResult Optimize(MeshRawData& mesh);
+
+	//! @brief model内の全meshを最適化. meshは複数スレッドで処理
+	//!
+	//! @param[in,out] rawData CPU側のmodelData
+	void Optimize(ModelRawData& rawData);
+
+}
\ No newline at end of file
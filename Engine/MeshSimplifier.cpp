@@ -0,0 +1,607 @@
+#include "MeshSimplifier.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+	//! 一段で削減できた三角形がこれ未満の比率の場合, LODを打ち切る
+	constexpr float kMinLodProgress = 0.9f;
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Quadric structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Quadric { //!< 平面までの距離の二乗和 (対称4x4行列)
+		double a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+		double weight;
+
+		void AddPlane(double a, double b, double c, double d, double w) {
+			a2 += w * a * a; b2 += w * b * b; c2 += w * c * c;
+			ab += w * a * b; ac += w * a * c; bc += w * b * c;
+			ad += w * a * d; bd += w * b * d; cd += w * c * d;
+			d2 += w * d * d;
+
+			weight += w;
+		}
+
+		void operator+=(const Quadric& other) {
+			a2 += other.a2; b2 += other.b2; c2 += other.c2;
+			ab += other.ab; ac += other.ac; bc += other.bc;
+			ad += other.ad; bd += other.bd; cd += other.cd;
+			d2 += other.d2;
+
+			weight += other.weight;
+		}
+
+		//! @brief 点pに移動した場合の誤差 (平均距離の二乗)
+		double Evaluate(const Vector3f& p) const {
+			double x = p.x, y = p.y, z = p.z;
+
+			double result
+				= a2 * x * x + b2 * y * y + c2 * z * z
+				+ 2.0 * (ab * x * y + ac * x * z + bc * y * z)
+				+ 2.0 * (ad * x + bd * y + cd * z)
+				+ d2;
+
+			return (weight == 0.0) ? 0.0 : (std::max)(result / weight, 0.0);
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Collapse structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Collapse { //!< 位置groupをfromからtoへ寄せる
+		uint32_t from;
+		uint32_t to;
+		double   cost;
+	};
+
+	Vector3f ToVector3(const Vector4f& v) {
+		return { v.x, v.y, v.z };
+	}
+
+	uint64_t MakeEdgeKey(uint32_t a, uint32_t b) {
+		return (a < b)
+			? (static_cast<uint64_t>(a) << 32) | b
+			: (static_cast<uint64_t>(b) << 32) | a;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshSimplifier methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices, uint32_t targetIndexCount, float targetError, float* resultError) {
+	assert(indices.size() % 3 == 0); //!< 三角形リストではない
+
+	std::vector<uint32_t> result = indices;
+
+	float maxError = 0.0f;
+
+	if (resultError != nullptr) {
+		*resultError = 0.0f;
+	}
+
+	uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+	float    scale       = GetMeshScale(vertices);
+
+	if (result.size() <= targetIndexCount || scale == 0.0f) {
+		return result;
+	}
+
+	//=========================================================================================
+	// 同じ位置の頂点(wedge)をgroupにまとめる
+	//=========================================================================================
+
+	std::vector<uint32_t> groups(vertexCount);    //!< 頂点 -> 位置group
+	std::vector<Vector3f> groupPositions;
+
+	{
+		std::unordered_map<uint64_t, std::vector<uint32_t>> buckets; //!< 位置のhash -> group候補
+
+		for (uint32_t v = 0; v < vertexCount; ++v) {
+			Vector3f position = ToVector3(vertices[v].position);
+
+			uint32_t bits[3];
+			std::memcpy(bits, &position, sizeof(bits));
+
+			uint64_t hash = bits[0];
+			hash = hash * 0x9E3779B97F4A7C15ull ^ bits[1];
+			hash = hash * 0x9E3779B97F4A7C15ull ^ bits[2];
+
+			auto& candidates = buckets[hash];
+
+			groups[v] = kInvalidIndex;
+			for (uint32_t group : candidates) {
+				if (std::memcmp(&groupPositions[group], &position, sizeof(Vector3f)) == 0) {
+					groups[v] = group;
+					break;
+				}
+			}
+
+			if (groups[v] == kInvalidIndex) {
+				groups[v] = static_cast<uint32_t>(groupPositions.size());
+				candidates.push_back(groups[v]);
+				groupPositions.push_back(position);
+			}
+		}
+	}
+
+	uint32_t groupCount = static_cast<uint32_t>(groupPositions.size());
+
+	// group -> wedge (CSR形式)
+	std::vector<uint32_t> groupOffsets(groupCount + 1, 0);
+	std::vector<uint32_t> groupWedges(vertexCount);
+
+	for (uint32_t v = 0; v < vertexCount; ++v) {
+		groupOffsets[groups[v] + 1]++;
+	}
+
+	std::partial_sum(groupOffsets.begin(), groupOffsets.end(), groupOffsets.begin());
+
+	{
+		std::vector<uint32_t> cursor(groupOffsets.begin(), groupOffsets.end() - 1);
+		for (uint32_t v = 0; v < vertexCount; ++v) {
+			groupWedges[cursor[groups[v]]++] = v;
+		}
+	}
+
+	//=========================================================================================
+	// 各groupのquadric. 隣接する三角形の平面を面積で重み付け
+	//=========================================================================================
+
+	std::vector<Quadric> quadrics(groupCount, Quadric{});
+
+	for (size_t i = 0; i < result.size(); i += 3) {
+		Vector3f p0 = groupPositions[groups[result[i + 0]]];
+		Vector3f p1 = groupPositions[groups[result[i + 1]]];
+		Vector3f p2 = groupPositions[groups[result[i + 2]]];
+
+		Vector3f normal = Vector::Cross(p1 - p0, p2 - p0);
+		float    length = Vector::Length(normal);
+
+		if (length == 0.0f) {
+			continue;
+		}
+
+		normal *= 1.0f / length;
+		float distance = -Vector::Dot(normal, p0);
+
+		for (uint32_t k = 0; k < 3; ++k) {
+			quadrics[groups[result[i + k]]].AddPlane(normal.x, normal.y, normal.z, distance, length * 0.5f);
+		}
+	}
+
+	// borderのedgeには三角形と直交する平面を加え, 縁の形状(角)が崩れないようにする
+	{
+		std::unordered_map<uint64_t, uint32_t> initialEdgeCounts;
+
+		for (size_t i = 0; i < result.size(); i += 3) {
+			for (uint32_t k = 0; k < 3; ++k) {
+				initialEdgeCounts[MakeEdgeKey(groups[result[i + k]], groups[result[i + (k + 1) % 3]])]++;
+			}
+		}
+
+		for (size_t i = 0; i < result.size(); i += 3) {
+			Vector3f p0 = groupPositions[groups[result[i + 0]]];
+			Vector3f p1 = groupPositions[groups[result[i + 1]]];
+			Vector3f p2 = groupPositions[groups[result[i + 2]]];
+
+			Vector3f normal = Vector::Cross(p1 - p0, p2 - p0);
+
+			for (uint32_t k = 0; k < 3; ++k) {
+				uint32_t a = groups[result[i + k]];
+				uint32_t b = groups[result[i + (k + 1) % 3]];
+
+				if (initialEdgeCounts[MakeEdgeKey(a, b)] != 1) {
+					continue;
+				}
+
+				Vector3f edge      = groupPositions[b] - groupPositions[a];
+				Vector3f direction = Vector::Cross(edge, normal);
+				float    length    = Vector::Length(direction);
+
+				if (length == 0.0f) {
+					continue;
+				}
+
+				direction *= 1.0f / length;
+				float distance = -Vector::Dot(direction, groupPositions[a]);
+				float weight   = Vector::Dot(edge, edge);
+
+				quadrics[a].AddPlane(direction.x, direction.y, direction.z, distance, weight);
+				quadrics[b].AddPlane(direction.x, direction.y, direction.z, distance, weight);
+			}
+		}
+	}
+
+	//=========================================================================================
+	// edge collapse. 一回のpassで互いに影響しないcollapseをまとめて行う
+	//=========================================================================================
+
+	double errorLimit = static_cast<double>(targetError) * scale;
+	errorLimit *= errorLimit; //!< quadricは距離の二乗
+
+	std::vector<uint32_t> triangleOffsets;
+	std::vector<uint32_t> triangleList;
+
+	std::vector<uint8_t>  groupStates(groupCount); //!< 0: 自由, 1: border, 2: 固定
+	std::vector<bool>     isTouched(groupCount);
+	std::vector<uint32_t> wedgeTargets;
+	std::vector<uint32_t> wedgeCandidates;
+	std::vector<uint32_t> targetCandidates;
+	std::vector<Collapse> collapses;
+
+	std::unordered_map<uint64_t, uint32_t> edgeCounts;
+
+	while (result.size() > targetIndexCount) {
+		uint32_t triangleCount = static_cast<uint32_t>(result.size() / 3);
+
+		// 頂点 -> 三角形
+		triangleOffsets.assign(vertexCount + 1, 0);
+		for (uint32_t index : result) {
+			triangleOffsets[index + 1]++;
+		}
+
+		std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+		triangleList.resize(result.size());
+
+		{
+			std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+			for (size_t i = 0; i < result.size(); ++i) {
+				triangleList[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		// 位置空間でのedgeの使用数. 1ならborder, 3以上なら非多様体
+		edgeCounts.clear();
+		collapses.clear();
+
+		for (uint32_t t = 0; t < triangleCount; ++t) {
+			for (uint32_t k = 0; k < 3; ++k) {
+				uint32_t a = groups[result[t * 3 + k]];
+				uint32_t b = groups[result[t * 3 + (k + 1) % 3]];
+
+				edgeCounts[MakeEdgeKey(a, b)]++;
+			}
+		}
+
+		std::fill(groupStates.begin(), groupStates.end(), static_cast<uint8_t>(0));
+		std::vector<uint32_t> borderEdgeCounts(groupCount, 0);
+
+		for (const auto& [key, count] : edgeCounts) {
+			uint32_t a = static_cast<uint32_t>(key >> 32);
+			uint32_t b = static_cast<uint32_t>(key & 0xFFFFFFFF);
+
+			if (count == 1) {
+				borderEdgeCounts[a]++;
+				borderEdgeCounts[b]++;
+
+			} else if (count > 2) { //!< 非多様体は固定
+				groupStates[a] = 2;
+				groupStates[b] = 2;
+			}
+		}
+
+		for (uint32_t g = 0; g < groupCount; ++g) {
+			if (groupStates[g] == 2 || borderEdgeCounts[g] == 0) {
+				continue;
+			}
+
+			groupStates[g] = (borderEdgeCounts[g] == 2) ? 1 : 2; //!< borderの角や分岐は固定
+		}
+
+		// collapse候補
+		for (uint32_t t = 0; t < triangleCount; ++t) {
+			for (uint32_t k = 0; k < 3; ++k) {
+				uint32_t a = groups[result[t * 3 + k]];
+				uint32_t b = groups[result[t * 3 + (k + 1) % 3]];
+
+				for (uint32_t dir = 0; dir < 2; ++dir) {
+					uint32_t from = (dir == 0) ? a : b;
+					uint32_t to   = (dir == 0) ? b : a;
+
+					if (groupStates[from] == 2) {
+						continue;
+					}
+
+					if (groupStates[from] == 1 && (groupStates[to] == 0 || edgeCounts[MakeEdgeKey(from, to)] != 1)) {
+						continue; //!< borderはborderに沿ってのみ
+					}
+
+					collapses.push_back({ from, to, quadrics[from].Evaluate(groupPositions[to]) });
+				}
+			}
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) {
+			if (x.cost != y.cost) { return x.cost < y.cost; }
+			if (x.from != y.from) { return x.from < y.from; }
+			return x.to < y.to;
+		});
+
+		// 適用
+		std::fill(isTouched.begin(), isTouched.end(), false);
+
+		uint32_t removedCount = 0; //!< このpassで縮退した三角形数
+		uint32_t appliedCount = 0;
+
+		for (const auto& collapse : collapses) {
+			if (collapse.cost > errorLimit) {
+				break;
+			}
+
+			if ((triangleCount - removedCount) * 3 <= targetIndexCount) {
+				break;
+			}
+
+			if (isTouched[collapse.from] || isTouched[collapse.to]) {
+				continue;
+			}
+
+			// wedge毎に, edgeで繋がっているto側のwedgeを寄せ先にする
+			bool isValid = true;
+
+			// from側のwedgeの違いがnormalのみの場合, 寄せ先はnormalが最も近いwedgeで代用できる
+			bool isNormalSeam = true;
+
+			for (uint32_t w = groupOffsets[collapse.from] + 1; w < groupOffsets[collapse.from + 1]; ++w) {
+				const Vector2f& texcoord = vertices[groupWedges[w]].texcoord;
+				const Vector2f& first    = vertices[groupWedges[groupOffsets[collapse.from]]].texcoord;
+
+				isNormalSeam &= (texcoord.x == first.x && texcoord.y == first.y);
+			}
+
+			// edgeで繋がっているto側のwedge
+			targetCandidates.clear();
+
+			for (uint32_t w = groupOffsets[collapse.from]; w < groupOffsets[collapse.from + 1]; ++w) {
+				uint32_t wedge = groupWedges[w];
+
+				for (uint32_t a = triangleOffsets[wedge]; a < triangleOffsets[wedge + 1]; ++a) {
+					uint32_t t = triangleList[a];
+
+					for (uint32_t k = 0; k < 3; ++k) {
+						if (groups[result[t * 3 + k]] == collapse.to) {
+							targetCandidates.push_back(result[t * 3 + k]);
+						}
+					}
+				}
+			}
+
+			std::sort(targetCandidates.begin(), targetCandidates.end());
+			targetCandidates.erase(std::unique(targetCandidates.begin(), targetCandidates.end()), targetCandidates.end());
+
+			// normalが最も近い候補
+			auto findClosestNormal = [&](uint32_t wedge, const std::vector<uint32_t>& candidates) {
+				uint32_t closest = kInvalidIndex;
+				float    maxDot  = -2.0f;
+
+				for (uint32_t candidate : candidates) {
+					float dot = Vector::Dot(vertices[wedge].normal, vertices[candidate].normal);
+
+					if (dot > maxDot) {
+						maxDot  = dot;
+						closest = candidate;
+					}
+				}
+
+				return closest;
+			};
+
+			wedgeTargets.clear();
+
+			for (uint32_t w = groupOffsets[collapse.from]; w < groupOffsets[collapse.from + 1] && isValid; ++w) {
+				uint32_t wedge = groupWedges[w];
+
+				wedgeTargets.push_back(kInvalidIndex);
+
+				if (triangleOffsets[wedge] == triangleOffsets[wedge + 1]) { //!< 使われていないwedge
+					continue;
+				}
+
+				wedgeCandidates.clear();
+
+				for (uint32_t a = triangleOffsets[wedge]; a < triangleOffsets[wedge + 1]; ++a) {
+					uint32_t t = triangleList[a];
+
+					for (uint32_t k = 0; k < 3; ++k) {
+						if (groups[result[t * 3 + k]] == collapse.to) {
+							wedgeCandidates.push_back(result[t * 3 + k]);
+						}
+					}
+				}
+
+				std::sort(wedgeCandidates.begin(), wedgeCandidates.end());
+				wedgeCandidates.erase(std::unique(wedgeCandidates.begin(), wedgeCandidates.end()), wedgeCandidates.end());
+
+				if (wedgeCandidates.size() == 1) {
+					wedgeTargets.back() = wedgeCandidates.front();
+
+				} else if (!isNormalSeam) {
+					isValid = false; //!< uvの境目を跨いでしまう
+
+				} else {
+					wedgeTargets.back() = findClosestNormal(wedge, wedgeCandidates.empty() ? targetCandidates : wedgeCandidates);
+					isValid = (wedgeTargets.back() != kInvalidIndex);
+				}
+			}
+
+			if (!isValid) {
+				continue;
+			}
+
+			// 三角形が裏返らないか
+			for (uint32_t w = groupOffsets[collapse.from]; w < groupOffsets[collapse.from + 1] && isValid; ++w) {
+				uint32_t wedge = groupWedges[w];
+
+				for (uint32_t a = triangleOffsets[wedge]; a < triangleOffsets[wedge + 1]; ++a) {
+					uint32_t t = triangleList[a];
+
+					Vector3f p[3];
+					Vector3f moved[3];
+					bool     isDegenerate = false;
+
+					for (uint32_t k = 0; k < 3; ++k) {
+						uint32_t group = groups[result[t * 3 + k]];
+
+						p[k]     = groupPositions[group];
+						moved[k] = (group == collapse.from) ? groupPositions[collapse.to] : p[k];
+
+						isDegenerate |= (group == collapse.to);
+					}
+
+					if (isDegenerate) { //!< 削除される三角形
+						continue;
+					}
+
+					Vector3f before = Vector::Cross(p[1] - p[0], p[2] - p[0]);
+					Vector3f after  = Vector::Cross(moved[1] - moved[0], moved[2] - moved[0]);
+
+					if (Vector::Dot(before, after) <= 0.0f) {
+						isValid = false;
+						break;
+					}
+				}
+			}
+
+			if (!isValid) {
+				continue;
+			}
+
+			// 周辺のgroupは, このpassでは変更しない
+			for (uint32_t w = groupOffsets[collapse.from]; w < groupOffsets[collapse.from + 1]; ++w) {
+				uint32_t wedge = groupWedges[w];
+
+				for (uint32_t a = triangleOffsets[wedge]; a < triangleOffsets[wedge + 1]; ++a) {
+					uint32_t t = triangleList[a];
+
+					bool isDegenerate = false;
+					for (uint32_t k = 0; k < 3; ++k) {
+						isTouched[groups[result[t * 3 + k]]] = true;
+						isDegenerate |= (groups[result[t * 3 + k]] == collapse.to);
+					}
+
+					removedCount += isDegenerate ? 1 : 0;
+				}
+			}
+
+			// wedgeの置き換え
+			for (uint32_t w = groupOffsets[collapse.from]; w < groupOffsets[collapse.from + 1]; ++w) {
+				uint32_t wedge  = groupWedges[w];
+				uint32_t target = wedgeTargets[w - groupOffsets[collapse.from]];
+
+				for (uint32_t a = triangleOffsets[wedge]; a < triangleOffsets[wedge + 1]; ++a) {
+					uint32_t t = triangleList[a];
+
+					for (uint32_t k = 0; k < 3; ++k) {
+						if (result[t * 3 + k] == wedge) {
+							result[t * 3 + k] = target;
+						}
+					}
+				}
+			}
+
+			quadrics[collapse.to] += quadrics[collapse.from];
+
+			maxError = (std::max)(maxError, static_cast<float>(std::sqrt(collapse.cost)));
+			appliedCount++;
+		}
+
+		if (appliedCount == 0) { //!< これ以上削減できない
+			break;
+		}
+
+		// 縮退した三角形の削除
+		size_t writeIndex = 0;
+
+		for (size_t i = 0; i < result.size(); i += 3) {
+			uint32_t g0 = groups[result[i + 0]];
+			uint32_t g1 = groups[result[i + 1]];
+			uint32_t g2 = groups[result[i + 2]];
+
+			if (g0 == g1 || g1 == g2 || g2 == g0) {
+				continue;
+			}
+
+			result[writeIndex++] = result[i + 0];
+			result[writeIndex++] = result[i + 1];
+			result[writeIndex++] = result[i + 2];
+		}
+
+		result.resize(writeIndex);
+	}
+
+	if (resultError != nullptr) {
+		*resultError = maxError / scale;
+	}
+
+	return result;
+}
+
+float MeshSimplifier::GetMeshScale(const std::vector<VertexData>& vertices) {
+	if (vertices.empty()) {
+		return 0.0f;
+	}
+
+	Vector3f min = ToVector3(vertices.front().position);
+	Vector3f max = min;
+
+	for (const auto& vertex : vertices) {
+		min = { (std::min)(min.x, vertex.position.x), (std::min)(min.y, vertex.position.y), (std::min)(min.z, vertex.position.z) };
+		max = { (std::max)(max.x, vertex.position.x), (std::max)(max.y, vertex.position.y), (std::max)(max.z, vertex.position.z) };
+	}
+
+	return Vector::Length(max - min) * 0.5f;
+}
+
+void MeshSimplifier::BuildLods(MeshRawData& mesh, uint32_t lodCount, float reduction, float maxError) {
+	mesh.lods.clear();
+	mesh.lods.push_back({ 0, static_cast<uint32_t>(mesh.indices.size()), 0.0f });
+
+	float scale = GetMeshScale(mesh.vertices);
+	float error = 0.0f;
+
+	std::vector<uint32_t> current = mesh.indices;
+
+	for (uint32_t level = 1; level < lodCount; ++level) {
+		uint32_t targetIndexCount = static_cast<uint32_t>(static_cast<float>(current.size() / 3) * reduction) * 3;
+
+		float levelError = 0.0f;
+		std::vector<uint32_t> next = Simplify(mesh.vertices, current, targetIndexCount, maxError, &levelError);
+
+		if (next.empty() || static_cast<float>(next.size()) > static_cast<float>(current.size()) * kMinLodProgress) {
+			break; //!< 許容誤差内でほとんど削減できなかった
+		}
+
+		error += levelError * scale; //!< 前段からの誤差を累積
+
+		mesh.lods.push_back({ static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(next.size()), error });
+		mesh.indices.insert(mesh.indices.end(), next.begin(), next.end());
+
+		current = std::move(next);
+	}
+}
+
+void MeshSimplifier::BuildLods(ModelRawData& rawData) {
+	Parallel::For(static_cast<uint32_t>(rawData.meshs.size()), [&](uint32_t index) {
+		BuildLods(rawData.meshs[index]);
+	});
+}
\ No newline at end of file
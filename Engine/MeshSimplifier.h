@@ -0,0 +1,59 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <cstdint>
+
+// structure
+#include <ModelRawData.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshSimplifier namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace MeshSimplifier {
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const uint32_t kDefaultLodCount     = 4;     //!< LOD0を含む段数
+	static const float    kDefaultLodReduction = 0.5f;  //!< 一段あたりのindex数の比率
+	static const float    kDefaultLodMaxError  = 0.02f; //!< 一段あたりの許容誤差 (meshの半径に対する比率)
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief quadric error metricによるedge collapseで三角形を削減
+	//!
+	//! 頂点は移動せず, 既存の頂点に寄せる (vertex bufferは変更しない).
+	//! uv, normalの境目(seam)とmeshの縁(border)は, 境目に沿った方向にのみ寄せる
+	//!
+	//! @param[in]  vertices         頂点
+	//! @param[in]  indices          三角形リストのindex
+	//! @param[in]  targetIndexCount 目標のindex数
+	//! @param[in]  targetError      許容誤差 (meshの半径に対する比率)
+	//! @param[out] resultError      実際の誤差 (meshの半径に対する比率). nullptrの場合は返却しない
+	//!
+	//! @return 削減後のindexを返却. 許容誤差内で目標に届かない場合は目標より多い
+	std::vector<uint32_t> Simplify(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices, uint32_t targetIndexCount, float targetError, float* resultError = nullptr);
+
+	//! @brief 頂点の位置からmeshの半径を取得. 誤差の基準に使用
+	float GetMeshScale(const std::vector<VertexData>& vertices);
+
+	//! @brief LOD chainを作成し, mesh.indicesの後ろに追加
+	//!
+	//! @param[in,out] mesh      CPU側のmesh
+	//! @param[in]     lodCount  LOD0を含む最大段数
+	//! @param[in]     reduction 一段あたりのindex数の比率
+	//! @param[in]     maxError  一段あたりの許容誤差 (meshの半径に対する比率)
+	void BuildLods(MeshRawData& mesh, uint32_t lodCount = kDefaultLodCount, float reduction = kDefaultLodReduction, float maxError = kDefaultLodMaxError);
+
+	//! @brief model内の全meshのLOD chainを作成. meshは複数スレッドで処理
+	//!
+	//! @param[in,out] rawData CPU側のmodelData
+	void BuildLods(ModelRawData& rawData);
+
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "Meshlet.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+// engine
+#include <ScratchMemory.h>
+
+// lib
+#include <Parallel.h>
+#include <Collider.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kUnusedMark = UINT32_MAX;
+
+	//! coneの広がりがこれ以上の場合はback-face cullingできない (cos)
+	constexpr float kMinConeDot = 0.1f;
+
+	//! world行列のscaleが均一とみなす誤差
+	constexpr float kUniformScaleEpsilon = 1.0e-3f;
+
+	Vector3f ToVector3(const Vector4f& v) {
+		return { v.x, v.y, v.z };
+	}
+
+	//! @brief 三角形の範囲から境界球とnormal coneを計算
+	void ComputeBounds(const MeshRawData& mesh, Meshlet& meshlet) {
+		const uint32_t* indices = mesh.indices.data() + meshlet.indexOffset;
+
+		// 境界球. AABBの中心から最も遠い頂点まで
+		Vector3f min = ToVector3(mesh.vertices[indices[0]].position);
+		Vector3f max = min;
+
+		for (uint32_t i = 0; i < meshlet.indexCount; ++i) {
+			Vector3f p = ToVector3(mesh.vertices[indices[i]].position);
+
+			min = { (std::min)(min.x, p.x), (std::min)(min.y, p.y), (std::min)(min.z, p.z) };
+			max = { (std::max)(max.x, p.x), (std::max)(max.y, p.y), (std::max)(max.z, p.z) };
+		}
+
+		meshlet.center = (min + max) * 0.5f;
+		meshlet.radius = 0.0f;
+
+		for (uint32_t i = 0; i < meshlet.indexCount; ++i) {
+			Vector3f p = ToVector3(mesh.vertices[indices[i]].position);
+			meshlet.radius = (std::max)(meshlet.radius, Vector::Length(p - meshlet.center));
+		}
+
+		// normal cone. 各三角形の面法線 (正規化) の平均を軸とする
+		ScratchMemory::Vector<Vector3f> normals;
+		normals.reserve(meshlet.indexCount / 3);
+
+		Vector3f axis = origin;
+
+		for (uint32_t i = 0; i < meshlet.indexCount; i += 3) {
+			Vector3f p0 = ToVector3(mesh.vertices[indices[i + 0]].position);
+			Vector3f p1 = ToVector3(mesh.vertices[indices[i + 1]].position);
+			Vector3f p2 = ToVector3(mesh.vertices[indices[i + 2]].position);
+
+			Vector3f normal = Vector::Cross(p1 - p0, p2 - p0);
+			float    length = Vector::Length(normal);
+
+			if (length == 0.0f) { //!< 縮退した三角形
+				continue;
+			}
+
+			normal *= 1.0f / length;
+
+			normals.push_back(normal);
+			axis += normal;
+		}
+
+		meshlet.coneAxis   = origin;
+		meshlet.coneCutoff = 1.0f;
+
+		float axisLength = Vector::Length(axis);
+
+		if (normals.empty() || axisLength == 0.0f) {
+			return;
+		}
+
+		axis *= 1.0f / axisLength;
+
+		float minDot = 1.0f;
+		for (const auto& normal : normals) {
+			minDot = (std::min)(minDot, Vector::Dot(axis, normal));
+		}
+
+		meshlet.coneAxis = axis;
+
+		if (minDot > kMinConeDot) {
+			meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+		}
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshletMethods methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<Meshlet> MeshletMethods::Build(const MeshRawData& mesh, uint32_t maxVertices, uint32_t maxTriangles) {
+	assert(maxVertices >= 3 && maxTriangles >= 1);
+
+	std::vector<Meshlet> result;
+
+	// LODがある場合はLOD0の範囲のみ
+	uint32_t triangleCount = mesh.lods.empty()
+		? static_cast<uint32_t>(mesh.indices.size() / 3)
+		: mesh.lods.front().indexCount / 3;
+
+	assert(mesh.lods.empty() || mesh.lods.front().indexOffset == 0); //!< LOD0は先頭
+
+	if (triangleCount == 0) {
+		return result;
+	}
+
+	ScratchMemory::Vector<uint32_t> marks(mesh.vertices.size(), kUnusedMark); //!< 頂点を最後に使ったmeshlet番号
+
+	Meshlet meshlet = {};
+
+	auto pushMeshlet = [&]() {
+		ComputeBounds(mesh, meshlet);
+		result.push_back(meshlet);
+
+		meshlet = {};
+		meshlet.indexOffset = result.back().indexOffset + result.back().indexCount;
+	};
+
+	for (uint32_t t = 0; t < triangleCount; ++t) {
+		uint32_t a = mesh.indices[t * 3 + 0];
+		uint32_t b = mesh.indices[t * 3 + 1];
+		uint32_t c = mesh.indices[t * 3 + 2];
+
+		uint32_t id = static_cast<uint32_t>(result.size());
+
+		// 追加される頂点数
+		uint32_t newCount
+			= (marks[a] != id ? 1 : 0)
+			+ (marks[b] != id && b != a ? 1 : 0)
+			+ (marks[c] != id && c != a && c != b ? 1 : 0);
+
+		if (meshlet.vertexCount + newCount > maxVertices || meshlet.indexCount / 3 + 1 > maxTriangles) {
+			pushMeshlet();
+
+			id = static_cast<uint32_t>(result.size());
+			newCount = 1 + (b != a ? 1 : 0) + (c != a && c != b ? 1 : 0);
+		}
+
+		marks[a] = id;
+		marks[b] = id;
+		marks[c] = id;
+
+		meshlet.vertexCount += newCount;
+		meshlet.indexCount  += 3;
+	}
+
+	pushMeshlet();
+
+	return result;
+}
+
+void MeshletMethods::Build(ModelRawData& rawData) {
+	Parallel::For(static_cast<uint32_t>(rawData.meshs.size()), [&](uint32_t index) {
+		rawData.meshs[index].meshlets = Build(rawData.meshs[index]);
+	});
+}
+
+void MeshletMethods::Cull(const std::vector<Meshlet>& meshlets, const Matrix4x4& world, const Matrix4x4& viewProj, const Vector3f& cameraPosition, std::vector<DrawRange>& ranges) {
+	ranges.clear();
+
+	Frustum frustum = Collider::MakeFrustum(viewProj);
+
+	// world行列のscale
+	Vector3f scale = {
+		Vector::Length({ world.m[0][0], world.m[0][1], world.m[0][2] }),
+		Vector::Length({ world.m[1][0], world.m[1][1], world.m[1][2] }),
+		Vector::Length({ world.m[2][0], world.m[2][1], world.m[2][2] }),
+	};
+
+	float maxScale = (std::max)({ scale.x, scale.y, scale.z });
+	float minScale = (std::min)({ scale.x, scale.y, scale.z });
+
+	// 不均一なscaleではconeが歪むのでback-face cullingしない
+	bool isUniformScale = (maxScale - minScale) <= maxScale * kUniformScaleEpsilon && minScale != 0.0f;
+
+	for (const auto& meshlet : meshlets) {
+		Sphere sphere = {};
+		sphere.center = Matrix::Transform(meshlet.center, world);
+		sphere.radius = meshlet.radius * maxScale;
+
+		// 視錐台culling
+		if (!Collider::SphereToFrustum(sphere, frustum)) {
+			continue;
+		}
+
+		// back-face culling. カメラから見て全ての三角形が裏向き
+		if (isUniformScale && meshlet.coneCutoff < 1.0f) {
+			Vector3f axis = {
+				meshlet.coneAxis.x * world.m[0][0] + meshlet.coneAxis.y * world.m[1][0] + meshlet.coneAxis.z * world.m[2][0],
+				meshlet.coneAxis.x * world.m[0][1] + meshlet.coneAxis.y * world.m[1][1] + meshlet.coneAxis.z * world.m[2][1],
+				meshlet.coneAxis.x * world.m[0][2] + meshlet.coneAxis.y * world.m[1][2] + meshlet.coneAxis.z * world.m[2][2],
+			};
+			axis *= 1.0f / maxScale;
+
+			Vector3f direction = sphere.center - cameraPosition;
+
+			if (Vector::Dot(direction, axis) >= meshlet.coneCutoff * Vector::Length(direction) + sphere.radius) {
+				continue;
+			}
+		}
+
+		// 隣接していれば結合
+		if (!ranges.empty() && ranges.back().indexOffset + ranges.back().indexCount == meshlet.indexOffset) {
+			ranges.back().indexCount += meshlet.indexCount;
+
+		} else {
+			ranges.push_back({ meshlet.indexOffset, meshlet.indexCount });
+		}
+	}
+}
\ No newline at end of file
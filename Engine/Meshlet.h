@@ -0,0 +1,62 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <cstdint>
+
+// structure
+#include <ModelRawData.h>
+
+// Geometry
+#include <Matrix4x4.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshletMethods namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace MeshletMethods {
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const uint32_t kMaxVertices  = 64;
+	static const uint32_t kMaxTriangles = 124;
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// DrawRange structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct DrawRange { //!< DrawIndexedInstancedに渡すindexの範囲
+		uint32_t indexOffset;
+		uint32_t indexCount;
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief index順に三角形を走査し, 上限を超えたところでmeshletを区切る
+	//!
+	//! @param[in] mesh         CPU側のmesh. index順は変更しない. LODがある場合はLOD0のみ
+	//! @param[in] maxVertices  meshlet一つあたりの最大頂点数
+	//! @param[in] maxTriangles meshlet一つあたりの最大三角形数
+	//!
+	//! @return meshletを返却. 同じ入力に対して常に同じ結果
+	std::vector<Meshlet> Build(const MeshRawData& mesh, uint32_t maxVertices = kMaxVertices, uint32_t maxTriangles = kMaxTriangles);
+
+	//! @brief model内の全meshのmeshletを作成. meshは複数スレッドで処理
+	//!
+	//! @param[in,out] rawData CPU側のmodelData
+	void Build(ModelRawData& rawData);
+
+	//! @brief 視錐台の外側, 全ての三角形が裏向きのmeshletを除き, 描画範囲を作成
+	//!
+	//! @param[in]  meshlets       meshlet
+	//! @param[in]  world          world行列
+	//! @param[in]  viewProj       viewProjection行列. world行列を含めない
+	//! @param[in]  cameraPosition world空間のカメラ位置
+	//! @param[out] ranges         描画範囲. 隣接する範囲は結合される
+	void Cull(const std::vector<Meshlet>& meshlets, const Matrix4x4& world, const Matrix4x4& viewProj, const Vector3f& cameraPosition, std::vector<DrawRange>& ranges);
+
+}
\ No newline at end of file
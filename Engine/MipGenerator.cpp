@@ -0,0 +1,525 @@
+#include "MipGenerator.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cassert>
+#include <numbers>
+#include <functional>
+
+// simd
+#include <emmintrin.h>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr double kKaiserWidth = 3.0; //!< 縮小後のtexel単位の半径
+	constexpr double kKaiserAlpha = 4.0;
+
+	constexpr uint32_t kBucketCount       = 4096;      //!< linear -> sRGBの初期値のtable数
+	constexpr uint32_t kMinParallelPixels = 128 * 128; //!< これ未満のlevelはスレッドを立てない
+	constexpr uint32_t kBandPerThread     = 4;         //!< 1スレッドあたりの行の分割数
+	constexpr float    kMaxAlphaScale     = 16.0f;
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ColorTable structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ColorTable {
+		float   toLinear[256];         //!< sRGB 8bit -> linear
+		float   thresholds[256];       //!< thresholds[c] 以上のlinearはsRGB c以上. [0]は未使用
+		uint8_t buckets[kBucketCount]; //!< linearを等分した区間の先頭のsRGB
+	};
+
+	double SrgbToLinear(double value) {
+		return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+	}
+
+	const ColorTable& GetColorTable() {
+		static const ColorTable table = []() {
+			ColorTable result = {};
+
+			for (uint32_t i = 0; i < 256; ++i) {
+				result.toLinear[i] = static_cast<float>(SrgbToLinear(i / 255.0));
+			}
+
+			// sRGBの値が (c - 0.5) / 255 となるlinear. 四捨五入の境界
+			for (uint32_t c = 1; c < 256; ++c) {
+				result.thresholds[c] = static_cast<float>(SrgbToLinear((c - 0.5) / 255.0));
+			}
+
+			uint32_t code = 0;
+
+			for (uint32_t b = 0; b < kBucketCount; ++b) {
+				float value = static_cast<float>(b) / kBucketCount;
+
+				while (code < 255 && value >= result.thresholds[code + 1]) {
+					++code;
+				}
+
+				result.buckets[b] = static_cast<uint8_t>(code);
+			}
+
+			return result;
+		}();
+
+		return table;
+	}
+
+	//! @brief [0, 1] のlinearを四捨五入したsRGB 8bitに変換
+	uint8_t LinearToSrgb(const ColorTable& table, float value) {
+		uint32_t code = table.buckets[(std::min)(static_cast<uint32_t>(value * kBucketCount), kBucketCount - 1)];
+
+		// 一つの区間に複数のsRGBが含まれる場合
+		while (code < 255 && value >= table.thresholds[code + 1]) {
+			++code;
+		}
+
+		return static_cast<uint8_t>(code);
+	}
+
+	//=========================================================================================
+	// filter
+	//=========================================================================================
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// FilterTap structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct FilterTap {
+		uint32_t index;
+		float    weight;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// FilterTaps structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct FilterTaps { //!< 縮小後のindex毎に, 参照する縮小前のindexと重み
+		std::vector<uint32_t>  offsets; //!< taps[offsets[i], offsets[i + 1]) がindex iの重み
+		std::vector<FilterTap> taps;
+	};
+
+	//! @brief 0次の変形ベッセル関数
+	double BesselI0(double x) {
+		double sum  = 1.0;
+		double term = 1.0;
+
+		for (uint32_t k = 1; k < 32; ++k) {
+			term *= (x * 0.5 / k) * (x * 0.5 / k);
+			sum  += term;
+
+			if (term < sum * 1e-12) {
+				break;
+			}
+		}
+
+		return sum;
+	}
+
+	double Sinc(double x) {
+		if (std::abs(x) < 1e-9) {
+			return 1.0;
+		}
+
+		return std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+	}
+
+	//! @brief [-1, 1] のKaiser窓
+	double Kaiser(double x) {
+		if (std::abs(x) >= 1.0) {
+			return 0.0;
+		}
+
+		return BesselI0(kKaiserAlpha * std::sqrt(1.0 - x * x)) / BesselI0(kKaiserAlpha);
+	}
+
+	FilterTaps BuildTaps(uint32_t srcSize, uint32_t dstSize, MipFilter filter) {
+		FilterTaps result;
+		result.offsets.reserve(dstSize + 1);
+
+		double scale = static_cast<double>(srcSize) / dstSize;
+
+		std::vector<FilterTap> taps;
+
+		for (uint32_t x = 0; x < dstSize; ++x) {
+			taps.clear();
+
+			if (filter == MIP_FILTER_BOX || scale <= 1.0) { //!< 縮小しない軸は元のまま
+				// 縮小後のtexelが覆う範囲と重なる長さ
+				double begin = x * scale;
+				double end   = (x + 1) * scale;
+
+				// 誤差でendが縮小前の大きさを超えても範囲内に収める
+				int32_t last = (std::min)(static_cast<int32_t>(std::ceil(end)), static_cast<int32_t>(srcSize));
+
+				for (int32_t i = static_cast<int32_t>(std::floor(begin)); i < last; ++i) {
+					double weight = (std::min)(end, i + 1.0) - (std::max)(begin, static_cast<double>(i));
+					taps.push_back({ static_cast<uint32_t>(i), static_cast<float>(weight) });
+				}
+
+			} else {
+				double center = (x + 0.5) * scale;
+				double radius = kKaiserWidth * scale;
+
+				for (int32_t i = static_cast<int32_t>(std::floor(center - radius)); i <= static_cast<int32_t>(std::ceil(center + radius)); ++i) {
+					double distance = ((i + 0.5) - center) / scale; //!< 縮小後のtexel単位
+					double weight   = Sinc(distance) * Kaiser(distance / kKaiserWidth);
+
+					if (std::abs(weight) < 1e-6) {
+						continue;
+					}
+
+					// 範囲外は端のtexelを使う
+					uint32_t index = static_cast<uint32_t>(std::clamp(i, 0, static_cast<int32_t>(srcSize) - 1));
+					taps.push_back({ index, static_cast<float>(weight) });
+				}
+			}
+
+			// 重みの合計を1にする
+			double sum = 0.0;
+
+			for (const auto& tap : taps) {
+				sum += tap.weight;
+			}
+
+			result.offsets.push_back(static_cast<uint32_t>(result.taps.size()));
+
+			for (const auto& tap : taps) {
+				result.taps.push_back({ tap.index, static_cast<float>(tap.weight / sum) });
+			}
+		}
+
+		result.offsets.push_back(static_cast<uint32_t>(result.taps.size()));
+
+		return result;
+	}
+
+	//=========================================================================================
+	// level
+	//=========================================================================================
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// LevelSource structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct LevelSource { //!< 縮小元. level0は8bit, それ以降は前のlevelのfloat
+		const MipImage* image;
+		const float*    linear; //!< nullptrの場合はimageから変換
+		bool            isSrgb;
+
+		uint32_t GetWidth() const { return image->width; }
+		uint32_t GetHeight() const { return image->height; }
+
+		//! @brief 一行をlinearのfloat RGBAで取得
+		//!
+		//! @param[in] y      行
+		//! @param[in] buffer 変換が必要な場合の書き込み先. width * 4 必要
+		const float* GetRow(uint32_t y, float* buffer, const ColorTable& table) const {
+			if (linear != nullptr) {
+				return linear + static_cast<size_t>(y) * image->width * 4;
+			}
+
+			const uint8_t* row = image->pixels + image->rowPitch * y;
+
+			const __m128 kInv255 = _mm_set1_ps(1.0f / 255.0f);
+
+			for (uint32_t x = 0; x < image->width; ++x) {
+				const uint8_t* pixel = row + x * 4;
+
+				__m128 value;
+
+				if (isSrgb) {
+					value = _mm_setr_ps(table.toLinear[pixel[0]], table.toLinear[pixel[1]], table.toLinear[pixel[2]], pixel[3] * (1.0f / 255.0f));
+
+				} else {
+					int32_t bytes;
+					std::memcpy(&bytes, pixel, sizeof(bytes));
+
+					__m128i packed = _mm_cvtsi32_si128(bytes);
+					packed = _mm_unpacklo_epi16(_mm_unpacklo_epi8(packed, _mm_setzero_si128()), _mm_setzero_si128());
+					value  = _mm_mul_ps(_mm_cvtepi32_ps(packed), kInv255);
+				}
+
+				_mm_storeu_ps(buffer + x * 4, value);
+			}
+
+			return buffer;
+		}
+	};
+
+	//! @brief 行を分割して並列に処理
+	template <typename F>
+	void ForBands(uint32_t rowCount, uint32_t pixelCount, uint32_t threadCount, F&& function) {
+		if (pixelCount < kMinParallelPixels) {
+			threadCount = 1;
+		}
+
+		uint32_t bandCount = (std::min)(rowCount, threadCount * kBandPerThread);
+		uint32_t bandSize  = (rowCount + bandCount - 1) / bandCount;
+
+		Parallel::For(bandCount, [&](uint32_t band) {
+			uint32_t begin = band * bandSize;
+			uint32_t end   = (std::min)(begin + bandSize, rowCount);
+
+			if (begin < end) {
+				function(begin, end);
+			}
+		}, threadCount);
+	}
+
+	//! @brief sourceを縦, 横の順に縮小してlinearのfloat RGBAを生成
+	std::vector<float> Resample(const LevelSource& source, uint32_t width, uint32_t height, MipFilter filter, uint32_t threadCount) {
+		const ColorTable& table = GetColorTable();
+
+		FilterTaps horizontal = BuildTaps(source.GetWidth(), width, filter);
+		FilterTaps vertical   = BuildTaps(source.GetHeight(), height, filter);
+
+		std::vector<float> result(static_cast<size_t>(width) * height * 4);
+
+		uint32_t srcWidth = source.GetWidth();
+
+		ForBands(height, width * height, threadCount, [&](uint32_t begin, uint32_t end) {
+			std::vector<float> rowBuffer(static_cast<size_t>(srcWidth) * 4);
+			std::vector<float> accumulate(static_cast<size_t>(srcWidth) * 4);
+
+			const __m128 kZero = _mm_setzero_ps();
+			const __m128 kOne  = _mm_set1_ps(1.0f);
+
+			for (uint32_t y = begin; y < end; ++y) {
+				// 縦方向. 縮小前の幅のまま重みを付けて加算
+				std::fill(accumulate.begin(), accumulate.end(), 0.0f);
+
+				for (uint32_t t = vertical.offsets[y]; t < vertical.offsets[y + 1]; ++t) {
+					const float* row    = source.GetRow(vertical.taps[t].index, rowBuffer.data(), table);
+					__m128       weight = _mm_set1_ps(vertical.taps[t].weight);
+
+					for (uint32_t x = 0; x < srcWidth; ++x) {
+						__m128 sum = _mm_loadu_ps(accumulate.data() + x * 4);
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(row + x * 4), weight));
+						_mm_storeu_ps(accumulate.data() + x * 4, sum);
+					}
+				}
+
+				// 横方向
+				float* dst = result.data() + static_cast<size_t>(y) * width * 4;
+
+				for (uint32_t x = 0; x < width; ++x) {
+					__m128 sum = kZero;
+
+					for (uint32_t t = horizontal.offsets[x]; t < horizontal.offsets[x + 1]; ++t) {
+						const FilterTap& tap = horizontal.taps[t];
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(accumulate.data() + tap.index * 4), _mm_set1_ps(tap.weight)));
+					}
+
+					// Kaiserの負の重みによるはみ出しを除く
+					_mm_storeu_ps(dst + x * 4, _mm_min_ps(_mm_max_ps(sum, kZero), kOne));
+				}
+			}
+		});
+
+		return result;
+	}
+
+	//! @brief alpha testの通過率がtargetCoverageになるalphaの倍率を計算
+	float ComputeAlphaScale(const std::vector<float>& linear, float targetCoverage, float alphaReference) {
+		size_t pixelCount = linear.size() / 4;
+
+		std::vector<float> alphas(pixelCount);
+
+		for (size_t i = 0; i < pixelCount; ++i) {
+			alphas[i] = linear[i * 4 + 3];
+		}
+
+		size_t passCount = static_cast<size_t>(std::lround(static_cast<double>(targetCoverage) * pixelCount));
+
+		if (passCount == 0 || passCount >= pixelCount) { //!< 全て通過, 全て棄却は倍率で変わらない
+			return 1.0f;
+		}
+
+		// 降順でpassCount番目とその次の間を閾値にする
+		auto greater = std::greater<float>();
+
+		std::nth_element(alphas.begin(), alphas.begin() + (passCount - 1), alphas.end(), greater);
+		float upper = alphas[passCount - 1];
+
+		float lower = *std::max_element(alphas.begin() + passCount, alphas.end());
+
+		float threshold = (upper + lower) * 0.5f;
+
+		if (threshold <= 0.0f) {
+			return kMaxAlphaScale;
+		}
+
+		return (std::min)(alphaReference / threshold, kMaxAlphaScale);
+	}
+
+	//! @brief linearのfloat RGBAを8bitに量子化
+	void Quantize(const std::vector<float>& linear, const MipImage& image, bool isSrgb, float alphaScale, uint32_t threadCount) {
+		const ColorTable& table = GetColorTable();
+
+		ForBands(image.height, image.width * image.height, threadCount, [&](uint32_t begin, uint32_t end) {
+			const __m128 kZero  = _mm_setzero_ps();
+			const __m128 kOne   = _mm_set1_ps(1.0f);
+			const __m128 kScale = _mm_setr_ps(1.0f, 1.0f, 1.0f, alphaScale);
+			const __m128 k255   = _mm_set1_ps(255.0f);
+			const __m128 kHalf  = _mm_set1_ps(0.5f);
+
+			for (uint32_t y = begin; y < end; ++y) {
+				const float* src = linear.data() + static_cast<size_t>(y) * image.width * 4;
+				uint8_t*     dst = image.pixels + image.rowPitch * y;
+
+				for (uint32_t x = 0; x < image.width; ++x) {
+					__m128 value = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + x * 4), kScale), kZero), kOne);
+
+					// linearのまま四捨五入
+					__m128i packed = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, k255), kHalf));
+					packed = _mm_packs_epi32(packed, packed);
+					packed = _mm_packus_epi16(packed, packed);
+
+					int32_t bytes = _mm_cvtsi128_si32(packed);
+					std::memcpy(dst + x * 4, &bytes, sizeof(bytes));
+
+					if (isSrgb) { //!< RGBはsRGBの四捨五入で上書き
+						alignas(16) float channels[4];
+						_mm_store_ps(channels, value);
+
+						dst[x * 4 + 0] = LinearToSrgb(table, channels[0]);
+						dst[x * 4 + 1] = LinearToSrgb(table, channels[1]);
+						dst[x * 4 + 2] = LinearToSrgb(table, channels[2]);
+					}
+				}
+			}
+		});
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MipGenerator methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t MipGenerator::GetLevelCount(uint32_t width, uint32_t height) {
+	uint32_t result = 1;
+
+	while (width > 1 || height > 1) {
+		width  = (std::max)(width / 2, 1u);
+		height = (std::max)(height / 2, 1u);
+		++result;
+	}
+
+	return result;
+}
+
+MipChain MipGenerator::CreateChain(uint32_t width, uint32_t height, uint32_t levelCount) {
+	if (levelCount == 0) {
+		levelCount = GetLevelCount(width, height);
+	}
+
+	MipChain result;
+
+	size_t byteSize = 0;
+
+	for (uint32_t level = 0; level < levelCount; ++level) {
+		MipImage image = {};
+		image.width    = width;
+		image.height   = height;
+		image.rowPitch = static_cast<size_t>(width) * 4;
+
+		result.levels.push_back(image);
+		byteSize += image.rowPitch * height;
+
+		width  = (std::max)(width / 2, 1u);
+		height = (std::max)(height / 2, 1u);
+	}
+
+	result.pixels.resize(byteSize);
+
+	size_t offset = 0;
+
+	for (auto& image : result.levels) {
+		image.pixels = result.pixels.data() + offset;
+		offset += image.rowPitch * image.height;
+	}
+
+	return result;
+}
+
+void MipGenerator::Generate(const MipImage* levels, uint32_t levelCount, const MipOptions& options, uint32_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = Parallel::GetThreadCount();
+	}
+
+	float targetCoverage = 0.0f;
+
+	if (options.isPreserveAlphaCoverage) {
+		targetCoverage = ComputeAlphaCoverage(levels[0], options.alphaReference);
+	}
+
+	std::vector<float> linear; //!< 前のlevelの量子化前の値
+
+	for (uint32_t level = 1; level < levelCount; ++level) {
+		const MipImage& image = levels[level];
+
+		assert(image.width == (std::max)(levels[level - 1].width / 2, 1u));   //!< 前のlevelの半分ではない
+		assert(image.height == (std::max)(levels[level - 1].height / 2, 1u));
+
+		LevelSource source = {};
+		source.image  = &levels[level - 1];
+		source.linear = linear.empty() ? nullptr : linear.data();
+		source.isSrgb = options.isSrgb;
+
+		linear = Resample(source, image.width, image.height, options.filter, threadCount);
+
+		float alphaScale = 1.0f;
+
+		if (options.isPreserveAlphaCoverage) {
+			alphaScale = ComputeAlphaScale(linear, targetCoverage, options.alphaReference);
+		}
+
+		Quantize(linear, image, options.isSrgb, alphaScale, threadCount);
+	}
+}
+
+void MipGenerator::Generate(MipChain& chain, const MipOptions& options, uint32_t threadCount) {
+	Generate(chain.levels.data(), static_cast<uint32_t>(chain.levels.size()), options, threadCount);
+}
+
+void MipGenerator::Generate(std::vector<MipChain>& chains, const MipOptions& options, uint32_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = Parallel::GetThreadCount();
+	}
+
+	if (chains.size() < threadCount) { //!< textureが少ない場合はtexture内で分割
+		for (auto& chain : chains) {
+			Generate(chain, options, threadCount);
+		}
+
+		return;
+	}
+
+	Parallel::For(static_cast<uint32_t>(chains.size()), [&](uint32_t index) {
+		Generate(chains[index], options, 1);
+	}, threadCount);
+}
+
+float MipGenerator::ComputeAlphaCoverage(const MipImage& image, float alphaReference) {
+	uint64_t passCount = 0;
+
+	for (uint32_t y = 0; y < image.height; ++y) {
+		const uint8_t* row = image.pixels + image.rowPitch * y;
+
+		for (uint32_t x = 0; x < image.width; ++x) {
+			if (row[x * 4 + 3] / 255.0f > alphaReference) {
+				++passCount;
+			}
+		}
+	}
+
+	return static_cast<float>(static_cast<double>(passCount) / (static_cast<uint64_t>(image.width) * image.height));
+}
\ No newline at end of file
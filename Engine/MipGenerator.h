@@ -0,0 +1,89 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//-----------------------------------------------------------------------------------------
+// enum
+//-----------------------------------------------------------------------------------------
+enum MipFilter {
+	MIP_FILTER_BOX,    //!< 面積の重み. 高速
+	MIP_FILTER_KAISER, //!< Kaiser窓のsinc. 縮小後もぼけにくい
+
+	kMipFilterCount
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MipImage structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct MipImage { //!< 8bit RGBA (BGRAも可) の一枚
+	uint8_t* pixels;
+	uint32_t width;
+	uint32_t height;
+	size_t   rowPitch;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MipOptions structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct MipOptions {
+	MipFilter filter                  = MIP_FILTER_BOX;
+	bool      isSrgb                  = true;  //!< RGBをsRGBからlinearに変換して縮小する. alphaは常にlinear
+	bool      isPreserveAlphaCoverage = false; //!< alpha testの通過率を各mipで保つ
+	float     alphaReference          = 0.5f;  //!< alpha testの閾値
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MipChain structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct MipChain { //!< CreateChainで確保したmipmap. levels[0]が元画像
+	std::vector<uint8_t>  pixels;
+	std::vector<MipImage> levels;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MipGenerator namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace MipGenerator {
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 1x1までのmip数を取得
+	uint32_t GetLevelCount(uint32_t width, uint32_t height);
+
+	//! @brief mipmapの領域を確保. 行は詰めて配置される
+	//!
+	//! @param[in] levelCount mip数. 0の場合は1x1まで
+	MipChain CreateChain(uint32_t width, uint32_t height, uint32_t levelCount = 0);
+
+	//! @brief levels[0]からlevels[1, levelCount)を生成 (SSE2のみ. AVX2, NEONの経路はない)
+	//!
+	//! 縮小はlinearのfloatで行い, 次のlevelは量子化前のfloatから生成する.
+	//! 各levelの中で行を分割して並列に処理する
+	//!
+	//! @param[in] levels      各levelの画像. 幅, 高さは前のlevelの半分 (最低1)
+	//! @param[in] levelCount  mip数
+	//! @param[in] options     filter, 色空間
+	//! @param[in] threadCount 使用するスレッド数. 0の場合はParallel::GetThreadCount()
+	void Generate(const MipImage* levels, uint32_t levelCount, const MipOptions& options, uint32_t threadCount = 0);
+
+	//! @brief MipChainのlevels[0]から残りを生成
+	void Generate(MipChain& chain, const MipOptions& options, uint32_t threadCount = 0);
+
+	//! @brief 複数のMipChainをtexture単位で並列に生成
+	void Generate(std::vector<MipChain>& chains, const MipOptions& options, uint32_t threadCount = 0);
+
+	//! @brief alpha testを通過するpixelの割合
+	//!
+	//! @param[in] image          画像
+	//! @param[in] alphaReference alpha testの閾値
+	float ComputeAlphaCoverage(const MipImage& image, float alphaReference);
+
+}
\ No newline at end of file
@@ -3,342 +3,536 @@
 //-----------------------------------------------------------------------------------------
 // include
 //-----------------------------------------------------------------------------------------
+// c++
+#include <filesystem>
+#include <cctype>
+
+// engine
+#include <DirectXCommon.h>
+#include <ObjLoader.h>
+#include <GltfLoader.h>
+#include <MeshCache.h>
+#include <MeshOptimizer.h>
+#include <Meshlet.h>
+#include <MeshSimplifier.h>
+#include <VertexCompressor.h>
+#include <MeshBounds.h>
+
+// lib
+#include <Environment.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief 全meshで共有するGPUバッファを生成. meshsの範囲は設定済みであること
+	//! 
+	//! meshは書き換えないのでDEFAULT heapに置き, 書き込み後にUploadResourcesで転送する
+	void CreateResources(ModelData& modelData) {
+		uint32_t vertexCount        = 0;
+		uint32_t indexCount         = 0;
+		uint32_t maxMeshVertexCount = 0; //!< indexはmesh内の番号なので, 16bitで足りるかはmesh毎の頂点数で決まる
+
+		for (const auto& mesh : modelData.meshs) {
+			vertexCount        = (std::max)(vertexCount, mesh.baseVertex + mesh.vertexCount);
+			indexCount         = (std::max)(indexCount, mesh.startIndex + mesh.indexCount);
+			maxMeshVertexCount = (std::max)(maxMeshVertexCount, mesh.vertexCount);
+		}
+
+		switch (modelData.vertexFormat) {
+			case VERTEX_FORMAT_DEFAULT:
+				modelData.vertexResource
+					= std::make_unique<DxObject::BufferResource<VertexData>>(MyEngine::GetDevicesObj(), vertexCount, BUFFER_USAGE_STATIC);
+				break;
+
+			case VERTEX_FORMAT_PACKED:
+				modelData.packedVertexResource
+					= std::make_unique<DxObject::BufferResource<VertexDataPacked>>(MyEngine::GetDevicesObj(), vertexCount, BUFFER_USAGE_STATIC);
+				break;
+
+			case VERTEX_FORMAT_QUANTIZED:
+				modelData.quantizedVertexResource
+					= std::make_unique<DxObject::BufferResource<VertexDataQuantized>>(MyEngine::GetDevicesObj(), vertexCount, BUFFER_USAGE_STATIC);
+				break;
+
+			default:
+				assert(false); //!< 未対応のvertexFormat
+				break;
+		}
+
+		modelData.indexResource
+			= std::make_unique<DxObject::IndexBufferResource>(MyEngine::GetDevicesObj(), indexCount, maxMeshVertexCount, BUFFER_USAGE_STATIC);
+	}
+
+	//! @brief meshの頂点をvertexFormatに変換し, indexと共に共有バッファの範囲へ書き込む
+	void WriteMesh(ModelData& modelData, MeshData& meshData, const VertexData* vertices, const uint32_t* indices) {
+		switch (modelData.vertexFormat) {
+			case VERTEX_FORMAT_DEFAULT:
+				modelData.vertexResource->Memcpy(meshData.baseVertex, vertices, meshData.vertexCount);
+				break;
+
+			case VERTEX_FORMAT_PACKED:
+				{
+					std::vector<VertexDataPacked> packed(meshData.vertexCount);
+					VertexCompressor::Encode(vertices, meshData.vertexCount, packed.data());
+
+					modelData.packedVertexResource->Memcpy(meshData.baseVertex, packed.data(), meshData.vertexCount);
+				}
+				break;
+
+			case VERTEX_FORMAT_QUANTIZED:
+				{
+					// 量子化の範囲はmesh毎. 描画時にSetVertexQuantizationで設定する
+					meshData.quantization = VertexCompressor::ComputeQuantization(vertices, meshData.vertexCount);
+
+					std::vector<VertexDataQuantized> quantized(meshData.vertexCount);
+					VertexCompressor::Encode(vertices, meshData.vertexCount, meshData.quantization, quantized.data());
+
+					modelData.quantizedVertexResource->Memcpy(meshData.baseVertex, quantized.data(), meshData.vertexCount);
+				}
+				break;
+
+			default:
+				assert(false); //!< 未対応のvertexFormat
+				break;
+		}
+
+		modelData.indexResource->Memcpy(meshData.startIndex, indices, meshData.indexCount);
+	}
+
+	//! @brief 書き込み済みのstaging bufferからGPUバッファへの転送を積む
+	void UploadResources(ModelData& modelData) {
+		DirectXCommon* dxCommon = MyEngine::GetDxCommon();
+
+		if (modelData.vertexResource != nullptr) {
+			dxCommon->UploadBuffer(modelData.vertexResource.get());
+		}
+
+		if (modelData.packedVertexResource != nullptr) {
+			dxCommon->UploadBuffer(modelData.packedVertexResource.get());
+		}
+
+		if (modelData.quantizedVertexResource != nullptr) {
+			dxCommon->UploadBuffer(modelData.quantizedVertexResource.get());
+		}
+
+		dxCommon->UploadBuffer(modelData.indexResource.get());
+	}
+
+	//! @brief objファイルを読み込みLOD作成, 最適化してcookedファイルを書き出す. parseに失敗した場合は書き出さない
+	ModelRawData CookRawData(const std::string& directoryPath, const std::string& filename, const std::string& cookedFilePath, uint64_t objHash) {
+		ModelRawData rawData = ModelMethods::ParseObjFile(directoryPath, filename, PARSE_PARALLEL);
+
+		if (!rawData.error.empty()) {
+			return rawData;
+		}
+
+		MeshSimplifier::BuildLods(rawData);
+		MeshOptimizer::Optimize(rawData); //!< cookedファイルには最適化済みのmeshを保存
+		MeshletMethods::Build(rawData);
+
+		uint64_t mtlHash = rawData.mtlFilename.empty()
+			? 0 : MeshCache::HashFile(directoryPath + "/" + rawData.mtlFilename);
+
+		MeshCache::Write(cookedFilePath, rawData, objHash, mtlHash);
+
+		return rawData;
+	}
+
+	//! @brief cookedファイルからmesh毎の境界とmodel全体の境界を読み込む. 境界を持たないcookedファイルは頂点から計算する
+	//!
+	//! @param[in]  cookedFile Open済みのcookedファイル
+	//! @param[out] aabbs      meshのAABB. GetMeshsと同じ順
+	//! @param[out] spheres    meshの境界球
+	//! @param[out] aabb       model全体のAABB
+	//! @param[out] sphere     model全体の境界球
+	void ReadCookedBounds(const MeshCache::CookedFile& cookedFile, std::vector<AABB>& aabbs, std::vector<Sphere>& spheres, AABB& aabb, Sphere& sphere) {
+		const std::vector<MeshCache::MeshView>& meshs = cookedFile.GetMeshs();
+
+		aabbs.resize(meshs.size());
+		spheres.resize(meshs.size());
+
+		for (size_t i = 0; i < meshs.size(); ++i) {
+			if (meshs[i].aabb != nullptr) {
+				aabbs[i]   = *meshs[i].aabb;
+				spheres[i] = *meshs[i].sphere;
+
+			} else {
+				aabbs[i]   = MeshBounds::ComputeAABB(meshs[i].vertices, meshs[i].vertexCount);
+				spheres[i] = MeshBounds::ComputeSphere(meshs[i].vertices, meshs[i].vertexCount, aabbs[i]);
+			}
+		}
+
+		MeshBounds::Union(aabbs.data(), spheres.data(), static_cast<uint32_t>(meshs.size()), aabb, sphere);
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Model class
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//=========================================================================================
+// static variables
+//=========================================================================================
+
+const float Model::kDefaultLodPixelError = 1.0f;
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Model Methods
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-void Model::Init(const std::string& directoryPath, const std::string& filename) {
-	modelData_ = ModelMethods::LoadObjFile(directoryPath, filename);
+void Model::Init(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat) {
+	if (ModelMethods::IsGlbFile(filename)) { //!< glbはparseが軽いのでcookedファイルを経由しない
+		Init(ModelMethods::LoadGlbFile(directoryPath, filename, false, vertexFormat));
+		return;
+	}
+
+	Init(ModelMethods::LoadCookedObjFile(directoryPath, filename, vertexFormat));
+}
+
+void Model::Init(ModelData&& modelData) {
+	modelData_ = std::move(modelData);
 
 	size_ = static_cast<uint32_t>(modelData_.meshs.size());
 
 	// textureManagerでモデルで使うloadTextureを呼び出し
-	for (auto& it : modelData_.materials) {
-		if (it.isUseTexture) {
-			MyEngine::GetTextureManager()->LoadTexture(it.textureFilePath);
+	textureIds_.assign(modelData_.materials.size(), kInvalidTextureId);
+
+	for (size_t i = 0; i < modelData_.materials.size(); ++i) {
+		if (modelData_.materials[i].isUseTexture) {
+			textureIds_[i] = MyEngine::GetTextureManager()->LoadTexture(modelData_.materials[i].textureFilePath);
+
+			// atlasに含まれる場合は, 同じatlasのmaterialをまとめて描画できる
+			modelData_.materials[i].uvTransform = MyEngine::GetTextureManager()->GetUvTransform(modelData_.materials[i].textureFilePath);
 		}
 	}
 }
 
-void Model::Term() {
+void Model::RequestTextureMip(uint32_t index, const Matrix4x4& world, const Camera3D& camera) {
+	if (textureIds_[index] != kInvalidTextureId) {
+		MyEngine::GetTextureManager()->RequestMip(textureIds_[index], Collider::TransformSphere(modelData_.meshs[index].sphere, world), camera);
+	}
+}
 
-	for (uint32_t i = 0; i < size_; ++i) {
-		// meshDataのdelete
-		modelData_.meshs[i].vertexResource.reset();
-		modelData_.meshs[i].indexResource.reset();
+void Model::DrawCallCulled(ID3D12GraphicsCommandList* commandList, uint32_t index, const Matrix4x4& world, const Camera3D& camera) {
+	const MeshData& mesh = modelData_.meshs[index];
 
-		// materialDataの終了処理
-		if (modelData_.materials[i].isUseTexture) {
-			MyEngine::GetTextureManager()->UnloadTexture(modelData_.materials[i].textureFilePath);
-		}
+	Sphere sphere = Collider::TransformSphere(mesh.sphere, world);
+
+	// mesh全体が視錐台の外側
+	if (!Collider::SphereToFrustum(sphere, Collider::MakeFrustum(camera.GetViewProjectionMatrix()))) {
+		return;
 	}
 
-	// modelDataの削除
-	modelData_.meshs.clear();
-	modelData_.materials.clear();
+	if (textureIds_[index] != kInvalidTextureId) {
+		MyEngine::GetTextureManager()->RequestMip(textureIds_[index], sphere, camera);
+	}
+
+	if (mesh.meshlets.empty()) { //!< meshletがない場合はmesh全体
+		DrawCall(commandList, index, 1);
+		return;
+	}
+
+	MeshletMethods::Cull(mesh.meshlets, world, camera.GetViewProjectionMatrix(), camera.GetCamera().translate, drawRanges_);
+
+	for (const auto& range : drawRanges_) {
+		commandList->DrawIndexedInstanced(range.indexCount, 1, mesh.startIndex + range.indexOffset, mesh.baseVertex, 0);
+	}
 }
 
-ModelData ModelMethods::LoadObjFile(const std::string& directoryPath, const std::string& filename) {
-	ModelData result;
+uint32_t Model::SelectLod(uint32_t index, const Matrix4x4& world, const Camera3D& camera, float pixelError) const {
+	const MeshData& mesh = modelData_.meshs[index];
 
-	std::string mtlFilename;
-	MaterialData materialData;
+	if (mesh.lods.size() <= 1) {
+		return 0;
+	}
 
-	std::string line;
+	// world行列の最大scale
+	float scale = (std::max)({
+		Vector::Length({ world.m[0][0], world.m[0][1], world.m[0][2] }),
+		Vector::Length({ world.m[1][0], world.m[1][1], world.m[1][2] }),
+		Vector::Length({ world.m[2][0], world.m[2][1], world.m[2][2] }),
+	});
 
-	
-	// VertexDataの一時保存
-	std::vector<Vector4f> positions;
-	std::vector<Vector2f> texcoords;
-	std::vector<Vector3f> normals;
+	// 境界球の表面までの距離. 内側にいる場合はLOD0
+	Sphere sphere   = Collider::TransformSphere(mesh.sphere, world);
+	float  distance = Vector::Length(sphere.center - camera.GetCamera().translate) - sphere.radius;
 
-	std::vector<VertexData> vertexDatas; // vertexResourceに書き込み
+	if (distance <= 0.0f) {
+		return 0;
+	}
 
-	// faceの一時保存
-	enum FaceType {
-		v, vt, vn,
+	// model空間の誤差1あたりの画面上のpixel数
+	float pixelPerUnit = scale * camera.GetProjectionMatrix().m[1][1] * static_cast<float>(kWindowHeight) * 0.5f / distance;
 
-		kFaceTypeCount
-	};
+	uint32_t result = 0;
 
-	// vertexdata
-	uint32_t vertexDataIndexCount = 0;
-	std::unordered_map<std::string, uint32_t> faces; // key: f "1/2/3", value: vertexDataの配列数
+	for (uint32_t lod = 1; lod < mesh.lods.size(); ++lod) {
+		if (mesh.lods[lod].error * pixelPerUnit > pixelError) {
+			break;
+		}
 
-	// vertexDataIndexの調整
-	uint32_t currentIndex[kFaceTypeCount] = { 0, 0, 0 };
-	uint32_t startIndex[kFaceTypeCount] = { 1, 1, 1 };
+		result = lod;
+	}
 
-	// indexdata
-	std::vector<uint32_t> indexDatas; // indexResourceに書き込み用
-	
+	return result;
+}
 
-	// Objファイルを開く
-	std::ifstream file(directoryPath + "/" + filename);
-	assert(file.is_open()); //!< fileが見つからなかった.
+bool Model::IsVisible(const Matrix4x4& world, const Camera3D& camera) const {
+	return Collider::SphereToFrustum(Collider::TransformSphere(modelData_.sphere, world), Collider::MakeFrustum(camera.GetViewProjectionMatrix()));
+}
 
-	while (std::getline(file, line)) { // fileから一列ずつ読み込み
-		std::string identifire; // 識別子
-		std::istringstream s(line);
-		s >> identifire;
+void Model::Term() {
 
-		if (identifire == "mtllib") { //!< マテリアルファイル名
-			s >> mtlFilename; // ファイルnameの保存
+	// bufferのdelete
+	modelData_.vertexResource.reset();
+	modelData_.packedVertexResource.reset();
+	modelData_.quantizedVertexResource.reset();
+	modelData_.indexResource.reset();
 
-		} else if (identifire == "o") {
-			if (!positions.empty()) { //!< 二回目以降の"o"の場合
-				// mesh一つ分の書き込みが終わったので保存
-				MeshData meshData;
-				meshData.vertexResource
-					= std::make_unique<DxObject::BufferResource<VertexData>>(MyEngine::GetDevicesObj(), static_cast<uint32_t>(vertexDatas.size()));
-				meshData.vertexResource->Memcpy(vertexDatas.data());
+	for (TextureId id : textureIds_) {
+		// materialDataの終了処理
+		if (id != kInvalidTextureId) {
+			MyEngine::GetTextureManager()->UnloadTexture(id);
+		}
+	}
 
-				meshData.indexResource
-					= std::make_unique<DxObject::IndexBufferResource>(MyEngine::GetDevicesObj(), static_cast<uint32_t>(indexDatas.size()));
-				meshData.indexResource->Memcpy(indexDatas.data());
+	// modelDataの削除
+	modelData_.meshs.clear();
+	modelData_.materials.clear();
+	textureIds_.clear();
+}
 
-				// meshとmaterialをmodelDataに格納
-				result.meshs.push_back(std::move(meshData));
-				result.materials.push_back(std::move(materialData));
+ModelData ModelMethods::LoadObjFile(const std::string& directoryPath, const std::string& filename, ObjParseMode mode, bool isOptimize, VertexFormat vertexFormat) {
+	ModelRawData rawData = ParseObjFile(directoryPath, filename, mode);
+	assert(rawData.error.empty()); //!< 読み込みに失敗した
 
-				// 書き込みが終了したのでデータ初期化
-				for (int i = 0; i < kFaceTypeCount; ++i) {
-					// startIndexの更新
-					startIndex[i] += currentIndex[i];
-					currentIndex[i] = 0;
-				}
+	if (isOptimize) {
+		MeshSimplifier::BuildLods(rawData);
+		MeshOptimizer::Optimize(rawData);
+	}
 
-				// データの初期化
-				positions.clear();
-				texcoords.clear();
-				normals.clear();
+	MeshletMethods::Build(rawData);
 
-				vertexDatas.clear();
+	return CreateModelData(std::move(rawData), vertexFormat);
+}
 
-				faces.clear();
-				vertexDataIndexCount = 0;
-			}
+ModelRawData ModelMethods::ParseObjFile(const std::string& directoryPath, const std::string& filename, ObjParseMode mode) {
+	ModelRawData result;
 
-		} else if (identifire == "v") { //!< vertex
-			currentIndex[v]++;
+	switch (mode) {
+		case PARSE_STREAM:
+			result = ObjLoader::ParseStream(directoryPath, filename);
+			break;
 
-			// positionに書き込み
-			Vector4f position;
-			s >> position.x >> position.y >> position.z;
-			position.w = 1.0f;
+		case PARSE_MAPPED:
+			result = ObjLoader::ParseMapped(directoryPath, filename);
+			break;
 
-			// 左手座標に変換
-			position.z *= -1;
+		case PARSE_PARALLEL:
+			result = ObjLoader::ParseParallel(directoryPath, filename);
+			break;
 
-			// vectorに保存
-			positions.push_back(position);
-			
-		} else if (identifire == "vt") { //!< texcoord
-			currentIndex[vt]++;
+		default:
+			assert(false); //!< 未対応のparseMode
+			return {};
+	}
 
-			// texcoordに書き込み
-			Vector2f texcoord;
-			s >> texcoord.x >> texcoord.y;
+	if (!result.error.empty()) {
+		return result;
+	}
 
-			// 左手座標に変換
-			texcoord.y = 1.0f - texcoord.y;
+	// 頂点は以降の最適化で並び替えるのみなので, ここで境界を計算
+	MeshBounds::Compute(result);
 
-			// vectorに保存
-			texcoords.push_back(texcoord);
+	return result;
+}
 
-		} else if (identifire == "vn") { //!< normal
-			currentIndex[vn]++;
+ModelData ModelMethods::LoadGlbFile(const std::string& directoryPath, const std::string& filename, bool isOptimize, VertexFormat vertexFormat) {
+	ModelRawData rawData = ParseGlbFile(directoryPath, filename);
+	assert(rawData.error.empty()); //!< 読み込みに失敗した
 
-			// normalに書き込み
-			Vector3f normal;
-			s >> normal.x >> normal.y >> normal.z;
+	if (isOptimize) {
+		MeshSimplifier::BuildLods(rawData);
+		MeshOptimizer::Optimize(rawData);
+	}
 
-			// 左手座標に変換
-			normal.z *= -1;
+	MeshletMethods::Build(rawData);
 
-			// vectorに保存
-			normals.push_back(normal);
+	return CreateModelData(std::move(rawData), vertexFormat);
+}
 
-		} else if (identifire == "usemtl") { //!< materialの使用名
-			std::string usemtl;
-			s >> usemtl;
+ModelRawData ModelMethods::ParseGlbFile(const std::string& directoryPath, const std::string& filename) {
+	ModelRawData result = GltfLoader::ParseGlb(directoryPath, filename);
 
-			materialData = ModelMethods::LoadMaterailFile(directoryPath, mtlFilename, usemtl);
+	if (!result.error.empty()) {
+		return result;
+	}
 
-		} else if (identifire == "f") { //!< face 四角形ポリゴンに対応
-			// (f) "1/2/3", "4/5/6", "7/8/9" ... と読み込む
-			std::string faceStrings[4];
-			s >> faceStrings[0] >> faceStrings[1] >> faceStrings[2] >> faceStrings[3];
+	MeshBounds::Compute(result);
 
-			// vertexdata
-			int vertexNum = 0;
+	return result;
+}
 
-			for (uint32_t i = 0; i < 4; ++i) {
-				if (faceStrings[i] == "") { // 三角形ポリゴンなので i = 2 に break
-					break;
-				}
+bool ModelMethods::IsGlbFile(const std::string& filename) {
+	std::string extension = std::filesystem::path(filename).extension().string();
 
-				// 頂点数を増加
-				vertexNum++;
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+		return static_cast<char>(std::tolower(c));
+	});
 
-				// facesにすでにvertexdataがあるか確認
-				auto it = faces.find(faceStrings[i]);
-				if (it == faces.end()) { // ない場合, vertexdataの生成
+	return extension == ".glb";
+}
 
-					// faceStringからface番号を取得
-					uint32_t faceNum[3] = { NULL, NULL, NULL };
+ModelData ModelMethods::LoadCookedObjFile(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat) {
+	std::string cookedFilePath = MeshCache::GetCookedFilePath(directoryPath, filename);
+	uint64_t    objHash        = MeshCache::HashFile(directoryPath + "/" + filename);
 
-					std::istringstream indexs(faceStrings[i]);
+	// 同じmodelを同時に読み込んだ場合, 後の呼び出しは先のcookを待ってcookedファイルを読む
+	std::unique_lock<std::mutex> cookLock = MeshCache::LockCook(cookedFilePath);
 
-					for (int fi = 0; fi < 3; ++fi) {
-						std::string index;
-						std::getline(indexs, index, '/');
+	{
+		MeshCache::CookedFile cookedFile;
 
-						if (index != "") {
-							faceNum[fi] = std::stoi(index);
-						}
-					}
+		if (cookedFile.Open(cookedFilePath) && cookedFile.IsFresh(directoryPath, objHash)) {
+			// mapping中のblobをそのままGPUバッファにコピー
+			ModelData result;
+			result.vertexFormat = vertexFormat;
 
-					// 各データの取り出し
-					Vector4f position;
-					position = positions.at(faceNum[v] - startIndex[v]);
+			const std::vector<MeshCache::MeshView>& meshs = cookedFile.GetMeshs();
 
-					Vector2f texcoord = { 0.0f, 0.0f };
-					if (faceNum[vt] != NULL) {
-						texcoord = texcoords.at(faceNum[vt] - startIndex[vt]);
-					}
+			std::vector<AABB>   aabbs;
+			std::vector<Sphere> spheres;
+			ReadCookedBounds(cookedFile, aabbs, spheres, result.aabb, result.sphere);
 
-					Vector3f normal;
-					normal = normals.at(faceNum[vn] - startIndex[vn]);
+			uint32_t vertexCount = 0;
+			uint32_t indexCount  = 0;
 
-					// vertexdataの生成
-					VertexData vertexData = {
-						position,
-						texcoord,
-						normal,
-					};
+			for (size_t i = 0; i < meshs.size(); ++i) {
+				MeshData meshData;
+				meshData.baseVertex  = vertexCount;
+				meshData.vertexCount = meshs[i].vertexCount;
+				meshData.startIndex  = indexCount;
+				meshData.indexCount  = meshs[i].indexCount;
 
-					vertexDatas.push_back(vertexData);
+				vertexCount += meshs[i].vertexCount;
+				indexCount  += meshs[i].indexCount;
 
-					// facesにindex数の保存
-					faces[faceStrings[i]] = vertexDataIndexCount;
-					vertexDataIndexCount++;
-				}
-			}
+				meshData.meshlets.assign(meshs[i].meshlets, meshs[i].meshlets + meshs[i].meshletCount);
+				meshData.lods.assign(meshs[i].lods, meshs[i].lods + meshs[i].lodCount);
 
-			// indexdataの作成
-			if (vertexNum == 3) { //!< 三角形ポリゴンの場合
-				// 逆順にfacesでvertexIndexを問い合わせながらindexDetasに代入
-				for (uint32_t i = vertexNum; i > 0; --i) {
-					indexDatas.push_back(faces[faceStrings[i - 1]]);
-				}
+				meshData.aabb   = aabbs[i];
+				meshData.sphere = spheres[i];
 
-			} else if (vertexNum == 4) { //!< 四角形ポリゴンの場合
-				// 三角形ポリゴンに変換
-				// polygonA
-				indexDatas.push_back(faces[faceStrings[0]]);
-				indexDatas.push_back(faces[faceStrings[3]]);
-				indexDatas.push_back(faces[faceStrings[1]]);
+				result.meshs.push_back(std::move(meshData));
+			}
 
-				// polygonB
-				indexDatas.push_back(faces[faceStrings[3]]);
-				indexDatas.push_back(faces[faceStrings[2]]);
-				indexDatas.push_back(faces[faceStrings[1]]);
+			CreateResources(result);
 
-			} else {
-				assert(false); //!< ポリゴンの頂点数の不足
+			for (size_t i = 0; i < meshs.size(); ++i) {
+				WriteMesh(result, result.meshs[i], meshs[i].vertices, meshs[i].indices);
 			}
+
+			UploadResources(result);
+
+			result.materials = cookedFile.GetMaterials();
+
+			return result;
 		}
 	}
 
-	file.close();
+	// cookedファイルがない, または元ファイルが更新されていた場合
+	ModelRawData rawData = CookRawData(directoryPath, filename, cookedFilePath, objHash);
+	assert(rawData.error.empty()); //!< 読み込みに失敗した
 
-	// fileが終わったので最後のやつを初期化
-	if (!positions.empty()) {
-		// mesh一つ分の書き込みが終わったので保存
-		MeshData meshData;
-		meshData.vertexResource
-			= std::make_unique<DxObject::BufferResource<VertexData>>(MyEngine::GetDevicesObj(), static_cast<uint32_t>(vertexDatas.size()));
-		meshData.vertexResource->Memcpy(vertexDatas.data());
-
-		meshData.indexResource
-			= std::make_unique<DxObject::IndexBufferResource>(MyEngine::GetDevicesObj(), static_cast<uint32_t>(indexDatas.size()));
-		meshData.indexResource->Memcpy(indexDatas.data());
-		
-		// meshとmaterialをmodelDataに格納
-		result.meshs.push_back(std::move(meshData));
-		result.materials.push_back(std::move(materialData));
+	return CreateModelData(std::move(rawData), vertexFormat);
+}
 
-		// 書き込みが終了したのでデータ初期化
-		for (int i = 0; i < kFaceTypeCount; ++i) {
-			// startIndexの更新
-			startIndex[i] += currentIndex[i];
-			currentIndex[i] = 0;
-		}
+ModelRawData ModelMethods::CookObjFile(const std::string& directoryPath, const std::string& filename) {
+	std::string cookedFilePath = MeshCache::GetCookedFilePath(directoryPath, filename);
+	uint64_t    objHash        = MeshCache::HashFile(directoryPath + "/" + filename);
+
+	// 同じmodelを同時に読み込んだ場合, 後の呼び出しは先のcookを待ってcookedファイルを読む
+	std::unique_lock<std::mutex> cookLock = MeshCache::LockCook(cookedFilePath);
 
-		// 書き込みが終了したのでデータを終了処理
-		positions.clear();
-		texcoords.clear();
-		normals.clear();
+	{
+		MeshCache::CookedFile cookedFile;
 
-		vertexDatas.clear();
+		if (cookedFile.Open(cookedFilePath) && cookedFile.IsFresh(directoryPath, objHash)) {
+			// mapping中のblobをコピー
+			ModelRawData result;
 
-		faces.clear();
+			const std::vector<MeshCache::MeshView>& meshs = cookedFile.GetMeshs();
+
+			std::vector<AABB>   aabbs;
+			std::vector<Sphere> spheres;
+			ReadCookedBounds(cookedFile, aabbs, spheres, result.aabb, result.sphere);
+
+			for (size_t i = 0; i < meshs.size(); ++i) {
+				MeshRawData meshData;
+				meshData.vertices.assign(meshs[i].vertices, meshs[i].vertices + meshs[i].vertexCount);
+				meshData.indices.assign(meshs[i].indices, meshs[i].indices + meshs[i].indexCount);
+				meshData.meshlets.assign(meshs[i].meshlets, meshs[i].meshlets + meshs[i].meshletCount);
+				meshData.lods.assign(meshs[i].lods, meshs[i].lods + meshs[i].lodCount);
+
+				meshData.aabb   = aabbs[i];
+				meshData.sphere = spheres[i];
+
+				result.meshs.push_back(std::move(meshData));
+			}
+
+			result.materials   = cookedFile.GetMaterials();
+			result.mtlFilename = cookedFile.GetMtlFilename();
+
+			return result;
+		}
 	}
 
-	return result;
+	return CookRawData(directoryPath, filename, cookedFilePath, objHash);
 }
 
-MaterialData ModelMethods::LoadMaterailFile(const std::string& directoryPath, const std::string& filename, const std::string& usemtl) {
-	MaterialData result;
-	result.isUseTexture = false;
+ModelData ModelMethods::CreateModelData(ModelRawData&& rawData, VertexFormat vertexFormat) {
+	ModelData result;
+	result.vertexFormat = vertexFormat;
 
-	std::string line;
-	bool isMatchUsemtl = false;
+	uint32_t vertexCount = 0;
+	uint32_t indexCount  = 0;
 
-	// ファイルを開く
-	std::ifstream file(directoryPath + "/" + filename);
-	assert(file.is_open()); //!< ファイルが開けない
+	for (auto& mesh : rawData.meshs) {
+		MeshData meshData;
+		meshData.baseVertex  = vertexCount;
+		meshData.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+		meshData.startIndex  = indexCount;
+		meshData.indexCount  = static_cast<uint32_t>(mesh.indices.size());
 
-	while (std::getline(file, line)) {
-		std::string identifier;
-		std::istringstream s(line);
-		s >> identifier;
+		vertexCount += meshData.vertexCount;
+		indexCount  += meshData.indexCount;
 
-		// identifierに応じた処理
-		if (identifier == "newmtl") { //!< usemtl name
-			// usemtlと一致してるかの確認
-			std::string newmtl;
-			s >> newmtl;
+		meshData.meshlets = std::move(mesh.meshlets);
+		meshData.lods     = std::move(mesh.lods);
+		meshData.aabb     = mesh.aabb;
+		meshData.sphere   = mesh.sphere;
 
-			if (isMatchUsemtl) { //!< 見つかっていた場合
-				break;
-				
-			} else { 
-				if (usemtl == newmtl) { //!< 一致していた場合
-					isMatchUsemtl = true;
-				}
-			}
-		}
+		result.meshs.push_back(std::move(meshData));
+	}
 
-		if (!isMatchUsemtl) { // 使いたいマテリアルではないので飛ばす.
-			continue;
-		}
+	CreateResources(result);
 
-		// materail情報
-		// identifierに応じた処理
-		if (identifier == "map_Kd") { //!< 使うtextureの名前
-			std::string textureFilename;
-			s >> textureFilename;
-			// 連結してファイルパスに変換
-			result.textureFilePath = directoryPath + "/" + textureFilename;
-			result.isUseTexture = true;
-			break;
-		}
+	for (size_t i = 0; i < rawData.meshs.size(); ++i) {
+		WriteMesh(result, result.meshs[i], rawData.meshs[i].vertices.data(), rawData.meshs[i].indices.data());
 	}
 
-	file.close();
+	UploadResources(result);
+
+	result.materials = std::move(rawData.materials);
+	result.aabb      = rawData.aabb;
+	result.sphere    = rawData.sphere;
 
 	return result;
 }
+
+MaterialData ModelMethods::LoadMaterailFile(const std::string& directoryPath, const std::string& filename, const std::string& usemtl) {
+	return ObjLoader::LoadMaterial(directoryPath, filename, usemtl);
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <cassert>
 #include <memory>
+#include <algorithm>
 
 #include "MyEngine.h" //!< devices, TextureManagerの取り出し
 #include <TextureManager.h>
@@ -24,30 +25,68 @@
 #include <Vector2.h>
 
 #include <ObjectStructure.h>
+#include <ModelRawData.h>
+#include <Meshlet.h>
 
-////////////////////////////////////////////////////////////////////////////////////////////
-// MeshData structure
-////////////////////////////////////////////////////////////////////////////////////////////
-struct MeshData {
-	std::unique_ptr<DxObject::BufferResource<VertexData>> vertexResource;
-	std::unique_ptr<DxObject::IndexBufferResource>        indexResource;
-};
+// camera
+#include <Camera3D.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////
-// MaterialData structure
+// MeshData structure
 ////////////////////////////////////////////////////////////////////////////////////////////
-struct MaterialData {
-	std::string textureFilePath;
-	bool        isUseTexture;
+struct MeshData { //!< ModelDataのバッファ内の範囲
+	uint32_t             baseVertex  = 0; //!< vertex buffer内の先頭頂点. indexはmesh内の番号
+	uint32_t             vertexCount = 0;
+	uint32_t             startIndex  = 0; //!< index buffer内の先頭index
+	uint32_t             indexCount  = 0; //!< LODを含む全index数
+	std::vector<Meshlet> meshlets;        //!< indexOffsetはmesh内
+	std::vector<MeshLod> lods;            //!< 空の場合はindex全体がLOD0. indexOffsetはmesh内
+	VertexQuantization   quantization = { {}, 0.0f, { 1.0f, 1.0f, 1.0f }, 0.0f }; //!< compactな頂点の復元用
+	AABB                 aabb   = {}; //!< model空間の境界
+	Sphere               sphere = {};
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // ModelData structure
 ////////////////////////////////////////////////////////////////////////////////////////////
 struct ModelData {
+	std::unique_ptr<DxObject::BufferResource<VertexData>>          vertexResource;          //!< VERTEX_FORMAT_DEFAULT
+	std::unique_ptr<DxObject::BufferResource<VertexDataPacked>>    packedVertexResource;    //!< VERTEX_FORMAT_PACKED
+	std::unique_ptr<DxObject::BufferResource<VertexDataQuantized>> quantizedVertexResource; //!< VERTEX_FORMAT_QUANTIZED
+	std::unique_ptr<DxObject::IndexBufferResource>                 indexResource;
+	// 全meshで一つのバッファを共有
+
 	std::vector<MeshData>     meshs;
 	std::vector<MaterialData> materials;
 	// meshsとmaterialsのsizeは同じ
+
+	VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT; //!< 全meshで共通
+
+	AABB   aabb   = {}; //!< 全meshの境界 (model空間)
+	Sphere sphere = {};
+
+	//! @brief 生成されているformatのVertexBufferを取得
+	const D3D12_VERTEX_BUFFER_VIEW GetVertexBufferView() const {
+		if (packedVertexResource != nullptr) {
+			return packedVertexResource->GetVertexBufferView();
+
+		} else if (quantizedVertexResource != nullptr) {
+			return quantizedVertexResource->GetVertexBufferView();
+		}
+
+		return vertexResource->GetVertexBufferView();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ObjParseMode enum
+////////////////////////////////////////////////////////////////////////////////////////////
+enum ObjParseMode {
+	PARSE_STREAM,   //!< std::getline + std::istringstream
+	PARSE_MAPPED,   //!< file mapping + 独自scanner
+	PARSE_PARALLEL, //!< PARSE_MAPPED を行境界で分割し複数スレッドで処理
+
+	kObjParseModeCount
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -56,48 +95,167 @@ struct ModelData {
 class Model {
 public:
 
+	//=========================================================================================
+	// public variables
+	//=========================================================================================
+
+	static const float kDefaultLodPixelError; //!< SelectLodで許容する画面上の誤差 (pixel)
+
 	//! @brief コンストラクタ
-	Model(const std::string& directoryPath, const std::string& filename) {
-		Init(directoryPath, filename);
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] vertexFormat  GPUに置く頂点のformat
+	Model(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT) {
+		Init(directoryPath, filename, vertexFormat);
 	}
 
 	//! @brief デストラクタ
 	~Model() { Term(); }
 
-	//! @brief 初期化処理
-	void Init(const std::string& directoryPath, const std::string& filename);
+	//! @brief 生成済みのmodelDataから作成. ModelLoaderでGPUバッファを生成した後に使用
+	//!
+	//! @param[in] modelData GPUバッファ生成済みのmodelData
+	Model(ModelData&& modelData) {
+		Init(std::move(modelData));
+	}
+
+	//! @brief 初期化処理. ".glb"の場合はglbファイル, それ以外はobjファイルとして読み込む
+	void Init(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
+
+	//! @brief 初期化処理. materialのtextureを読み込む
+	void Init(ModelData&& modelData);
 
 	void Term();
 
 	const uint32_t GetSize() const { return size_; }
 	
 	// Draw
-	void SetBuffers(ID3D12GraphicsCommandList* commandList, uint32_t index) {
-		if (index >= size_) {
-			assert(false); //!< 配列以上のmodelDataの呼び出し
-		}
-
-		D3D12_VERTEX_BUFFER_VIEW vertexBufferView = modelData_.meshs[index].vertexResource->GetVertexBufferView();
-		D3D12_INDEX_BUFFER_VIEW indexBufferView = modelData_.meshs[index].indexResource->GetIndexBufferView();
+	//! @brief 全meshで共有のバッファを設定. meshが複数でも一度のみでよい
+	void SetBuffers(ID3D12GraphicsCommandList* commandList) {
+		D3D12_VERTEX_BUFFER_VIEW vertexBufferView = modelData_.GetVertexBufferView();
+		D3D12_INDEX_BUFFER_VIEW indexBufferView = modelData_.indexResource->GetIndexBufferView();
 
 		commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
 		commandList->IASetIndexBuffer(&indexBufferView);
 	}
 
+	//! @brief compactな頂点の復元用の値を設定. VERTEX_FORMAT_DEFAULTの場合は何もしない
+	//!
+	//! @param[in] parameterNum VertexQuantizationのroot parameter番号
+	//! @param[in] commandList  commandList
+	//! @param[in] index        mesh番号
+	void SetVertexQuantization(UINT parameterNum, ID3D12GraphicsCommandList* commandList, uint32_t index) {
+		if (modelData_.vertexFormat != VERTEX_FORMAT_DEFAULT) {
+			commandList->SetGraphicsRoot32BitConstants(
+				parameterNum, sizeof(VertexQuantization) / sizeof(uint32_t), &modelData_.meshs[index].quantization, 0
+			);
+		}
+	}
+
 	void SetTexture(UINT parameterNum, ID3D12GraphicsCommandList* commandList, uint32_t index) {
-		if (modelData_.materials[index].isUseTexture) {
-			commandList->SetGraphicsRootDescriptorTable(parameterNum, MyEngine::GetTextureHandleGPU(modelData_.materials[index].textureFilePath));
+		if (textureIds_[index] != kInvalidTextureId) {
+			commandList->SetGraphicsRootDescriptorTable(parameterNum, MyEngine::GetTextureManager()->GetHandleGPU(textureIds_[index]));
 		}
 	}
 
-	void DrawCall(ID3D12GraphicsCommandList* commandList, uint32_t index, uint32_t instanceCount) {
-		commandList->DrawIndexedInstanced(modelData_.meshs[index].indexResource->GetSize(), instanceCount, 0, 0, 0);
+	void DrawCall(ID3D12GraphicsCommandList* commandList, uint32_t index, uint32_t instanceCount, uint32_t lod = 0) {
+		if (index >= size_) {
+			assert(false); //!< 配列以上のmodelDataの呼び出し
+		}
+
+		const MeshData& mesh = modelData_.meshs[index];
+
+		if (mesh.lods.empty()) {
+			commandList->DrawIndexedInstanced(mesh.indexCount, instanceCount, mesh.startIndex, mesh.baseVertex, 0);
+			return;
+		}
+
+		const MeshLod& meshLod = mesh.lods[(std::min)(lod, static_cast<uint32_t>(mesh.lods.size()) - 1)];
+		commandList->DrawIndexedInstanced(meshLod.indexCount, instanceCount, mesh.startIndex + meshLod.indexOffset, mesh.baseVertex, 0);
+	}
+
+	//! @brief 画面上の誤差がpixelError以下となる, 最も粗いLODを選択
+	//!
+	//! @param[in] index      mesh番号
+	//! @param[in] world      world行列
+	//! @param[in] camera     描画に使うカメラ
+	//! @param[in] pixelError 許容する画面上の誤差 (pixel)
+	//!
+	//! @return DrawCallに渡すLOD番号を返却
+	uint32_t SelectLod(uint32_t index, const Matrix4x4& world, const Camera3D& camera, float pixelError = kDefaultLodPixelError) const;
+
+	uint32_t GetLodCount(uint32_t index) const {
+		return (std::max)(static_cast<uint32_t>(modelData_.meshs[index].lods.size()), 1u);
 	}
 
+	//! @brief meshの画面上の大きさからtextureに必要なmipを要求. streamingのtexture以外は何もしない
+	//!
+	//! @param[in] index  mesh番号
+	//! @param[in] world  world行列
+	//! @param[in] camera 描画に使うカメラ
+	void RequestTextureMip(uint32_t index, const Matrix4x4& world, const Camera3D& camera);
+
+	//! @brief 視錐台の外側, 裏向きのmeshletを除いて描画. instanceは一つのみ
+	//!
+	//! 視錐台の内側の場合はRequestTextureMipも行う
+	//!
+	//! @param[in] commandList commandList
+	//! @param[in] index       mesh番号
+	//! @param[in] world       world行列
+	//! @param[in] camera      描画に使うカメラ
+	void DrawCallCulled(ID3D12GraphicsCommandList* commandList, uint32_t index, const Matrix4x4& world, const Camera3D& camera);
+
 	const MeshData& GetMeshData(uint32_t index) const {
 		return modelData_.meshs[index];
 	}
 
+	const MaterialData& GetMaterialData(uint32_t index) const {
+		return modelData_.materials[index];
+	}
+
+	//! @brief material cbufferのMaterial::uvTransformに書き込む行列
+	//!
+	//! textureがatlasに含まれる場合は, atlas上のuvへの変換 (MaterialData::uvTransform) を右から掛ける.
+	//! Materialを書き込む時は, uvTransformを直接ではなくこの戻り値を書き込むこと
+	//!
+	//! @param[in] index       mesh番号
+	//! @param[in] uvTransform objectのuvの変換. scroll, tilingなど
+	//!
+	//! @return uvTransform * atlasの変換を返却
+	Matrix4x4 GetUvTransform(uint32_t index, const Matrix4x4& uvTransform = Matrix4x4::MakeIdentity()) const {
+		return uvTransform * modelData_.materials[index].uvTransform;
+	}
+
+	//! @brief materialのtextureのid. textureを使わない場合はkInvalidTextureId
+	//!
+	//! atlasに含まれるtextureは同じidとなるため, idが前の描画と同じ場合はSetTextureを省略できる
+	TextureId GetTextureId(uint32_t index) const { return textureIds_[index]; }
+
+	//! @brief MyEngine::SetVertexFormatに渡すformat
+	VertexFormat GetVertexFormat() const { return modelData_.vertexFormat; }
+
+	//! @brief meshのmodel空間のAABB. world空間はCollider::TransformAABBで変換
+	const AABB& GetAABB(uint32_t index) const { return modelData_.meshs[index].aabb; }
+
+	//! @brief meshのmodel空間の境界球. world空間はCollider::TransformSphereで変換
+	const Sphere& GetSphere(uint32_t index) const { return modelData_.meshs[index].sphere; }
+
+	//! @brief 全meshを含むmodel空間のAABB
+	const AABB& GetModelAABB() const { return modelData_.aabb; }
+
+	//! @brief 全meshを含むmodel空間の境界球
+	const Sphere& GetModelSphere() const { return modelData_.sphere; }
+
+	//! @brief model全体の境界球が視錐台と交差するか
+	//!
+	//! @param[in] world  world行列
+	//! @param[in] camera 描画に使うカメラ
+	//!
+	//! @retval true  一部でも視錐台の内側にある
+	//! @retval false 完全に外側. 描画を省略できる
+	bool IsVisible(const Matrix4x4& world, const Camera3D& camera) const;
+
 private:
 
 	//=========================================================================================
@@ -106,6 +264,10 @@ private:
 
 	ModelData modelData_;
 	uint32_t  size_;
+
+	std::vector<TextureId> textureIds_; //!< materialsと同じ順. 描画時に文字列で検索しない
+
+	std::vector<MeshletMethods::DrawRange> drawRanges_; //!< DrawCallCulled用
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,7 +275,71 @@ private:
 ////////////////////////////////////////////////////////////////////////////////////////////
 namespace ModelMethods {
 
-	ModelData LoadObjFile(const std::string& directoryPath, const std::string& filename);
+	//! @brief objファイルを読み込み, GPUバッファまで生成
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] mode          parseの方式
+	//! @param[in] isOptimize    LOD作成, vertex cache, overdraw, vertex fetch の最適化を行うか
+	//! @param[in] vertexFormat  GPUに置く頂点のformat
+	//!
+	//! @return modelDataを返却
+	ModelData LoadObjFile(const std::string& directoryPath, const std::string& filename, ObjParseMode mode = PARSE_MAPPED, bool isOptimize = false, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
+
+	//! @brief objファイルをCPU側のデータとして読み込む
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] mode          parseの方式
+	//!
+	//! @return CPU側のmodelDataを返却. 失敗した場合はerrorを設定
+	ModelRawData ParseObjFile(const std::string& directoryPath, const std::string& filename, ObjParseMode mode);
+
+	//! @brief glbファイルを読み込み, GPUバッファまで生成
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      glbファイル名
+	//! @param[in] isOptimize    LOD作成, vertex cache, overdraw, vertex fetch の最適化を行うか
+	//! @param[in] vertexFormat  GPUに置く頂点のformat
+	//!
+	//! @return modelDataを返却
+	ModelData LoadGlbFile(const std::string& directoryPath, const std::string& filename, bool isOptimize = false, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
+
+	//! @brief glbファイルをCPU側のデータとして読み込む. accessorはマッピングしたファイルから直接読み込む
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      glbファイル名
+	//!
+	//! @return CPU側のmodelDataを返却. 失敗した場合はerrorを設定
+	ModelRawData ParseGlbFile(const std::string& directoryPath, const std::string& filename);
+
+	//! @brief 拡張子が".glb"か (大文字小文字は区別しない)
+	bool IsGlbFile(const std::string& filename);
+
+	//! @brief cookedファイルがあればそこから, なければobjファイルを読み込みLOD作成, 最適化してcookedファイルを書き出す
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] vertexFormat  GPUに置く頂点のformat. cookedファイルは常にVertexDataで保存
+	//!
+	//! @return modelDataを返却
+	ModelData LoadCookedObjFile(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
+
+	//! @brief LoadCookedObjFileのCPU側の処理のみ. GPUを使わないためworkerスレッドから呼び出せる
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//!
+	//! @return CPU側のmodelDataを返却. CreateModelDataでGPUバッファを生成する. 失敗した場合はerrorを設定
+	ModelRawData CookObjFile(const std::string& directoryPath, const std::string& filename);
+
+	//! @brief CPU側のmodelDataからGPUバッファを生成
+	//!
+	//! @param[in] rawData      CPU側のmodelData
+	//! @param[in] vertexFormat GPUに置く頂点のformat
+	//!
+	//! @return modelDataを返却
+	ModelData CreateModelData(ModelRawData&& rawData, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
 
 	MaterialData LoadMaterailFile(const std::string& directoryPath, const std::string& filename, const std::string& usemtl);
 }
\ No newline at end of file
@@ -0,0 +1,305 @@
+#include "ModelBenchmark.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <cmath>
+#include <numbers>
+#include <cassert>
+#include <algorithm>
+#include <cstdlib>
+
+// engine
+#include <ObjLoader.h>
+#include <VertexCompressor.h>
+#include <ProcessMemory.h>
+#include <TextureCooker.h>
+#include <Logger.h>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief 関数の平均実行時間を計測
+	//!
+	//! @return 一回あたりの時間(ms)を返却
+	template <typename F>
+	double Measure(uint32_t iterationCount, F&& function) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < iterationCount; ++i) {
+			function();
+		}
+
+		auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count() / static_cast<double>(iterationCount);
+	}
+
+	//! @brief ModelRawDataが完全に一致しているか
+	bool IsSameRawData(const ModelRawData& a, const ModelRawData& b) {
+		if (a.meshs.size() != b.meshs.size()) {
+			return false;
+		}
+
+		for (size_t i = 0; i < a.meshs.size(); ++i) {
+			const MeshRawData& meshA = a.meshs[i];
+			const MeshRawData& meshB = b.meshs[i];
+
+			if (meshA.vertices.size() != meshB.vertices.size() || meshA.indices != meshB.indices) {
+				return false;
+			}
+
+			if (std::memcmp(meshA.vertices.data(), meshB.vertices.data(), sizeof(VertexData) * meshA.vertices.size()) != 0) {
+				return false;
+			}
+
+			if (a.materials[i].textureFilePath != b.materials[i].textureFilePath
+				|| a.materials[i].isUseTexture != b.materials[i].isUseTexture) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelBenchmark namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+
+ModelBenchmark::ObjParseResult ModelBenchmark::ObjParse(const std::string& directoryPath, const std::string& filename, uint32_t iterationCount) {
+	ObjParseResult result = {};
+
+	if (iterationCount == 0) {
+		iterationCount = 1;
+	}
+
+	// 結果の比較
+	result.isMatch = IsSameRawData(
+		ObjLoader::ParseStream(directoryPath, filename),
+		ObjLoader::ParseMapped(directoryPath, filename)
+	);
+
+	// 時間の計測
+	result.streamMs = Measure(iterationCount, [&]() { ObjLoader::ParseStream(directoryPath, filename); });
+	result.mappedMs = Measure(iterationCount, [&]() { ObjLoader::ParseMapped(directoryPath, filename); });
+
+	Log(std::format(
+		"[ModelBenchmark::ObjParse] {}/{}\n stream: {:.3f}ms, mapped: {:.3f}ms (x{:.2f}), match: {}\n",
+		directoryPath, filename,
+		result.streamMs, result.mappedMs, result.streamMs / result.mappedMs,
+		result.isMatch ? "true" : "false"
+	));
+
+	return result;
+}
+
+std::vector<ModelBenchmark::ObjParseScalingResult> ModelBenchmark::ObjParseScaling(const std::string& directoryPath, const std::string& filename, uint32_t iterationCount) {
+	std::vector<ObjParseScalingResult> result;
+
+	if (iterationCount == 0) {
+		iterationCount = 1;
+	}
+
+	// 基準となる直列parse
+	ModelRawData reference = ObjLoader::ParseMapped(directoryPath, filename);
+	double mappedMs = Measure(iterationCount, [&]() { ObjLoader::ParseMapped(directoryPath, filename); });
+
+	Log(std::format("[ModelBenchmark::ObjParseScaling] {}/{}\n mapped: {:.3f}ms\n", directoryPath, filename, mappedMs));
+
+	uint32_t maxThreadCount = Parallel::GetThreadCount();
+
+	for (uint32_t threadCount = 1;; threadCount = (std::min)(threadCount * 2, maxThreadCount)) {
+		ObjParseScalingResult scaling = {};
+		scaling.threadCount = threadCount;
+		scaling.isMatch     = IsSameRawData(reference, ObjLoader::ParseParallel(directoryPath, filename, threadCount));
+		scaling.parallelMs  = Measure(iterationCount, [&]() { ObjLoader::ParseParallel(directoryPath, filename, threadCount); });
+		scaling.speedup     = mappedMs / scaling.parallelMs;
+
+		Log(std::format(
+			" parallel({:2}): {:.3f}ms (x{:.2f}), match: {}\n",
+			scaling.threadCount, scaling.parallelMs, scaling.speedup, scaling.isMatch ? "true" : "false"
+		));
+
+		result.push_back(scaling);
+
+		if (threadCount == maxThreadCount) {
+			break;
+		}
+	}
+
+	return result;
+}
+
+std::vector<MeshOptimizer::OptimizeResult> ModelBenchmark::VertexCache(const std::string& directoryPath, const std::string& filename) {
+	std::vector<MeshOptimizer::OptimizeResult> result;
+
+	ModelRawData rawData = ObjLoader::ParseMapped(directoryPath, filename);
+
+	Log(std::format("[ModelBenchmark::VertexCache] {}/{}\n cache size: {}\n", directoryPath, filename, MeshOptimizer::kDefaultCacheSize));
+
+	for (size_t i = 0; i < rawData.meshs.size(); ++i) {
+		MeshOptimizer::OptimizeResult optimize = MeshOptimizer::Optimize(rawData.meshs[i]);
+
+		Log(std::format(
+			" mesh[{}]: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}\n",
+			i, optimize.before.acmr, optimize.after.acmr, optimize.before.atvr, optimize.after.atvr
+		));
+
+		result.push_back(optimize);
+	}
+
+	return result;
+}
+
+std::vector<ModelBenchmark::VertexCompressionResult> ModelBenchmark::VertexCompression(const std::string& directoryPath, const std::string& filename, uint32_t iterationCount) {
+	std::vector<VertexCompressionResult> result;
+
+	ModelRawData rawData = ObjLoader::ParseMapped(directoryPath, filename);
+
+	Log(std::format("[ModelBenchmark::VertexCompression] {}/{}\n", directoryPath, filename));
+
+	for (size_t i = 0; i < rawData.meshs.size(); ++i) {
+		const std::vector<VertexData>& vertices = rawData.meshs[i].vertices;
+		uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+		VertexCompressionResult compression = {};
+		compression.defaultBytes   = static_cast<uint32_t>(sizeof(VertexData) * vertexCount);
+		compression.packedBytes    = static_cast<uint32_t>(sizeof(VertexDataPacked) * vertexCount);
+		compression.quantizedBytes = static_cast<uint32_t>(sizeof(VertexDataQuantized) * vertexCount);
+
+		VertexQuantization               quantization = VertexCompressor::ComputeQuantization(vertices.data(), vertexCount);
+		std::vector<VertexDataQuantized> quantized(vertexCount);
+
+		compression.encodeMs = Measure(iterationCount, [&]() {
+			VertexCompressor::Encode(vertices.data(), vertexCount, quantization, quantized.data());
+		});
+
+		std::vector<VertexData> decoded(vertexCount);
+		VertexCompressor::Decode(quantized.data(), vertexCount, quantization, decoded.data());
+
+		VertexCompressor::Measure(
+			vertices.data(), decoded.data(), vertexCount,
+			compression.maxPositionError, compression.maxTexcoordError, compression.maxNormalAngle
+		);
+
+		compression.maxNormalAngle *= 180.0f / std::numbers::pi_v<float>;
+
+		Log(std::format(
+			" mesh[{}]: {} -> {} (packed) -> {} (quantized) bytes, encode {:.3f}ms, error position {:.6f}, uv {:.6f}, normal {:.3f}deg\n",
+			i, compression.defaultBytes, compression.packedBytes, compression.quantizedBytes, compression.encodeMs,
+			compression.maxPositionError, compression.maxTexcoordError, compression.maxNormalAngle
+		));
+
+		result.push_back(compression);
+	}
+
+	return result;
+}
+
+ModelBenchmark::StreamingImportResult ModelBenchmark::StreamingImport(const std::string& directoryPath, const std::string& filename, size_t memoryBudget) {
+	StreamingImportResult result = {};
+
+	ProcessMemory::ResetPeakWorkingSetSize();
+	size_t workingSet = ProcessMemory::GetWorkingSetSize();
+
+	result.importMs = Measure(1, [&]() { result.import = ObjStreamImporter::Import(directoryPath, filename, memoryBudget); });
+	result.isWithinBudget = result.import.peakMemory <= result.import.memoryBudget;
+
+	size_t peakWorkingSet = ProcessMemory::GetPeakWorkingSetSize();
+	result.peakWorkingSet = (peakWorkingSet > workingSet) ? peakWorkingSet - workingSet : 0;
+
+	Log(std::format(
+		"[ModelBenchmark::StreamingImport] {}/{}\n success: {}, {:.3f}ms, mesh: {}, vertex: {}, index: {}, peak {:.2f}MB (working set +{:.2f}MB) / budget {:.2f}MB\n",
+		directoryPath, filename,
+		result.import.isSuccess ? "true" : "false", result.importMs,
+		result.import.meshCount, result.import.vertexCount, result.import.indexCount,
+		result.import.peakMemory / (1024.0 * 1024.0), result.peakWorkingSet / (1024.0 * 1024.0), result.import.memoryBudget / (1024.0 * 1024.0)
+	));
+
+	return result;
+}
+
+void ModelBenchmark::WriteGridObj(const std::string& filePath, uint32_t faceCount, uint32_t objectCount) {
+	std::ofstream file(filePath);
+	assert(file.is_open());
+
+	if (objectCount == 0) {
+		objectCount = 1;
+	}
+
+	// object一つあたり division * division 枚の四角形
+	uint32_t division = (std::max)(static_cast<uint32_t>(std::sqrt(static_cast<double>(faceCount) / objectCount)), 1u);
+	uint32_t vertexCount = (division + 1) * (division + 1);
+
+	std::string line;
+	uint32_t offset = 0; //!< 前objectまでの頂点数 (v, vt, vn共通)
+
+	for (uint32_t object = 0; object < objectCount; ++object) {
+		file << "o grid" << object << "\n";
+
+		for (uint32_t z = 0; z <= division; ++z) {
+			for (uint32_t x = 0; x <= division; ++x) {
+				float u  = static_cast<float>(x) / division;
+				float v  = static_cast<float>(z) / division;
+				float y  = 0.25f * std::sin(u * 12.0f) * std::cos(v * 12.0f);
+
+				line = std::format("v {:.6f} {:.6f} {:.6f}\nvt {:.6f} {:.6f}\nvn 0.000000 1.000000 0.000000\n", u + object, y, v, u, v);
+				file << line;
+			}
+		}
+
+		for (uint32_t z = 0; z < division; ++z) {
+			for (uint32_t x = 0; x < division; ++x) {
+				uint32_t a = offset + z * (division + 1) + x + 1; //!< objは1始まり
+				uint32_t b = a + 1;
+				uint32_t c = a + (division + 1) + 1;
+				uint32_t d = a + (division + 1);
+
+				line = std::format("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n", a, b, c, d);
+				file << line;
+			}
+		}
+
+		offset += vertexCount;
+	}
+}
+
+bool ModelBenchmark::ParseCommandLine(const std::string& commandLine, std::string& filePath, uint32_t& faceCount, uint32_t& iterationCount) {
+	std::vector<std::string> tokens = TextureCooker::SplitCommandLine(commandLine);
+
+	if (tokens.empty() || tokens[0] != kCommandLineArg) {
+		return false;
+	}
+
+	filePath.clear();
+	faceCount      = kDefaultGridFaceCount;
+	iterationCount = kDefaultIterationCount;
+
+	for (size_t i = 1; i < tokens.size(); ++i) {
+		const std::string& token = tokens[i];
+
+		if (token == "--faces" && i + 1 < tokens.size()) {
+			faceCount = static_cast<uint32_t>(std::strtoul(tokens[++i].c_str(), nullptr, 10));
+
+		} else if (token == "--iterations" && i + 1 < tokens.size()) {
+			iterationCount = static_cast<uint32_t>(std::strtoul(tokens[++i].c_str(), nullptr, 10));
+
+		} else {
+			filePath = token;
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
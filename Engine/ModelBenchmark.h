@@ -0,0 +1,131 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <cstdint>
+#include <vector>
+
+// engine
+#include <MeshOptimizer.h>
+#include <ObjStreamImporter.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelBenchmark namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace ModelBenchmark {
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const char     kCommandLineArg[]      = "--benchmark-obj";
+	static const uint32_t kDefaultGridFaceCount  = 1'000'000; //!< ファイルを指定しない場合に生成する格子の四角形ポリゴン数
+	static const uint32_t kDefaultIterationCount = 3;
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ObjParseResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ObjParseResult {
+		double streamMs; //!< PARSE_STREAM 一回あたりの平均時間
+		double mappedMs; //!< PARSE_MAPPED 一回あたりの平均時間
+		bool   isMatch;  //!< 二つのparse結果が一致したか
+	};
+
+	//! @brief PARSE_STREAM と PARSE_MAPPED のparse時間を比較. 結果はLogにも出力
+	//!
+	//! @param[in] directoryPath  ディレクトリパス
+	//! @param[in] filename       objファイル名
+	//! @param[in] iterationCount 計測回数
+	//!
+	//! @return 計測結果を返却
+	ObjParseResult ObjParse(const std::string& directoryPath, const std::string& filename, uint32_t iterationCount = 10);
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ObjParseScalingResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ObjParseScalingResult {
+		uint32_t threadCount;
+		double   parallelMs; //!< PARSE_PARALLEL 一回あたりの平均時間
+		double   speedup;    //!< PARSE_MAPPED に対する速度比
+		bool     isMatch;    //!< PARSE_MAPPED と結果が一致したか
+	};
+
+	//! @brief スレッド数を 1, 2, 4, ... と変えてPARSE_PARALLELを計測. 結果はLogにも出力
+	//!
+	//! @param[in] directoryPath  ディレクトリパス
+	//! @param[in] filename       objファイル名
+	//! @param[in] iterationCount 計測回数
+	//!
+	//! @return スレッド数毎の計測結果を返却
+	std::vector<ObjParseScalingResult> ObjParseScaling(const std::string& directoryPath, const std::string& filename, uint32_t iterationCount = 3);
+
+	//! @brief MeshOptimizerによるACMR, ATVRの変化を計測. 結果はLogにも出力
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//!
+	//! @return mesh毎の最適化前後の計測結果を返却
+	std::vector<MeshOptimizer::OptimizeResult> VertexCache(const std::string& directoryPath, const std::string& filename);
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// VertexCompressionResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct VertexCompressionResult {
+		uint32_t defaultBytes;     //!< VERTEX_FORMAT_DEFAULT のbyteサイズ
+		uint32_t packedBytes;      //!< VERTEX_FORMAT_PACKED のbyteサイズ
+		uint32_t quantizedBytes;   //!< VERTEX_FORMAT_QUANTIZED のbyteサイズ
+		double   encodeMs;         //!< VERTEX_FORMAT_QUANTIZED への変換時間
+		float    maxPositionError; //!< VERTEX_FORMAT_QUANTIZED の位置の最大誤差
+		float    maxTexcoordError; //!< uvの最大誤差
+		float    maxNormalAngle;   //!< normalの最大誤差 (degree)
+	};
+
+	//! @brief compactな頂点formatへの変換時間と誤差を計測. 結果はLogにも出力
+	//!
+	//! @param[in] directoryPath  ディレクトリパス
+	//! @param[in] filename       objファイル名
+	//! @param[in] iterationCount 計測回数
+	//!
+	//! @return mesh毎の計測結果を返却
+	std::vector<VertexCompressionResult> VertexCompression(const std::string& directoryPath, const std::string& filename, uint32_t iterationCount = 10);
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// StreamingImportResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct StreamingImportResult {
+		ObjStreamImporter::ImportResult import;
+		double importMs;       //!< 変換時間
+		bool   isWithinBudget; //!< 使用メモリがbudget以内だったか
+		size_t peakWorkingSet; //!< 変換中のworking setの増加量の最大値 (byte). windowsでは変換前の最大値を超えなかった場合に大きめの値になる
+	};
+
+	//! @brief ObjStreamImporterによる変換時間と使用メモリを計測. 結果はLogにも出力
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名. WriteGridObjで生成した大きなファイルなど
+	//! @param[in] memoryBudget  使用メモリの上限 (byte)
+	//!
+	//! @return 計測結果を返却
+	StreamingImportResult StreamingImport(const std::string& directoryPath, const std::string& filename, size_t memoryBudget = ObjStreamImporter::kDefaultMemoryBudget);
+
+	//! @brief 計測用に格子状のobjファイルを生成 (四角形ポリゴン, v/vt/vn付き)
+	//!
+	//! @param[in] filePath    出力ファイルパス
+	//! @param[in] faceCount   四角形ポリゴン数の目安. 10'000'000 など
+	//! @param[in] objectCount "o"で分割する数
+	void WriteGridObj(const std::string& filePath, uint32_t faceCount, uint32_t objectCount = 1);
+
+	//! @brief "--benchmark-obj [--faces N] [--iterations N] [file]" を解析
+	//!
+	//! @param[in]  commandLine    コマンドライン引数
+	//! @param[out] filePath       計測するobjファイルパス. 空の場合はWriteGridObjで生成する
+	//! @param[out] faceCount      生成する格子の四角形ポリゴン数
+	//! @param[out] iterationCount 計測回数
+	//!
+	//! @retval true  計測の指定だった
+	//! @retval false 計測の指定ではない
+	bool ParseCommandLine(const std::string& commandLine, std::string& filePath, uint32_t& faceCount, uint32_t& iterationCount);
+
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "ModelLoader.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <exception>
+
+// engine
+#include <MeshBounds.h>
+#include <Logger.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief fallback用の一辺1の立方体. textureは使用しない
+	ModelRawData MakeFallbackRawData() {
+		ModelRawData result;
+
+		MeshRawData mesh;
+
+		// 面毎の法線と, 面上の二軸
+		const Vector3f normals[6] = {
+			{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f },
+		};
+
+		for (const auto& normal : normals) {
+			Vector3f u = { normal.y + normal.z, 0.0f, normal.x };
+			Vector3f v = Vector::Cross(normal, u);
+
+			uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+
+			for (uint32_t i = 0; i < 4; ++i) {
+				float s = (i == 1 || i == 2) ? 1.0f : -1.0f;
+				float t = (i >= 2) ? 1.0f : -1.0f;
+
+				Vector3f position = (normal + u * s + v * t) * 0.5f;
+
+				VertexData vertex;
+				vertex.position = { position.x, position.y, position.z, 1.0f };
+				vertex.texcoord = { (s + 1.0f) * 0.5f, (1.0f - t) * 0.5f };
+				vertex.normal   = normal;
+
+				mesh.vertices.push_back(vertex);
+			}
+
+			// 表面から見て時計回りになる順
+			const uint32_t order[6] = { 0, 1, 2, 0, 2, 3 };
+
+			for (uint32_t index : order) {
+				mesh.indices.push_back(base + index);
+			}
+		}
+
+		result.meshs.push_back(std::move(mesh));
+
+		MaterialData material;
+		material.color = { 0.5f, 0.5f, 0.5f, 1.0f };
+		result.materials.push_back(material);
+
+		MeshBounds::Compute(result);
+
+		return result;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelLoader class methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void ModelLoader::Init(uint32_t workerCount) {
+	fallback_ = std::make_unique<Model>(ModelMethods::CreateModelData(MakeFallbackRawData()));
+
+	isTerm_ = false;
+
+	for (uint32_t i = 0; i < (std::max)(workerCount, 1u); ++i) {
+		workers_.emplace_back(&ModelLoader::Worker, this);
+	}
+}
+
+void ModelLoader::Term() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isTerm_ = true;
+	}
+
+	condition_.notify_all();
+
+	for (auto& worker : workers_) {
+		worker.join();
+	}
+
+	workers_.clear();
+
+	requests_.clear();
+	completed_.clear();
+
+	fallback_.reset();
+}
+
+std::shared_ptr<ModelHandle> ModelLoader::LoadAsync(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat) {
+	assert(fallback_ != nullptr); //!< Init前に呼び出された
+
+	std::shared_ptr<ModelHandle> result = std::make_shared<ModelHandle>();
+	result->fallback_ = fallback_.get();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		Request request;
+		request.handle        = result;
+		request.directoryPath = directoryPath;
+		request.filename      = filename;
+		request.vertexFormat  = vertexFormat;
+
+		requests_.push_back(std::move(request));
+	}
+
+	condition_.notify_one();
+
+	return result;
+}
+
+void ModelLoader::Commit(uint32_t maxCount) {
+	uint32_t commitCount = 0;
+
+	while (commitCount < maxCount) {
+		Request request;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			if (completed_.empty()) {
+				return;
+			}
+
+			request = std::move(completed_.front());
+			completed_.pop_front();
+		}
+
+		if (request.handle.use_count() == 1) { //!< 読み込み中にhandleが破棄された
+			continue;
+		}
+
+		if (request.isFailed) {
+			request.handle->isFailed_ = true;
+			Log("[ModelLoader] failed to load: " + request.directoryPath + "/" + request.filename + " (" + request.rawData.error + ")\n");
+			continue;
+		}
+
+		request.handle->model_ = std::make_unique<Model>(ModelMethods::CreateModelData(std::move(request.rawData), request.vertexFormat));
+		++commitCount;
+	}
+}
+
+uint32_t ModelLoader::GetPendingCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return static_cast<uint32_t>(requests_.size() + completed_.size()) + workingCount_;
+}
+
+ModelLoader* ModelLoader::GetInstance() {
+	static ModelLoader instance;
+	return &instance;
+}
+
+void ModelLoader::Worker() {
+	while (true) {
+		Request request;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return isTerm_ || !requests_.empty(); });
+
+			if (isTerm_) {
+				return;
+			}
+
+			request = std::move(requests_.front());
+			requests_.pop_front();
+
+			++workingCount_;
+		}
+
+		if (request.handle.use_count() > 1) { //!< 読み込み前にhandleが破棄されていない
+			try {
+				if (ModelMethods::IsGlbFile(request.filename)) {
+					request.rawData = ModelMethods::ParseGlbFile(request.directoryPath, request.filename);
+
+					if (request.rawData.error.empty()) {
+						MeshletMethods::Build(request.rawData);
+					}
+
+				} else {
+					request.rawData = ModelMethods::CookObjFile(request.directoryPath, request.filename);
+				}
+
+			} catch (const std::exception& exception) { //!< 範囲外の頂点番号(std::out_of_range), 型の異なるjsonの値など
+				request.rawData       = {};
+				request.rawData.error = exception.what();
+			}
+
+			request.isFailed = !request.rawData.error.empty();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			completed_.push_back(std::move(request));
+			--workingCount_;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// model
+#include <Model.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelHandle class
+////////////////////////////////////////////////////////////////////////////////////////////
+class ModelHandle { //!< ModelLoader::LoadAsyncの結果. 読み込み完了まではfallbackを返す
+public:
+
+	//=========================================================================================
+	// public methods
+	//=========================================================================================
+
+	//! @brief GPUバッファの生成まで完了しているか
+	bool IsReady() const { return model_ != nullptr; }
+
+	//! @brief 読み込みに失敗したか. 失敗した場合はfallbackのまま
+	bool IsFailed() const { return isFailed_; }
+
+	//! @brief 描画に使うmodelを取得
+	//!
+	//! @return 読み込み完了後は読み込んだmodel, それまではfallbackのmodelを返却
+	Model* GetModel() const { return model_ != nullptr ? model_.get() : fallback_; }
+
+private:
+
+	//=========================================================================================
+	// private variables
+	//=========================================================================================
+
+	friend class ModelLoader;
+
+	std::unique_ptr<Model> model_;
+	Model*                 fallback_ = nullptr;
+	bool                   isFailed_ = false;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelLoader class
+////////////////////////////////////////////////////////////////////////////////////////////
+class ModelLoader {
+public:
+
+	//=========================================================================================
+	// public variables
+	//=========================================================================================
+
+	static const uint32_t kDefaultWorkerCount = 2; //!< 各workerの中でもParallel::Forで分割される
+	static const uint32_t kDefaultCommitCount = 4; //!< 1frameあたりにGPUバッファを生成するmodel数
+
+	//=========================================================================================
+	// public methods
+	//=========================================================================================
+
+	//! @brief 初期化処理. workerスレッドとfallbackのmodelを生成
+	//!
+	//! @param[in] workerCount workerスレッド数
+	void Init(uint32_t workerCount = kDefaultWorkerCount);
+
+	//! @brief 終了処理. 読み込み途中のrequestは破棄される
+	void Term();
+
+	//! @brief obj, glbファイルの読み込みをworkerスレッドに依頼
+	//!
+	//! parse, cookedファイルの読み書きはworkerスレッド, GPUバッファの生成はCommitで行う
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      obj, glbファイル名
+	//! @param[in] vertexFormat  GPUに置く頂点のformat
+	//!
+	//! @return 読み込み完了までfallbackを返すhandleを返却
+	std::shared_ptr<ModelHandle> LoadAsync(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
+
+	//! @brief workerスレッドの処理が終わったmodelのGPUバッファを生成. 描画スレッドから呼び出す
+	//!
+	//! @param[in] maxCount 生成するmodelの最大数
+	void Commit(uint32_t maxCount = kDefaultCommitCount);
+
+	//! @brief 読み込み途中のrequest数
+	uint32_t GetPendingCount();
+
+	Model* GetFallback() const { return fallback_.get(); }
+
+	static ModelLoader* GetInstance();
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Request structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Request {
+		std::shared_ptr<ModelHandle> handle;
+		std::string                  directoryPath;
+		std::string                  filename;
+		VertexFormat                 vertexFormat;
+		ModelRawData                 rawData;  //!< workerスレッドの処理結果
+		bool                         isFailed = false;
+	};
+
+	//=========================================================================================
+	// private variables
+	//=========================================================================================
+
+	std::vector<std::thread> workers_;
+
+	std::mutex              mutex_;
+	std::condition_variable condition_;
+	std::deque<Request>     requests_;  //!< workerスレッドの処理待ち
+	std::deque<Request>     completed_; //!< Commit待ち
+	uint32_t                workingCount_ = 0;
+	bool                    isTerm_       = false;
+
+	std::unique_ptr<Model> fallback_;
+
+	//=========================================================================================
+	// private methods
+	//=========================================================================================
+
+	void Worker();
+
+};
\ No newline at end of file
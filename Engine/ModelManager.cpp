@@ -0,0 +1,82 @@
+#include "ModelManager.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelManager class methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void ModelManager::Term() {
+	models_.clear();
+	handles_.clear();
+}
+
+std::shared_ptr<Model> ModelManager::LoadModel(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat) {
+	std::string key = GetKey(directoryPath, filename, vertexFormat);
+
+	auto it = models_.find(key);
+	if (it != models_.end()) { //!< 同一keyが見つかった場合
+		if (std::shared_ptr<Model> model = it->second.lock()) {
+			return model;
+		}
+	}
+
+	// 最後の参照が外れた時に登録も解除する
+	std::shared_ptr<Model> result(
+		new Model(directoryPath, filename, vertexFormat),
+		[this, key](Model* model) {
+			auto it = models_.find(key);
+
+			if (it != models_.end() && it->second.expired()) {
+				models_.erase(it);
+			}
+
+			delete model;
+		}
+	);
+
+	models_[key] = result;
+
+	return result;
+}
+
+std::shared_ptr<ModelHandle> ModelManager::LoadModelAsync(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat) {
+	std::string key = GetKey(directoryPath, filename, vertexFormat);
+
+	auto it = handles_.find(key);
+	if (it != handles_.end()) { //!< 同一keyが見つかった場合
+		if (std::shared_ptr<ModelHandle> handle = it->second.lock()) {
+			return handle;
+		}
+	}
+
+	std::shared_ptr<ModelHandle> result = ModelLoader::GetInstance()->LoadAsync(directoryPath, filename, vertexFormat);
+	handles_[key] = result;
+
+	// 破棄されたhandleの登録を整理
+	std::erase_if(handles_, [](const auto& pair) { return pair.second.expired(); });
+
+	return result;
+}
+
+std::string ModelManager::GetKey(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat) {
+	std::filesystem::path path = std::filesystem::weakly_canonical(std::filesystem::path(directoryPath) / filename);
+
+	std::string result = path.lexically_normal().generic_string();
+
+	// windowsのファイルパスは大文字, 小文字を区別しない
+	std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	return result + "|" + std::to_string(static_cast<int32_t>(vertexFormat));
+}
+
+ModelManager* ModelManager::GetInstance() {
+	static ModelManager instance;
+	return &instance;
+}
\ No newline at end of file
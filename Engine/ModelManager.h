@@ -0,0 +1,72 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <unordered_map>
+#include <memory>
+
+// model
+#include <Model.h>
+#include <ModelLoader.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelManager class
+////////////////////////////////////////////////////////////////////////////////////////////
+class ModelManager { //!< 同じファイル, vertexFormatのmodelを共有する
+public:
+
+	//=========================================================================================
+	// public methods
+	//=========================================================================================
+
+	//! @brief 終了処理. 登録を解除するのみで, 参照中のmodelは最後の参照が外れた時に解放される
+	void Term();
+
+	//! @brief modelを読み込み, 共有の参照を取得. 読み込み済みの場合はparse, GPUバッファの生成を行わない
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] vertexFormat  GPUに置く頂点のformat
+	//!
+	//! @return modelの参照を返却. 全ての参照が破棄された時にmodelを解放
+	std::shared_ptr<Model> LoadModel(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
+
+	//! @brief ModelLoader::LoadAsyncの共有版. 読み込み中, 読み込み済みのhandleがあればそれを返す
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] vertexFormat  GPUに置く頂点のformat
+	//!
+	//! @return handleの参照を返却
+	std::shared_ptr<ModelHandle> LoadModelAsync(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat = VERTEX_FORMAT_DEFAULT);
+
+	//! @brief 登録されているmodel数 (LoadModelとLoadModelAsyncの合計)
+	uint32_t GetModelCount() const { return static_cast<uint32_t>(models_.size() + handles_.size()); }
+
+	//! @brief 共有に使うkeyを取得
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] vertexFormat  GPUに置く頂点のformat
+	//!
+	//! @return 正規化した絶対パスとvertexFormatからなるkeyを返却
+	static std::string GetKey(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat);
+
+	static ModelManager* GetInstance();
+
+private:
+
+	//=========================================================================================
+	// private variables
+	//=========================================================================================
+
+	std::unordered_map<std::string, std::weak_ptr<Model>> models_;
+	//!< key = GetKey, value = 参照中のmodel
+
+	std::unordered_map<std::string, std::weak_ptr<ModelHandle>> handles_;
+	//!< key = GetKey, value = 参照中のhandle
+
+};
\ No newline at end of file
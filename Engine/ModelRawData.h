@@ -0,0 +1,83 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// structure
+#include <ObjectStructure.h>
+
+// lib
+#include <Collider.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MaterialData structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct MaterialData {
+	std::string textureFilePath; //!< map_Kd
+	bool        isUseTexture = false;
+
+	Vector4f color   = { 1.0f, 1.0f, 1.0f, 1.0f }; //!< rgb: Kd, a: d
+	float    specPow = 0.0f;                       //!< Ns
+
+	std::string normalFilePath; //!< map_Bump
+	bool        isUseNormalMap = false;
+
+	Matrix4x4 uvTransform = Matrix4x4::MakeIdentity(); //!< textureがatlasに含まれる場合のuvの変換. Model::Initで設定し, cookedファイルには書き込まない. 描画ではModel::GetUvTransformで掛ける
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Meshlet structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct Meshlet { //!< indexの連続した範囲. cookedファイルにそのまま書き込むのでPODのまま
+	Vector3f center;     //!< 境界球
+	float    radius;
+	Vector3f coneAxis;   //!< 三角形の法線の平均方向
+	float    coneCutoff; //!< sin(coneの半角). 1.0fの場合はback-face cullingしない
+
+	uint32_t indexOffset;
+	uint32_t indexCount;
+	uint32_t vertexCount; //!< meshlet内で参照しているunique頂点数
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshLod structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct MeshLod { //!< 詳細度一段分のindex範囲. 頂点は全LODで共有
+	uint32_t indexOffset;
+	uint32_t indexCount;
+	float    error; //!< LOD0からの誤差 (model空間の距離)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MeshRawData structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct MeshRawData { //!< GPUに転送する前のCPU側mesh
+	std::vector<VertexData> vertices;
+	std::vector<uint32_t>   indices;
+	std::vector<Meshlet>    meshlets; //!< LOD0のmeshlet. 空の場合はmesh全体を一度に描画
+	std::vector<MeshLod>    lods;     //!< 空の場合はindices全体がLOD0
+
+	AABB   aabb   = {}; //!< model空間の境界. MeshBounds::Computeで計算
+	Sphere sphere = {};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ModelRawData structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct ModelRawData {
+	std::vector<MeshRawData>  meshs;
+	std::vector<MaterialData> materials;
+	// meshsとmaterialsのsizeは同じ
+
+	std::string mtlFilename; //!< objが参照しているmtlファイル名
+
+	std::string error; //!< 読み込みに失敗した理由. 空の場合は成功. 失敗した場合meshs, materialsは空
+
+	AABB   aabb   = {}; //!< 全meshの境界
+	Sphere sphere = {};
+};
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <DirectXCommon.h>
 #include <ImGuiManager.h>
 #include <TextureManager.h>
+#include <ModelLoader.h>
+#include <ModelManager.h>
 
 #include <ComPtr.h>
 
@@ -27,6 +29,8 @@ namespace {
 	DirectXCommon* sDirectXCommon = nullptr;   //!< DirectX12 system
 	ImGuiManager* sImGuiManager = nullptr;     //!< ImGui system
 	TextureManager* sTextureManager = nullptr; //!< TextureManager system
+	ModelLoader* sModelLoader = nullptr;       //!< ModelLoader system
+	ModelManager* sModelManager = nullptr;     //!< ModelManager system
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -71,9 +75,26 @@ void MyEngine::Initialize(int32_t kWindowWidth, int32_t kWindowHeight, const cha
 		sTextureManager = TextureManager::GetInstance();
 		sTextureManager->Init(sDirectXCommon);
 	}
+
+	// ModelLoader の初期化
+	{
+		sModelLoader = ModelLoader::GetInstance();
+		sModelLoader->Init();
+	}
+
+	// ModelManager の初期化
+	{
+		sModelManager = ModelManager::GetInstance();
+	}
 }
 
 void MyEngine::Finalize() {
+	sModelManager->Term();
+	sModelManager = nullptr;
+
+	sModelLoader->Term();
+	sModelLoader = nullptr;
+
 	sTextureManager->Term();
 	sTextureManager = nullptr;
 
@@ -91,6 +112,14 @@ void MyEngine::Finalize() {
 
 void MyEngine::BeginFrame() {
 	ExecutionSpeed::Begin();
+
+	// 読み込みが終わったmodelのGPUバッファ, textureのresourceを生成. 転送はframeの記録前にcommandListへ積む
+	sModelLoader->Commit();
+	sTextureManager->Commit();
+
+	// textureの予算を超えた分を縮小. 使われなくなったtextureから解放する
+	sTextureManager->UpdateResidency();
+
 	sDirectXCommon->BeginFrame();
 	sImGuiManager->Begin();
 }
@@ -113,6 +142,10 @@ void MyEngine::SetBlendMode(BlendMode mode) {
 	sDirectXCommon->SetBlendMode(mode);
 }
 
+void MyEngine::SetVertexFormat(VertexFormat format) {
+	sDirectXCommon->SetVertexFormat(format);
+}
+
 void MyEngine::SetPipelineState() {
 	sDirectXCommon->SetPipelineState();
 }
@@ -137,6 +170,16 @@ TextureManager* MyEngine::GetTextureManager() {
 	return sTextureManager;
 }
 
+ModelLoader* MyEngine::GetModelLoader() {
+	assert(sModelLoader != nullptr);
+	return sModelLoader;
+}
+
+ModelManager* MyEngine::GetModelManager() {
+	assert(sModelManager != nullptr);
+	return sModelManager;
+}
+
 const D3D12_GPU_DESCRIPTOR_HANDLE& MyEngine::GetTextureHandleGPU(const std::string& textureKey) {
 	assert(sTextureManager != nullptr);
 	return sTextureManager->GetHandleGPU(textureKey);
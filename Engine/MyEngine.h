@@ -23,6 +23,8 @@ namespace Sxavenger {
 //-----------------------------------------------------------------------------------------
 class DirectXCommon;
 class TextureManager;
+class ModelLoader;
+class ModelManager;
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // MyEngine class
@@ -62,6 +64,8 @@ public:
 
 	static void SetBlendMode(BlendMode mode);
 
+	static void SetVertexFormat(VertexFormat format);
+
 	static void SetPipelineState();
 
 	// TODO: あんましたくない
@@ -72,6 +76,10 @@ public:
 
 	static TextureManager* GetTextureManager();
 
+	static ModelLoader* GetModelLoader();
+
+	static ModelManager* GetModelManager();
+
 	static const D3D12_GPU_DESCRIPTOR_HANDLE& GetTextureHandleGPU(const std::string& textureKey);
 
 	//=========================================================================================
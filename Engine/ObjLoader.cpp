@@ -0,0 +1,948 @@
+#include "ObjLoader.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <charconv>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+
+// engine
+#include <MappedFile.h>
+#include <VertexDedupTable.h>
+#include <MaterialLibrary.h>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//-----------------------------------------------------------------------------------------
+	// faceの種類
+	//-----------------------------------------------------------------------------------------
+	enum FaceType {
+		v, vt, vn,
+
+		kFaceTypeCount
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// scanner用定数
+	//-----------------------------------------------------------------------------------------
+	//! floatで誤差なく表現できる10の累乗 (5^10 < 2^24)
+	constexpr float kPow10f[] = {
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+	};
+
+	constexpr int      kMaxFastExponent = 10;
+	constexpr uint64_t kMaxFastMantissa = 1ull << 24; //!< floatの仮数部で誤差なく表現できる最大値
+	constexpr uint64_t kMantissaLimit   = 100000000000000000ull; //!< uint64_tがoverflowしない桁数
+
+	bool IsDigit(char c) {
+		return static_cast<unsigned char>(c - '0') < 10;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// error
+	//-----------------------------------------------------------------------------------------
+	constexpr char kErrorPolygon[] = "face with fewer than 3 vertices"; //!< ポリゴンの頂点数の不足
+
+	//! @brief 読み込み失敗の結果を作成
+	ModelRawData MakeFailed(const std::string& error) {
+		ModelRawData result;
+		result.error = error;
+		return result;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// parallel parse用
+	//-----------------------------------------------------------------------------------------
+	constexpr size_t kMinChunkSize = 1 << 20; //!< これ以下のファイルは分割しない
+
+	//-----------------------------------------------------------------------------------------
+	// dedup用
+	//-----------------------------------------------------------------------------------------
+	//! face数見積もりの上限. 複数objectのファイルで過剰に確保しないよう制限
+	constexpr size_t kMaxFaceEstimate = 1 << 18;
+
+	//! @brief 残りbyte数と一行の長さからface数を見積もる. 残りが全て同じ長さの"f"行と仮定
+	size_t EstimateFaceCount(const char* lineBegin, const char* lineEnd, const char* end) {
+		size_t lineSize = static_cast<size_t>(lineEnd - lineBegin) + 1;
+		return (std::min)(static_cast<size_t>(end - lineBegin) / lineSize + 1, kMaxFaceEstimate);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ObjSegment structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ObjSegment { //!< chunk内を"o"で区切った範囲
+		bool     isObject      = false; //!< "o"から始まるか. chunk先頭のsegmentはfalse
+		uint32_t positionCount = 0;     //!< segment内の"v"数
+
+		bool        isMtllib = false;
+		std::string mtllib;
+		bool        isUsemtl = false;
+		std::string usemtl;
+
+		std::vector<FaceKey>  keys;    //!< segment内でuniqueな頂点 (出現順)
+		std::vector<uint32_t> indices; //!< keysの番号. 三角形分割済み
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ObjChunk structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ObjChunk { //!< 行境界で分割したファイルの一部
+		std::vector<Vector4f>   positions;
+		std::vector<Vector2f>   texcoords;
+		std::vector<Vector3f>   normals;
+		std::vector<ObjSegment> segments;
+
+		bool isFailed = false; //!< 未対応のfaceがあった. 以降はparseしない
+	};
+
+	//! @brief chunk一つ分のparse. face番号はファイル全体での番号のまま保存
+	void ParseChunk(const char* ptr, const char* end, ObjChunk& chunk) {
+		using namespace ObjLoader;
+
+		chunk.segments.emplace_back();
+		ObjSegment* segment = &chunk.segments.back();
+
+		VertexDedupTable faces; //!< segment内の重複確認
+
+		while (ptr < end) {
+			const char* lineBegin = ptr;
+			const char* lineEnd   = static_cast<const char*>(std::memchr(ptr, '\n', static_cast<size_t>(end - ptr)));
+			if (lineEnd == nullptr) {
+				lineEnd = end;
+			}
+
+			std::string_view identifire = ReadToken(ptr, lineEnd);
+
+			if (identifire == "mtllib") {
+				segment->isMtllib = true;
+				segment->mtllib   = ReadToken(ptr, lineEnd);
+
+			} else if (identifire == "o") {
+				chunk.segments.emplace_back();
+				segment = &chunk.segments.back();
+				segment->isObject = true;
+
+				faces.Clear();
+
+			} else if (identifire == "v") {
+				segment->positionCount++;
+
+				Vector4f position;
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, position.x);
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, position.y);
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, position.z);
+				position.w = 1.0f;
+
+				// 左手座標に変換
+				position.z *= -1;
+
+				chunk.positions.push_back(position);
+
+			} else if (identifire == "vt") {
+				Vector2f texcoord;
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, texcoord.x);
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, texcoord.y);
+
+				// 左手座標に変換
+				texcoord.y = 1.0f - texcoord.y;
+
+				chunk.texcoords.push_back(texcoord);
+
+			} else if (identifire == "vn") {
+				Vector3f normal;
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, normal.x);
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, normal.y);
+				ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, normal.z);
+
+				// 左手座標に変換
+				normal.z *= -1;
+
+				chunk.normals.push_back(normal);
+
+			} else if (identifire == "usemtl") {
+				segment->isUsemtl = true;
+				segment->usemtl   = ReadToken(ptr, lineEnd);
+
+			} else if (identifire == "f") {
+				if (segment->keys.empty()) { //!< segment最初のfaceでテーブルを確保
+					faces.Reserve(EstimateFaceCount(lineBegin, lineEnd, end));
+				}
+
+				uint32_t cornerIndex[4] = {};
+				int vertexNum = 0;
+
+				for (int i = 0; i < 4; ++i) {
+					std::string_view faceString = ReadToken(ptr, lineEnd);
+
+					if (faceString.empty()) {
+						break;
+					}
+
+					vertexNum++;
+
+					FaceKey key = ParseFaceKey(faceString);
+
+					bool isInserted = false;
+					cornerIndex[i] = faces.FindOrInsert(key, static_cast<uint32_t>(segment->keys.size()), isInserted);
+
+					if (isInserted) {
+						segment->keys.push_back(key);
+					}
+				}
+
+				if (vertexNum == 3) { //!< 三角形ポリゴンの場合
+					segment->indices.push_back(cornerIndex[2]);
+					segment->indices.push_back(cornerIndex[1]);
+					segment->indices.push_back(cornerIndex[0]);
+
+				} else if (vertexNum == 4) { //!< 四角形ポリゴンの場合
+					segment->indices.push_back(cornerIndex[0]);
+					segment->indices.push_back(cornerIndex[3]);
+					segment->indices.push_back(cornerIndex[1]);
+
+					segment->indices.push_back(cornerIndex[3]);
+					segment->indices.push_back(cornerIndex[2]);
+					segment->indices.push_back(cornerIndex[1]);
+
+				} else { //!< ポリゴンの頂点数の不足
+					chunk.isFailed = true;
+					return;
+				}
+			}
+
+			ptr = (lineEnd < end) ? lineEnd + 1 : end;
+		}
+	}
+
+	//! @brief chunk毎の配列を一つに連結
+	template <typename T>
+	std::vector<T> ConcatChunks(const std::vector<ObjChunk>& chunks, std::vector<T> ObjChunk::* member) {
+		size_t size = 0;
+		for (const auto& chunk : chunks) {
+			size += (chunk.*member).size();
+		}
+
+		std::vector<T> result;
+		result.reserve(size);
+
+		for (const auto& chunk : chunks) {
+			result.insert(result.end(), (chunk.*member).begin(), (chunk.*member).end());
+		}
+
+		return result;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ObjLoader namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+
+ModelRawData ObjLoader::ParseStream(const std::string& directoryPath, const std::string& filename) {
+	ModelRawData result;
+
+	std::string mtlFilename;
+	MaterialData materialData = {};
+
+	std::string line;
+
+	// VertexDataの一時保存
+	std::vector<Vector4f> positions;
+	std::vector<Vector2f> texcoords;
+	std::vector<Vector3f> normals;
+
+	MeshRawData mesh; // vertices, indicesに書き込み
+
+	// vertexdata
+	uint32_t vertexDataIndexCount = 0;
+	std::unordered_map<std::string, uint32_t> faces; // key: f "1/2/3", value: vertexDataの配列数
+
+	// vertexDataIndexの調整
+	uint32_t currentIndex[kFaceTypeCount] = { 0, 0, 0 };
+	uint32_t startIndex[kFaceTypeCount] = { 1, 1, 1 };
+
+	// mesh一つ分の書き込みが終わったので保存
+	auto pushMesh = [&]() {
+		// meshとmaterialをmodelDataに格納
+		result.meshs.push_back(std::move(mesh));
+		result.materials.push_back(std::move(materialData));
+
+		// 書き込みが終了したのでデータ初期化
+		for (int i = 0; i < kFaceTypeCount; ++i) {
+			// startIndexの更新
+			startIndex[i] += currentIndex[i];
+			currentIndex[i] = 0;
+		}
+
+		// データの初期化
+		positions.clear();
+		texcoords.clear();
+		normals.clear();
+
+		mesh = {};
+
+		faces.clear();
+		vertexDataIndexCount = 0;
+	};
+
+	// Objファイルを開く
+	std::ifstream file(directoryPath + "/" + filename);
+	if (!file.is_open()) { //!< fileが見つからなかった.
+		return MakeFailed("file not found: " + directoryPath + "/" + filename);
+	}
+
+	while (std::getline(file, line)) { // fileから一列ずつ読み込み
+		std::string identifire; // 識別子
+		std::istringstream s(line);
+		s >> identifire;
+
+		if (identifire == "mtllib") { //!< マテリアルファイル名
+			s >> mtlFilename; // ファイルnameの保存
+
+		} else if (identifire == "o") {
+			if (!positions.empty()) { //!< 二回目以降の"o"の場合
+				pushMesh();
+			}
+
+		} else if (identifire == "v") { //!< vertex
+			currentIndex[v]++;
+
+			// positionに書き込み
+			Vector4f position;
+			s >> position.x >> position.y >> position.z;
+			position.w = 1.0f;
+
+			// 左手座標に変換
+			position.z *= -1;
+
+			// vectorに保存
+			positions.push_back(position);
+
+		} else if (identifire == "vt") { //!< texcoord
+			currentIndex[vt]++;
+
+			// texcoordに書き込み
+			Vector2f texcoord;
+			s >> texcoord.x >> texcoord.y;
+
+			// 左手座標に変換
+			texcoord.y = 1.0f - texcoord.y;
+
+			// vectorに保存
+			texcoords.push_back(texcoord);
+
+		} else if (identifire == "vn") { //!< normal
+			currentIndex[vn]++;
+
+			// normalに書き込み
+			Vector3f normal;
+			s >> normal.x >> normal.y >> normal.z;
+
+			// 左手座標に変換
+			normal.z *= -1;
+
+			// vectorに保存
+			normals.push_back(normal);
+
+		} else if (identifire == "usemtl") { //!< materialの使用名
+			std::string usemtl;
+			s >> usemtl;
+
+			materialData = ObjLoader::LoadMaterial(directoryPath, mtlFilename, usemtl);
+
+		} else if (identifire == "f") { //!< face 四角形ポリゴンに対応
+			// (f) "1/2/3", "4/5/6", "7/8/9" ... と読み込む
+			std::string faceStrings[4];
+			s >> faceStrings[0] >> faceStrings[1] >> faceStrings[2] >> faceStrings[3];
+
+			// vertexdata
+			int vertexNum = 0;
+
+			for (uint32_t i = 0; i < 4; ++i) {
+				if (faceStrings[i] == "") { // 三角形ポリゴンなので i = 2 に break
+					break;
+				}
+
+				// 頂点数を増加
+				vertexNum++;
+
+				// facesにすでにvertexdataがあるか確認
+				auto it = faces.find(faceStrings[i]);
+				if (it == faces.end()) { // ない場合, vertexdataの生成
+
+					// faceStringからface番号を取得
+					uint32_t faceNum[3] = { 0, 0, 0 };
+
+					std::istringstream indexs(faceStrings[i]);
+
+					for (int fi = 0; fi < 3; ++fi) {
+						std::string index;
+						std::getline(indexs, index, '/');
+
+						if (index != "") {
+							faceNum[fi] = std::stoi(index);
+						}
+					}
+
+					// 各データの取り出し
+					Vector4f position;
+					position = positions.at(faceNum[v] - startIndex[v]);
+
+					Vector2f texcoord = { 0.0f, 0.0f };
+					if (faceNum[vt] != 0) {
+						texcoord = texcoords.at(faceNum[vt] - startIndex[vt]);
+					}
+
+					Vector3f normal;
+					normal = normals.at(faceNum[vn] - startIndex[vn]);
+
+					// vertexdataの生成
+					VertexData vertexData = {
+						position,
+						texcoord,
+						normal,
+					};
+
+					mesh.vertices.push_back(vertexData);
+
+					// facesにindex数の保存
+					faces[faceStrings[i]] = vertexDataIndexCount;
+					vertexDataIndexCount++;
+				}
+			}
+
+			// indexdataの作成
+			if (vertexNum == 3) { //!< 三角形ポリゴンの場合
+				// 逆順にfacesでvertexIndexを問い合わせながらindexDetasに代入
+				for (uint32_t i = vertexNum; i > 0; --i) {
+					mesh.indices.push_back(faces[faceStrings[i - 1]]);
+				}
+
+			} else if (vertexNum == 4) { //!< 四角形ポリゴンの場合
+				// 三角形ポリゴンに変換
+				// polygonA
+				mesh.indices.push_back(faces[faceStrings[0]]);
+				mesh.indices.push_back(faces[faceStrings[3]]);
+				mesh.indices.push_back(faces[faceStrings[1]]);
+
+				// polygonB
+				mesh.indices.push_back(faces[faceStrings[3]]);
+				mesh.indices.push_back(faces[faceStrings[2]]);
+				mesh.indices.push_back(faces[faceStrings[1]]);
+
+			} else { //!< ポリゴンの頂点数の不足
+				return MakeFailed(kErrorPolygon);
+			}
+		}
+	}
+
+	file.close();
+
+	// fileが終わったので最後のやつを保存
+	if (!positions.empty()) {
+		pushMesh();
+	}
+
+	result.mtlFilename = mtlFilename;
+
+	return result;
+}
+
+ModelRawData ObjLoader::ParseMapped(const std::string& directoryPath, const std::string& filename) {
+	ModelRawData result;
+
+	std::string mtlFilename;
+	MaterialData materialData = {};
+
+	std::shared_ptr<const MaterialTable> materialTable; //!< 最初の"usemtl"で読み込み
+
+	// VertexDataの一時保存
+	std::vector<Vector4f> positions;
+	std::vector<Vector2f> texcoords;
+	std::vector<Vector3f> normals;
+
+	MeshRawData mesh; // vertices, indicesに書き込み
+
+	// key: f "1/2/3" の番号, value: verticesの配列数
+	VertexDedupTable faces;
+
+	// vertexDataIndexの調整
+	uint32_t currentIndex[kFaceTypeCount] = { 0, 0, 0 };
+	uint32_t startIndex[kFaceTypeCount] = { 1, 1, 1 };
+
+	// mesh一つ分の書き込みが終わったので保存
+	auto pushMesh = [&]() {
+		result.meshs.push_back(std::move(mesh));
+		result.materials.push_back(std::move(materialData));
+
+		for (int i = 0; i < kFaceTypeCount; ++i) {
+			startIndex[i] += currentIndex[i];
+			currentIndex[i] = 0;
+		}
+
+		positions.clear();
+		texcoords.clear();
+		normals.clear();
+
+		mesh = {};
+
+		faces.Clear();
+	};
+
+	// Objファイルをマッピング
+	MappedFile file(directoryPath + "/" + filename);
+	if (!file.IsOpen()) { //!< fileが見つからなかった.
+		return MakeFailed("file not found: " + directoryPath + "/" + filename);
+	}
+
+	const char* ptr = file.GetData();
+	const char* end = ptr + file.GetSize();
+
+	while (ptr < end) {
+		// 一列分の範囲を取得
+		const char* lineBegin = ptr;
+		const char* lineEnd   = static_cast<const char*>(std::memchr(ptr, '\n', static_cast<size_t>(end - ptr)));
+		if (lineEnd == nullptr) {
+			lineEnd = end;
+		}
+
+		std::string_view identifire = ReadToken(ptr, lineEnd); // 識別子
+
+		if (identifire == "mtllib") { //!< マテリアルファイル名
+			mtlFilename = ReadToken(ptr, lineEnd);
+			materialTable.reset();
+
+		} else if (identifire == "o") {
+			if (!positions.empty()) { //!< 二回目以降の"o"の場合
+				pushMesh();
+			}
+
+		} else if (identifire == "v") { //!< vertex
+			currentIndex[v]++;
+
+			Vector4f position;
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, position.x);
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, position.y);
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, position.z);
+			position.w = 1.0f;
+
+			// 左手座標に変換
+			position.z *= -1;
+
+			positions.push_back(position);
+
+		} else if (identifire == "vt") { //!< texcoord
+			currentIndex[vt]++;
+
+			Vector2f texcoord;
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, texcoord.x);
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, texcoord.y);
+
+			// 左手座標に変換
+			texcoord.y = 1.0f - texcoord.y;
+
+			texcoords.push_back(texcoord);
+
+		} else if (identifire == "vn") { //!< normal
+			currentIndex[vn]++;
+
+			Vector3f normal;
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, normal.x);
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, normal.y);
+			ptr = ParseFloat(SkipSpace(ptr, lineEnd), lineEnd, normal.z);
+
+			// 左手座標に変換
+			normal.z *= -1;
+
+			normals.push_back(normal);
+
+		} else if (identifire == "usemtl") { //!< materialの使用名
+			std::string usemtl(ReadToken(ptr, lineEnd));
+
+			if (materialTable == nullptr) {
+				materialTable = MaterialLibrary::Load(directoryPath, mtlFilename);
+			}
+
+			materialData = MaterialLibrary::Find(*materialTable, usemtl);
+
+		} else if (identifire == "f") { //!< face 四角形ポリゴンに対応
+			if (mesh.indices.empty()) { //!< mesh最初のfaceでテーブルを確保
+				faces.Reserve(EstimateFaceCount(lineBegin, lineEnd, end));
+			}
+
+			uint32_t cornerIndex[4] = {};
+			int vertexNum = 0;
+
+			for (int i = 0; i < 4; ++i) {
+				std::string_view faceString = ReadToken(ptr, lineEnd);
+
+				if (faceString.empty()) { // 三角形ポリゴンなので i = 3 で break
+					break;
+				}
+
+				vertexNum++;
+
+				// faceStringからface番号を取得 "v/vt/vn", "v//vn"
+				FaceKey key = ParseFaceKey(faceString);
+
+				// facesにすでにvertexdataがあるか確認
+				bool isInserted = false;
+				cornerIndex[i] = faces.FindOrInsert(key, static_cast<uint32_t>(mesh.vertices.size()), isInserted);
+
+				if (!isInserted) {
+					continue;
+				}
+
+				// 各データの取り出し
+				Vector2f texcoord = { 0.0f, 0.0f };
+				if (key.vt != 0) {
+					texcoord = texcoords.at(key.vt - startIndex[vt]);
+				}
+
+				VertexData vertexData = {
+					positions.at(key.v - startIndex[v]),
+					texcoord,
+					normals.at(key.vn - startIndex[vn]),
+				};
+
+				mesh.vertices.push_back(vertexData);
+			}
+
+			// indexdataの作成
+			if (vertexNum == 3) { //!< 三角形ポリゴンの場合
+				// 逆順に代入
+				mesh.indices.push_back(cornerIndex[2]);
+				mesh.indices.push_back(cornerIndex[1]);
+				mesh.indices.push_back(cornerIndex[0]);
+
+			} else if (vertexNum == 4) { //!< 四角形ポリゴンの場合
+				// polygonA
+				mesh.indices.push_back(cornerIndex[0]);
+				mesh.indices.push_back(cornerIndex[3]);
+				mesh.indices.push_back(cornerIndex[1]);
+
+				// polygonB
+				mesh.indices.push_back(cornerIndex[3]);
+				mesh.indices.push_back(cornerIndex[2]);
+				mesh.indices.push_back(cornerIndex[1]);
+
+			} else { //!< ポリゴンの頂点数の不足
+				return MakeFailed(kErrorPolygon);
+			}
+		}
+
+		// 次の列へ
+		ptr = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	// fileが終わったので最後のやつを保存
+	if (!positions.empty()) {
+		pushMesh();
+	}
+
+	result.mtlFilename = mtlFilename;
+
+	return result;
+}
+
+ModelRawData ObjLoader::ParseParallel(const std::string& directoryPath, const std::string& filename, uint32_t threadCount) {
+	ModelRawData result;
+
+	// Objファイルをマッピング
+	MappedFile file(directoryPath + "/" + filename);
+	if (!file.IsOpen()) { //!< fileが見つからなかった.
+		return MakeFailed("file not found: " + directoryPath + "/" + filename);
+	}
+
+	const char* data = file.GetData();
+	size_t      size = file.GetSize();
+
+	if (threadCount == 0) {
+		threadCount = Parallel::GetThreadCount();
+	}
+
+	// 行境界でchunkに分割
+	size_t chunkCount = (std::max)(static_cast<size_t>(1), (std::min)(size / kMinChunkSize, static_cast<size_t>(threadCount) * 4));
+
+	std::vector<const char*> boundaries(chunkCount + 1);
+	boundaries.front() = data;
+	boundaries.back()  = data + size;
+
+	for (size_t i = 1; i < chunkCount; ++i) {
+		const char* ptr = (std::max)(data + size * i / chunkCount, boundaries[i - 1]);
+		const char* lineEnd = static_cast<const char*>(std::memchr(ptr, '\n', static_cast<size_t>(data + size - ptr)));
+
+		boundaries[i] = (lineEnd != nullptr) ? lineEnd + 1 : data + size;
+	}
+
+	// chunk毎にparse
+	std::vector<ObjChunk> chunks(chunkCount);
+
+	Parallel::For(static_cast<uint32_t>(chunkCount), [&](uint32_t index) {
+		ParseChunk(boundaries[index], boundaries[index + 1], chunks[index]);
+	}, threadCount);
+
+	if (std::any_of(chunks.begin(), chunks.end(), [](const ObjChunk& chunk) { return chunk.isFailed; })) {
+		return MakeFailed(kErrorPolygon);
+	}
+
+	// ファイル全体の番号で参照できるように連結
+	std::vector<Vector4f> positions = ConcatChunks(chunks, &ObjChunk::positions);
+	std::vector<Vector2f> texcoords = ConcatChunks(chunks, &ObjChunk::texcoords);
+	std::vector<Vector3f> normals   = ConcatChunks(chunks, &ObjChunk::normals);
+
+	// segmentを順番に結合. 直列parseと同じ順番でmeshを組み立てる
+	std::string  mtlFilename;
+	MaterialData materialData = {};
+
+	std::shared_ptr<const MaterialTable> materialTable; //!< 最初の"usemtl"で読み込み
+
+	MeshRawData      mesh;
+	VertexDedupTable faces;
+	uint32_t positionCount = 0; //!< 前回のmesh保存からの"v"数
+
+	auto pushMesh = [&]() {
+		result.meshs.push_back(std::move(mesh));
+		result.materials.push_back(std::move(materialData));
+
+		mesh = {};
+		faces.Clear();
+		positionCount = 0;
+	};
+
+	std::vector<uint32_t> remap;
+
+	for (auto& chunk : chunks) {
+		for (auto& segment : chunk.segments) {
+			if (segment.isObject && positionCount != 0) { //!< 二回目以降の"o"の場合
+				pushMesh();
+			}
+
+			positionCount += segment.positionCount;
+
+			if (segment.isMtllib) {
+				mtlFilename = segment.mtllib;
+				materialTable.reset();
+			}
+
+			if (segment.isUsemtl) {
+				if (materialTable == nullptr) {
+					materialTable = MaterialLibrary::Load(directoryPath, mtlFilename);
+				}
+
+				materialData = MaterialLibrary::Find(*materialTable, segment.usemtl);
+			}
+
+			// segment内の頂点番号をmesh内の番号に変換
+			remap.resize(segment.keys.size());
+			faces.Reserve(faces.GetSize() + segment.keys.size());
+
+			for (size_t k = 0; k < segment.keys.size(); ++k) {
+				const FaceKey& key = segment.keys[k];
+
+				bool isInserted = false;
+				remap[k] = faces.FindOrInsert(key, static_cast<uint32_t>(mesh.vertices.size()), isInserted);
+
+				if (isInserted) {
+					Vector2f texcoord = { 0.0f, 0.0f };
+					if (key.vt != 0) {
+						texcoord = texcoords.at(key.vt - 1);
+					}
+
+					VertexData vertexData = {
+						positions.at(key.v - 1),
+						texcoord,
+						normals.at(key.vn - 1),
+					};
+
+					mesh.vertices.push_back(vertexData);
+				}
+			}
+
+			mesh.indices.reserve(mesh.indices.size() + segment.indices.size());
+
+			for (uint32_t index : segment.indices) {
+				mesh.indices.push_back(remap[index]);
+			}
+
+			// 使い終わったsegmentの解放
+			segment = {};
+		}
+	}
+
+	// fileが終わったので最後のやつを保存
+	if (positionCount != 0) {
+		pushMesh();
+	}
+
+	result.mtlFilename = mtlFilename;
+
+	return result;
+}
+
+MaterialData ObjLoader::LoadMaterial(const std::string& directoryPath, const std::string& filename, const std::string& usemtl) {
+	return MaterialLibrary::Find(*MaterialLibrary::Load(directoryPath, filename), usemtl);
+}
+
+const char* ObjLoader::ParseUInt(const char* ptr, const char* end, uint32_t& value) {
+	value = 0;
+
+	while (ptr < end && IsDigit(*ptr)) {
+		value = value * 10 + static_cast<uint32_t>(*ptr - '0');
+		++ptr;
+	}
+
+	return ptr;
+}
+
+const char* ObjLoader::ParseFloat(const char* ptr, const char* end, float& value) {
+	const char* begin = ptr;
+
+	// 符号
+	bool isNegative = false;
+	if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+		isNegative = (*ptr == '-');
+		++ptr;
+	}
+
+	const char* digitBegin = ptr;
+
+	uint64_t mantissa    = 0;
+	int      exponent    = 0;
+	bool     isTruncated = false; //!< 桁数がkMantissaLimitを超えたか
+	bool     isDigit     = false;
+
+	// 整数部
+	while (ptr < end && IsDigit(*ptr)) {
+		if (mantissa < kMantissaLimit) {
+			mantissa = mantissa * 10 + static_cast<uint64_t>(*ptr - '0');
+
+		} else {
+			exponent++;
+			isTruncated = true;
+		}
+
+		isDigit = true;
+		++ptr;
+	}
+
+	// 小数部
+	if (ptr < end && *ptr == '.') {
+		++ptr;
+
+		while (ptr < end && IsDigit(*ptr)) {
+			if (mantissa < kMantissaLimit) {
+				mantissa = mantissa * 10 + static_cast<uint64_t>(*ptr - '0');
+				exponent--;
+
+			} else {
+				isTruncated = true;
+			}
+
+			isDigit = true;
+			++ptr;
+		}
+	}
+
+	if (!isDigit) { //!< 数値ではない ("inf", "nan" など)
+		auto [last, ec] = std::from_chars(digitBegin, end, value);
+
+		if (ec != std::errc()) {
+			value = 0.0f;
+			return begin;
+		}
+
+		value = isNegative ? -value : value;
+		return last;
+	}
+
+	// 指数部
+	if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+		const char* exponentBegin = ptr;
+		++ptr;
+
+		bool isNegativeExponent = false;
+		if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+			isNegativeExponent = (*ptr == '-');
+			++ptr;
+		}
+
+		if (ptr < end && IsDigit(*ptr)) {
+			int e = 0;
+			while (ptr < end && IsDigit(*ptr)) {
+				if (e < 10000) {
+					e = e * 10 + (*ptr - '0');
+				}
+
+				++ptr;
+			}
+
+			exponent += isNegativeExponent ? -e : e;
+
+		} else { //!< 'e'の後に数字がない場合は指数部として扱わない
+			ptr = exponentBegin;
+		}
+	}
+
+	if (!isTruncated && mantissa <= kMaxFastMantissa && exponent >= -kMaxFastExponent && exponent <= kMaxFastExponent) {
+		// 仮数部, 10の累乗がどちらもfloatで正確に表現できるので一回の演算で正しく丸められる
+		float result = static_cast<float>(mantissa);
+
+		if (exponent < 0) {
+			result /= kPow10f[-exponent];
+
+		} else {
+			result *= kPow10f[exponent];
+		}
+
+		value = isNegative ? -result : result;
+		return ptr;
+	}
+
+	// 高速経路で正しく丸められない場合は標準の変換に任せる
+	auto [last, ec] = std::from_chars(digitBegin, ptr, value);
+
+	if (ec == std::errc::result_out_of_range) {
+		value = (exponent < 0) ? 0.0f : std::numeric_limits<float>::infinity();
+	}
+
+	value = isNegative ? -value : value;
+	return ptr;
+}
+
+FaceKey ObjLoader::ParseFaceKey(std::string_view faceString) {
+	FaceKey result = {};
+	uint32_t* faceNum[kFaceTypeCount] = { &result.v, &result.vt, &result.vn };
+
+	const char* token    = faceString.data();
+	const char* tokenEnd = token + faceString.size();
+
+	for (int fi = 0; fi < kFaceTypeCount; ++fi) {
+		token = ParseUInt(token, tokenEnd, *faceNum[fi]);
+
+		// 次の'/'まで進める
+		while (token < tokenEnd && *token != '/') {
+			++token;
+		}
+
+		if (token == tokenEnd) {
+			break;
+		}
+
+		++token;
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+// structure
+#include <ModelRawData.h>
+
+// engine
+#include <VertexDedupTable.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ObjLoader namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace ObjLoader {
+
+	//-----------------------------------------------------------------------------------------
+	// parser
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief std::getline + std::istringstream による従来のparse
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//!
+	//! @return CPU側のmodelDataを返却. 失敗した場合はerrorを設定
+	ModelRawData ParseStream(const std::string& directoryPath, const std::string& filename);
+
+	//! @brief ファイルをマッピングし, その場でtokenizeするparse
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//!
+	//! @return CPU側のmodelDataを返却. 失敗した場合はerrorを設定
+	ModelRawData ParseMapped(const std::string& directoryPath, const std::string& filename);
+
+	//! @brief ファイルを行境界でchunkに分割し, 複数スレッドでparse
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] threadCount   使用するスレッド数. 0の場合は全て
+	//!
+	//! @return CPU側のmodelDataを返却. ParseMappedと同じ結果. 失敗した場合はerrorを設定
+	ModelRawData ParseParallel(const std::string& directoryPath, const std::string& filename, uint32_t threadCount = 0);
+
+	//! @brief mtlファイルからusemtlに一致するmaterialを読み込む. mtlファイルはMaterialLibraryで一度だけparseされる
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      mtlファイル名
+	//! @param[in] usemtl        material名
+	//!
+	//! @return materialDataを返却
+	MaterialData LoadMaterial(const std::string& directoryPath, const std::string& filename, const std::string& usemtl);
+
+	//-----------------------------------------------------------------------------------------
+	// scanner
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 空白の読み飛ばし(改行は含まない)
+	inline const char* SkipSpace(const char* ptr, const char* end) {
+		while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r')) {
+			++ptr;
+		}
+
+		return ptr;
+	}
+
+	//! @brief 空白までを一つのtokenとして読み込む
+	//!
+	//! @param[in,out] ptr 読み込み位置. token直後に進む
+	//! @param[in]     end 読み込み終端
+	//!
+	//! @return tokenを返却. 見つからなかった場合は空
+	inline std::string_view ReadToken(const char*& ptr, const char* end) {
+		ptr = SkipSpace(ptr, end);
+
+		const char* begin = ptr;
+		while (ptr < end && *ptr != ' ' && *ptr != '\t' && *ptr != '\r' && *ptr != '\n') {
+			++ptr;
+		}
+
+		return std::string_view(begin, static_cast<size_t>(ptr - begin));
+	}
+
+	//! @brief 符号なし整数の読み込み
+	//!
+	//! @param[in]  ptr   読み込み位置
+	//! @param[in]  end   読み込み終端
+	//! @param[out] value 読み込んだ値. 数字がない場合は0
+	//!
+	//! @return 読み込み後の位置を返却
+	const char* ParseUInt(const char* ptr, const char* end, uint32_t& value);
+
+	//! @brief 浮動小数点の読み込み. localeに依存しない
+	//!
+	//! @param[in]  ptr   読み込み位置
+	//! @param[in]  end   読み込み終端
+	//! @param[out] value 読み込んだ値. 読み込めない場合は0
+	//!
+	//! @return 読み込み後の位置を返却
+	const char* ParseFloat(const char* ptr, const char* end, float& value);
+
+	//! @brief "v/vt/vn", "v//vn", "v/vt", "v" をFaceKeyに変換
+	//!
+	//! @param[in] faceString faceのtoken
+	//!
+	//! @return FaceKeyを返却. 省略された番号は0
+	FaceKey ParseFaceKey(std::string_view faceString);
+
+}
\ No newline at end of file
@@ -0,0 +1,481 @@
+#include "ObjStreamImporter.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+#include <filesystem>
+
+// engine
+#include <ObjLoader.h>
+#include <VertexDedupTable.h>
+#include <MaterialLibrary.h>
+#include <MeshCache.h>
+#include <MeshOptimizer.h>
+#include <Meshlet.h>
+#include <MeshBounds.h>
+#include <ScratchMemory.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//-----------------------------------------------------------------------------------------
+	// budgetの配分
+	//-----------------------------------------------------------------------------------------
+	constexpr size_t kMinWindowSize = 64ull << 10;
+	constexpr size_t kMaxWindowSize = 4ull << 20;
+
+	constexpr size_t kWindowDivisor    = 16; //!< budgetのうち, objファイルの読み込み窓
+	constexpr size_t kAttributeDivisor = 12; //!< budgetのうち, v, vt, vn それぞれのpage cache
+
+	constexpr size_t kMaxIndexPerVertex = 8; //!< chunk内のindex数の上限 (頂点数あたり)
+
+	//! 最適化時の一時バッファ (MeshOptimizer, MeshletMethods) の頂点一つあたりのbyte数の上限.
+	//! chunkの大きさを決めるためだけに使い, 実際の確保量はScratchMemoryで数える
+	constexpr size_t kOptimizeBytesPerVertex = 192;
+
+	//! chunkの頂点一つあたりのbyte数. dedup tableは別に計算
+	constexpr size_t kChunkBytesPerVertex = sizeof(VertexData) + sizeof(uint32_t) * kMaxIndexPerVertex + kOptimizeBytesPerVertex;
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// LineReader class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	class LineReader { //!< 固定サイズの窓でファイルを読み進め, 一行ずつ返す
+	public:
+
+		LineReader(const std::string& filePath, size_t windowSize)
+			: file_(filePath, std::ios::binary), buffer_(windowSize) {
+		}
+
+		bool IsOpen() const { return file_.is_open(); }
+
+		//! @brief 次の行を取得. 改行は含まない. 窓より長い行は窓の大きさで区切られる
+		//!
+		//! @retval true  行を取得した
+		//! @retval false ファイルの終端
+		bool ReadLine(const char*& lineBegin, const char*& lineEnd) {
+			while (true) {
+				const char* begin = buffer_.data() + begin_;
+				const char* end   = buffer_.data() + end_;
+				const char* found = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+
+				if (found != nullptr) {
+					lineBegin = begin;
+					lineEnd   = found;
+					begin_    = static_cast<size_t>(found - buffer_.data()) + 1;
+					return true;
+				}
+
+				if (isEof_ || (begin_ == 0 && end_ == buffer_.size())) { //!< 最後の行, または窓より長い行
+					if (begin_ == end_) {
+						return false;
+					}
+
+					lineBegin = begin;
+					lineEnd   = end;
+					begin_    = end_;
+					return true;
+				}
+
+				// 残りを先頭に寄せて読み足す
+				std::memmove(buffer_.data(), begin, end_ - begin_);
+				end_  -= begin_;
+				begin_ = 0;
+
+				file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+				end_ += static_cast<size_t>(file_.gcount());
+
+				isEof_ = !file_.good();
+			}
+		}
+
+		size_t GetMemorySize() const { return buffer_.capacity(); }
+
+	private:
+
+		std::ifstream     file_;
+		std::vector<char> buffer_;
+		size_t            begin_ = 0;
+		size_t            end_   = 0;
+		bool              isEof_ = false;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// SpillArray class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	template <typename T>
+	class SpillArray { //!< 一時ファイルに追記する配列. 読み込みは固定数のpageをcacheする (direct mapped)
+	public:
+
+		static constexpr size_t kPageElementCount = 4096;
+
+		~SpillArray() { Close(); }
+
+		//! @brief 一時ファイルを作成
+		//!
+		//! @param[in] filePath      一時ファイルパス
+		//! @param[in] cacheByteSize page cacheに使うbyte数
+		bool Open(const std::string& filePath, size_t cacheByteSize) {
+			filePath_ = filePath;
+			file_.open(filePath_, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+
+			size_t slotCount = (std::max)(cacheByteSize / (sizeof(T) * kPageElementCount), static_cast<size_t>(1));
+
+			cache_.resize(slotCount * kPageElementCount);
+			tags_.assign(slotCount, kEmptyTag);
+			tail_.reserve(kPageElementCount);
+
+			return file_.is_open();
+		}
+
+		//! @brief 一時ファイルを削除
+		void Close() {
+			if (!file_.is_open()) {
+				return;
+			}
+
+			file_.close();
+
+			std::error_code error;
+			std::filesystem::remove(filePath_, error);
+		}
+
+		void Push(const T& value) {
+			tail_.push_back(value);
+			++size_;
+
+			if (tail_.size() == kPageElementCount) { //!< pageが埋まったので書き出す
+				file_.seekp(static_cast<std::streamoff>(pageCount_ * sizeof(T) * kPageElementCount));
+				file_.write(reinterpret_cast<const char*>(tail_.data()), sizeof(T) * kPageElementCount);
+
+				++pageCount_;
+				tail_.clear();
+			}
+		}
+
+		//! @brief 値を取得
+		//!
+		//! @retval true  取得成功
+		//! @retval false 範囲外
+		bool Get(uint64_t index, T& value) {
+			if (index >= size_) {
+				return false;
+			}
+
+			uint64_t page   = index / kPageElementCount;
+			size_t   offset = static_cast<size_t>(index % kPageElementCount);
+
+			if (page == pageCount_) { //!< 書き出し前のpage
+				value = tail_[offset];
+				return true;
+			}
+
+			size_t slot = static_cast<size_t>(page % tags_.size());
+			T*     data = cache_.data() + slot * kPageElementCount;
+
+			if (tags_[slot] != page) {
+				file_.seekg(static_cast<std::streamoff>(page * sizeof(T) * kPageElementCount));
+				file_.read(reinterpret_cast<char*>(data), sizeof(T) * kPageElementCount);
+				tags_[slot] = page;
+			}
+
+			value = data[offset];
+			return true;
+		}
+
+		size_t GetMemorySize() const {
+			return cache_.capacity() * sizeof(T) + tags_.capacity() * sizeof(uint64_t) + tail_.capacity() * sizeof(T);
+		}
+
+	private:
+
+		static constexpr uint64_t kEmptyTag = ~0ull;
+
+		std::fstream          file_;
+		std::string           filePath_;
+		std::vector<T>        cache_;
+		std::vector<uint64_t> tags_;      //!< slotに読み込んでいるpage番号
+		std::vector<T>        tail_;      //!< 書き出し前のpage
+		uint64_t              pageCount_ = 0;
+		uint64_t              size_      = 0;
+	};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ObjStreamImporter methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+ObjStreamImporter::ImportResult ObjStreamImporter::Import(const std::string& directoryPath, const std::string& filename, size_t memoryBudget) {
+	assert(memoryBudget >= kMinMemoryBudget); //!< budgetが小さすぎる
+
+	ImportResult result = {};
+	result.memoryBudget = memoryBudget;
+
+	std::string filePath       = directoryPath + "/" + filename;
+	std::string cookedFilePath = MeshCache::GetCookedFilePath(directoryPath, filename);
+
+	std::unique_lock<std::mutex> cookLock = MeshCache::LockCook(cookedFilePath); //!< 同じcookedファイルへの書き込みを直列化
+
+	// budgetの配分
+	size_t windowSize     = std::clamp(memoryBudget / kWindowDivisor, kMinWindowSize, kMaxWindowSize);
+	size_t attributeCache = memoryBudget / kAttributeDivisor;
+
+	LineReader reader(filePath, windowSize);
+
+	if (!reader.IsOpen()) {
+		return result;
+	}
+
+	SpillArray<Vector3f> positions;
+	SpillArray<Vector2f> texcoords;
+	SpillArray<Vector3f> normals;
+
+	if (!positions.Open(MeshCache::MakeTempFilePath(cookedFilePath + ".v"), attributeCache)
+		|| !texcoords.Open(MeshCache::MakeTempFilePath(cookedFilePath + ".vt"), attributeCache)
+		|| !normals.Open(MeshCache::MakeTempFilePath(cookedFilePath + ".vn"), attributeCache)) {
+		return result;
+	}
+
+	size_t fixedMemory = reader.GetMemorySize() + positions.GetMemorySize() + texcoords.GetMemorySize() + normals.GetMemorySize();
+
+	// 残りでchunkの大きさを決める
+	size_t   chunkBudget        = (memoryBudget > fixedMemory) ? memoryBudget - fixedMemory : 0;
+	uint32_t maxChunkVertex     = static_cast<uint32_t>((std::min)(chunkBudget / kChunkBytesPerVertex, static_cast<size_t>(kMaxChunkVertexCount)));
+
+	// dedup tableは2の累乗で確保されるので, 収まるまで減らす
+	while (maxChunkVertex > 4
+		&& maxChunkVertex * kChunkBytesPerVertex + VertexDedupTable::GetReserveMemorySize(maxChunkVertex) > chunkBudget) {
+		maxChunkVertex -= (std::max)(maxChunkVertex / 8, 1u);
+	}
+
+	size_t maxChunkIndexCount = static_cast<size_t>(maxChunkVertex) * kMaxIndexPerVertex;
+
+	assert(maxChunkVertex >= 4); //!< 四角形ポリゴン一つも入らない
+
+	MeshCache::Writer writer;
+
+	if (!writer.Open(cookedFilePath, MeshCache::HashFile(filePath))) {
+		return result;
+	}
+
+	std::string               mtlFilename;
+	std::vector<MaterialData> materials; //!< 書き出したmesh毎
+	MaterialData              materialData = {};
+
+	std::shared_ptr<const MaterialTable> materialTable; //!< 最初の"usemtl"で読み込み
+
+	MeshRawData mesh;
+	mesh.vertices.reserve(maxChunkVertex);
+	mesh.indices.reserve(maxChunkIndexCount);
+
+	VertexDedupTable faces;
+	faces.Reserve(maxChunkVertex);
+
+	// 使用メモリの記録
+	auto recordMemory = [&](size_t extra) {
+		size_t memory = fixedMemory + faces.GetMemorySize()
+			+ mesh.vertices.capacity() * sizeof(VertexData) + mesh.indices.capacity() * sizeof(uint32_t)
+			+ materials.capacity() * sizeof(MaterialData) + extra;
+
+		result.peakMemory = (std::max)(result.peakMemory, memory);
+	};
+
+	// chunkを最適化して書き出す
+	auto flushMesh = [&]() {
+		if (mesh.indices.empty()) {
+			return;
+		}
+
+		// 最適化の一時バッファは実際に確保した量の最大値で記録
+		size_t scratchBase = ScratchMemory::GetCurrentSize();
+		ScratchMemory::ResetPeak();
+
+		MeshOptimizer::Optimize(mesh);
+		mesh.meshlets = MeshletMethods::Build(mesh);
+
+		recordMemory(ScratchMemory::GetPeakSize() - scratchBase + mesh.meshlets.capacity() * sizeof(Meshlet));
+
+		uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+		mesh.aabb   = MeshBounds::ComputeAABB(mesh.vertices.data(), vertexCount);
+		mesh.sphere = MeshBounds::ComputeSphere(mesh.vertices.data(), vertexCount, mesh.aabb);
+
+		writer.WriteMesh(mesh);
+		materials.push_back(materialData);
+
+		result.meshCount++;
+		result.vertexCount += vertexCount;
+		result.indexCount  += mesh.indices.size();
+
+		// バッファは再利用
+		mesh.vertices.clear();
+		mesh.indices.clear();
+		mesh.meshlets.clear();
+		mesh.meshlets.shrink_to_fit();
+
+		mesh.vertices.reserve(maxChunkVertex);
+		mesh.indices.reserve(maxChunkIndexCount);
+
+		faces.Clear();
+	};
+
+	bool isValid = true;
+
+	const char* lineBegin = nullptr;
+	const char* lineEnd   = nullptr;
+
+	while (isValid && reader.ReadLine(lineBegin, lineEnd)) {
+		const char* ptr = lineBegin;
+
+		std::string_view identifire = ObjLoader::ReadToken(ptr, lineEnd); // 識別子
+
+		if (identifire == "mtllib") { //!< マテリアルファイル名
+			mtlFilename = ObjLoader::ReadToken(ptr, lineEnd);
+			materialTable.reset();
+
+		} else if (identifire == "o") {
+			flushMesh();
+
+		} else if (identifire == "v") { //!< vertex
+			Vector3f position;
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, position.x);
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, position.y);
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, position.z);
+
+			// 左手座標に変換
+			position.z *= -1;
+
+			positions.Push(position);
+
+		} else if (identifire == "vt") { //!< texcoord
+			Vector2f texcoord;
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, texcoord.x);
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, texcoord.y);
+
+			// 左手座標に変換
+			texcoord.y = 1.0f - texcoord.y;
+
+			texcoords.Push(texcoord);
+
+		} else if (identifire == "vn") { //!< normal
+			Vector3f normal;
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, normal.x);
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, normal.y);
+			ptr = ObjLoader::ParseFloat(ObjLoader::SkipSpace(ptr, lineEnd), lineEnd, normal.z);
+
+			// 左手座標に変換
+			normal.z *= -1;
+
+			normals.Push(normal);
+
+		} else if (identifire == "usemtl") { //!< materialの使用名
+			std::string usemtl(ObjLoader::ReadToken(ptr, lineEnd));
+
+			if (materialTable == nullptr) {
+				materialTable = MaterialLibrary::Load(directoryPath, mtlFilename);
+			}
+
+			// 途中でmaterialが変わる場合は, そこまでを別のmeshにする
+			flushMesh();
+
+			materialData = MaterialLibrary::Find(*materialTable, usemtl);
+
+		} else if (identifire == "f") { //!< face 四角形ポリゴンに対応
+			// 上限に達する前に書き出す
+			if (mesh.vertices.size() + 4 > maxChunkVertex || mesh.indices.size() + 6 > maxChunkIndexCount) {
+				flushMesh();
+			}
+
+			uint32_t cornerIndex[4] = {};
+			int vertexNum = 0;
+
+			for (int i = 0; i < 4; ++i) {
+				std::string_view faceString = ObjLoader::ReadToken(ptr, lineEnd);
+
+				if (faceString.empty()) { // 三角形ポリゴンなので i = 3 で break
+					break;
+				}
+
+				vertexNum++;
+
+				// faceStringからface番号を取得 "v/vt/vn", "v//vn". 番号はファイル全体で通し
+				FaceKey key = ObjLoader::ParseFaceKey(faceString);
+
+				// facesにすでにvertexdataがあるか確認
+				bool isInserted = false;
+				cornerIndex[i] = faces.FindOrInsert(key, static_cast<uint32_t>(mesh.vertices.size()), isInserted);
+
+				if (!isInserted) {
+					continue;
+				}
+
+				// 各データの取り出し
+				Vector3f position = {};
+				Vector2f texcoord = { 0.0f, 0.0f };
+				Vector3f normal   = {};
+
+				if (key.v == 0 || !positions.Get(key.v - 1, position)
+					|| (key.vt != 0 && !texcoords.Get(key.vt - 1, texcoord))
+					|| (key.vn != 0 && !normals.Get(key.vn - 1, normal))) {
+					isValid = false; //!< 範囲外の番号
+					break;
+				}
+
+				VertexData vertexData = {
+					{ position.x, position.y, position.z, 1.0f },
+					texcoord,
+					normal,
+				};
+
+				mesh.vertices.push_back(vertexData);
+			}
+
+			// indexdataの作成
+			if (vertexNum == 3) { //!< 三角形ポリゴンの場合
+				// 逆順に代入
+				mesh.indices.push_back(cornerIndex[2]);
+				mesh.indices.push_back(cornerIndex[1]);
+				mesh.indices.push_back(cornerIndex[0]);
+
+			} else if (vertexNum == 4) { //!< 四角形ポリゴンの場合
+				// polygonA
+				mesh.indices.push_back(cornerIndex[0]);
+				mesh.indices.push_back(cornerIndex[3]);
+				mesh.indices.push_back(cornerIndex[1]);
+
+				// polygonB
+				mesh.indices.push_back(cornerIndex[3]);
+				mesh.indices.push_back(cornerIndex[2]);
+				mesh.indices.push_back(cornerIndex[1]);
+
+			} else {
+				isValid = false; //!< ポリゴンの頂点数の不足
+			}
+		}
+
+		recordMemory(0);
+	}
+
+	if (!isValid) {
+		writer.Abort();
+		return result;
+	}
+
+	// fileが終わったので最後のやつを保存
+	flushMesh();
+
+	uint64_t mtlHash = mtlFilename.empty()
+		? 0 : MeshCache::HashFile(directoryPath + "/" + mtlFilename);
+
+	result.isSuccess = writer.Close(mtlFilename, materials, mtlHash);
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ObjStreamImporter namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace ObjStreamImporter { //!< 巨大なobjファイルを, 使用メモリを制限しながらcookedファイルに変換
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const size_t   kDefaultMemoryBudget = 256ull << 20; //!< 256MB
+	static const size_t   kMinMemoryBudget     = 4ull << 20;   //!< これ以下では一度に処理できる頂点が少なすぎる
+	static const uint32_t kMaxChunkVertexCount = 0x10000;      //!< mesh一つあたりの最大頂点数. 16bit indexで描画できる
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ImportResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ImportResult {
+		bool     isSuccess;
+		uint32_t meshCount;    //!< 書き出したmesh数. objectがchunkに分割されるため"o"の数以上
+		uint64_t vertexCount;
+		uint64_t indexCount;
+		size_t   peakMemory;   //!< importerが確保したバッファの合計の最大値 (byte)
+		size_t   memoryBudget;
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief objファイルを固定サイズの窓で読み進め, 頂点数が上限に達する毎にmeshとしてcookedファイルへ書き出す
+	//!
+	//! v, vt, vnは一時ファイルに書き出し, 固定数のpageのみをメモリに置く.
+	//! 書き出すmeshはvertex cache, overdraw, vertex fetchの最適化とmeshletの作成を行う.
+	//! chunkの境目で割れるため, LODは作成しない
+	//!
+	//! @param[in] directoryPath ディレクトリパス
+	//! @param[in] filename      objファイル名
+	//! @param[in] memoryBudget  使用するメモリの上限 (byte). kMinMemoryBudget以上
+	//!
+	//! @return 結果を返却. cookedファイルはMeshCache::GetCookedFilePathに書き出され, ModelMethods::LoadCookedObjFileで読み込める
+	ImportResult Import(const std::string& directoryPath, const std::string& filename, size_t memoryBudget = kDefaultMemoryBudget);
+
+}
\ No newline at end of file
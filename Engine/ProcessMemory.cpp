@@ -0,0 +1,100 @@
+#include "ProcessMemory.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+#ifdef _WIN32
+// windows
+#include <windows.h>
+#include <psapi.h>
+
+#else
+// c++
+#include <fstream>
+#include <string>
+#include <string_view>
+#endif
+
+#ifdef _WIN32
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	PROCESS_MEMORY_COUNTERS GetCounters() {
+		PROCESS_MEMORY_COUNTERS counters = {};
+
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			return {};
+		}
+
+		return counters;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ProcessMemory methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t ProcessMemory::GetWorkingSetSize() {
+	return static_cast<size_t>(GetCounters().WorkingSetSize);
+}
+
+size_t ProcessMemory::GetPeakWorkingSetSize() {
+	return static_cast<size_t>(GetCounters().PeakWorkingSetSize);
+}
+
+bool ProcessMemory::ResetPeakWorkingSetSize() {
+	return false;
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief /proc/self/statusの値を取得
+	//!
+	//! @param[in] key "VmRSS", "VmHWM" など
+	//!
+	//! @return byte数を返却. 見つからない場合は0
+	size_t ReadStatus(std::string_view key) {
+		std::ifstream file("/proc/self/status");
+		std::string   line;
+
+		while (std::getline(file, line)) {
+			if (line.size() > key.size() && line.compare(0, key.size(), key) == 0 && line[key.size()] == ':') {
+				return static_cast<size_t>(std::stoull(line.substr(key.size() + 1))) << 10; //!< kB
+			}
+		}
+
+		return 0;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ProcessMemory methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t ProcessMemory::GetWorkingSetSize() {
+	return ReadStatus("VmRSS");
+}
+
+size_t ProcessMemory::GetPeakWorkingSetSize() {
+	return ReadStatus("VmHWM");
+}
+
+bool ProcessMemory::ResetPeakWorkingSetSize() {
+	std::ofstream file("/proc/self/clear_refs");
+	file << "5"; //!< VmHWMをVmRSSに戻す
+	file.flush();
+
+	return file.good();
+}
+
+#endif
\ No newline at end of file
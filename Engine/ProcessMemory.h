@@ -0,0 +1,30 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ProcessMemory namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace ProcessMemory { //!< processの物理メモリ使用量 (working set, RSS) をOSから取得
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 現在のworking setのbyte数. 取得できない場合は0
+	size_t GetWorkingSetSize();
+
+	//! @brief working setの最大値のbyte数. 取得できない場合は0
+	size_t GetPeakWorkingSetSize();
+
+	//! @brief working setの最大値を現在の値に戻す
+	//!
+	//! @retval true  成功
+	//! @retval false 対応していない (windows). 最大値はprocess開始からの値のまま
+	bool ResetPeakWorkingSetSize();
+
+}
\ No newline at end of file
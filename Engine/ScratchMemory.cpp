@@ -0,0 +1,42 @@
+#include "ScratchMemory.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	thread_local size_t sCurrentSize = 0;
+	thread_local size_t sPeakSize    = 0;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ScratchMemory methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void ScratchMemory::Allocate(size_t byteSize) {
+	sCurrentSize += byteSize;
+	sPeakSize     = (std::max)(sPeakSize, sCurrentSize);
+}
+
+void ScratchMemory::Deallocate(size_t byteSize) {
+	sCurrentSize -= (std::min)(byteSize, sCurrentSize);
+}
+
+size_t ScratchMemory::GetCurrentSize() {
+	return sCurrentSize;
+}
+
+size_t ScratchMemory::GetPeakSize() {
+	return sPeakSize;
+}
+
+void ScratchMemory::ResetPeak() {
+	sPeakSize = sCurrentSize;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ScratchMemory namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace ScratchMemory { //!< 処理中だけ使う一時バッファの確保量をスレッド毎に数える
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 現在のスレッドでの確保を記録
+	void Allocate(size_t byteSize);
+
+	//! @brief 現在のスレッドでの解放を記録
+	void Deallocate(size_t byteSize);
+
+	//! @brief 現在のスレッドで確保中のbyte数
+	size_t GetCurrentSize();
+
+	//! @brief ResetPeak以降に現在のスレッドで同時に確保していたbyte数の最大値
+	size_t GetPeakSize();
+
+	//! @brief 最大値を現在の確保量に戻す
+	void ResetPeak();
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Allocator class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	template <typename T>
+	class Allocator { //!< std::allocatorで確保し, byte数を記録する. 確保したスレッドで解放すること
+	public:
+
+		using value_type = T;
+
+		Allocator() = default;
+
+		template <typename U>
+		Allocator(const Allocator<U>&) noexcept {}
+
+		T* allocate(size_t count) {
+			T* result = std::allocator<T>().allocate(count);
+			Allocate(sizeof(T) * count);
+
+			return result;
+		}
+
+		void deallocate(T* ptr, size_t count) noexcept {
+			std::allocator<T>().deallocate(ptr, count);
+			Deallocate(sizeof(T) * count);
+		}
+
+		template <typename U>
+		bool operator==(const Allocator<U>&) const noexcept { return true; }
+
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// using
+	//-----------------------------------------------------------------------------------------
+	template <typename T>
+	using Vector = std::vector<T, Allocator<T>>;
+
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "TextureBenchmark.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <chrono>
+#include <format>
+#include <cmath>
+#include <algorithm>
+
+// engine
+#include <Logger.h>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief 関数の平均実行時間を計測
+	//!
+	//! @return 一回あたりの時間(ms)を返却
+	template <typename F>
+	double Measure(uint32_t iterationCount, F&& function) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < iterationCount; ++i) {
+			function();
+		}
+
+		auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count() / static_cast<double>(iterationCount);
+	}
+
+	//! @brief 座標からの疑似乱数 [0, 256)
+	uint32_t Hash(uint32_t x, uint32_t y, uint32_t channel) {
+		uint32_t h = x * 0x8DA6B343u ^ y * 0xD8163841u ^ channel * 0xCB1AB31Fu;
+		h ^= h >> 13;
+		h *= 0x5BD1E995u;
+		h ^= h >> 15;
+
+		return h & 0xFF;
+	}
+
+	//! @brief グラデーション, ノイズ, alpha testの模様を含む計測用の画像
+	MipChain CreateTestChain(uint32_t width, uint32_t height) {
+		MipChain result = MipGenerator::CreateChain(width, height);
+
+		const MipImage& image = result.levels[0];
+
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				uint8_t* pixel = image.pixels + image.rowPitch * y + x * 4;
+
+				pixel[0] = static_cast<uint8_t>(x * 255 / (std::max)(width - 1, 1u));
+				pixel[1] = static_cast<uint8_t>(y * 255 / (std::max)(height - 1, 1u));
+				pixel[2] = static_cast<uint8_t>(Hash(x, y, 2));
+
+				// 葉のような縞模様
+				float stripe = std::abs(std::sin(x * 0.05f) * std::cos(y * 0.07f));
+				pixel[3] = static_cast<uint8_t>(stripe > 0.6f ? 255.0f : stripe * 200.0f);
+			}
+		}
+
+		return result;
+	}
+
+	double SrgbToLinear(double value) {
+		return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+	}
+
+	double LinearToSrgb(double value) {
+		return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureBenchmark methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<TextureBenchmark::MipGenerationResult> TextureBenchmark::MipGeneration(uint32_t width, uint32_t height, MipFilter filter, uint32_t iterationCount) {
+	std::vector<MipGenerationResult> result;
+
+	if (iterationCount == 0) {
+		iterationCount = 1;
+	}
+
+	MipOptions options = {};
+	options.filter = filter;
+
+	// 基準となる1スレッドの結果
+	MipChain reference = CreateTestChain(width, height);
+	MipGenerator::Generate(reference, options, 1);
+
+	Log(std::format("[TextureBenchmark::MipGeneration] {}x{}, filter: {}\n", width, height, filter == MIP_FILTER_BOX ? "box" : "kaiser"));
+
+	uint32_t maxThreadCount = Parallel::GetThreadCount();
+	double   singleMs       = 0.0;
+
+	for (uint32_t threadCount = 1;; threadCount = (std::min)(threadCount * 2, maxThreadCount)) {
+		MipChain chain = CreateTestChain(width, height);
+
+		MipGenerationResult generation = {};
+		generation.threadCount = threadCount;
+		generation.generateMs  = Measure(iterationCount, [&]() { MipGenerator::Generate(chain, options, threadCount); });
+		generation.isMatch     = chain.pixels == reference.pixels;
+
+		if (threadCount == 1) {
+			singleMs = generation.generateMs;
+		}
+
+		generation.speedup = singleMs / generation.generateMs;
+
+		Log(std::format(
+			" generate({:2}): {:.3f}ms (x{:.2f}), match: {}\n",
+			generation.threadCount, generation.generateMs, generation.speedup, generation.isMatch ? "true" : "false"
+		));
+
+		result.push_back(generation);
+
+		if (threadCount == maxThreadCount) {
+			break;
+		}
+	}
+
+	return result;
+}
+
+TextureBenchmark::MipAccuracyResult TextureBenchmark::MipAccuracy(uint32_t width, uint32_t height) {
+	MipAccuracyResult result = {};
+
+	// box filter. 2の累乗ならlevel0のblockをlinearで平均した値と一致する
+	{
+		MipChain chain = CreateTestChain(width, height);
+		MipGenerator::Generate(chain, {});
+
+		const MipImage& source = chain.levels[0];
+
+		for (size_t level = 1; level < chain.levels.size(); ++level) {
+			const MipImage& image = chain.levels[level];
+
+			uint32_t blockWidth  = width / image.width;
+			uint32_t blockHeight = height / image.height;
+
+			for (uint32_t y = 0; y < image.height; ++y) {
+				for (uint32_t x = 0; x < image.width; ++x) {
+					for (uint32_t channel = 0; channel < 4; ++channel) {
+						double sum = 0.0;
+
+						for (uint32_t by = 0; by < blockHeight; ++by) {
+							for (uint32_t bx = 0; bx < blockWidth; ++bx) {
+								double value = source.pixels[source.rowPitch * (y * blockHeight + by) + (x * blockWidth + bx) * 4 + channel] / 255.0;
+								sum += channel == 3 ? value : SrgbToLinear(value);
+							}
+						}
+
+						sum /= blockWidth * blockHeight;
+
+						int32_t expected = static_cast<int32_t>(std::floor((channel == 3 ? sum : LinearToSrgb(sum)) * 255.0 + 0.5));
+						int32_t actual   = image.pixels[image.rowPitch * y + x * 4 + channel];
+
+						result.maxBoxError = (std::max)(result.maxBoxError, static_cast<uint32_t>(std::abs(expected - actual)));
+					}
+				}
+			}
+		}
+	}
+
+	// 単色. sRGB <-> linearの変換で値がずれない
+	result.isFlatExact = true;
+
+	for (uint32_t filter = 0; filter < kMipFilterCount; ++filter) {
+		MipChain chain = MipGenerator::CreateChain(8, 8);
+
+		MipOptions options = {};
+		options.filter = static_cast<MipFilter>(filter);
+
+		for (uint32_t value = 0; value < 256; ++value) {
+			std::fill(chain.pixels.begin(), chain.pixels.end(), static_cast<uint8_t>(value));
+			MipGenerator::Generate(chain, options, 1);
+
+			if (std::any_of(chain.pixels.begin(), chain.pixels.end(), [&](uint8_t pixel) { return pixel != value; })) {
+				result.isFlatExact = false;
+			}
+		}
+	}
+
+	// alpha coverage. 1x1に近いmipはpixel数が少なく一致しないので4x4まで
+	{
+		MipChain chain = CreateTestChain(width, height);
+
+		MipOptions options = {};
+		options.isPreserveAlphaCoverage = true;
+
+		MipGenerator::Generate(chain, options);
+
+		float coverage = MipGenerator::ComputeAlphaCoverage(chain.levels[0], options.alphaReference);
+
+		for (const auto& image : chain.levels) {
+			if (image.width < 4 || image.height < 4) {
+				break;
+			}
+
+			float error = std::abs(MipGenerator::ComputeAlphaCoverage(image, options.alphaReference) - coverage);
+			result.maxCoverageError = (std::max)(result.maxCoverageError, error);
+		}
+	}
+
+	Log(std::format(
+		"[TextureBenchmark::MipAccuracy] {}x{}\n box error: {}, flat exact: {}, coverage error: {:.4f}\n",
+		width, height, result.maxBoxError, result.isFlatExact ? "true" : "false", result.maxCoverageError
+	));
+
+	return result;
+}
\ No newline at end of file
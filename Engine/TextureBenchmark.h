@@ -0,0 +1,55 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+#include <vector>
+
+// engine
+#include <MipGenerator.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureBenchmark namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace TextureBenchmark {
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// MipGenerationResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct MipGenerationResult {
+		uint32_t threadCount;
+		double   generateMs; //!< 一回あたりの平均時間
+		double   speedup;    //!< 1スレッドに対する速度比
+		bool     isMatch;    //!< 1スレッドと結果が一致したか
+	};
+
+	//! @brief スレッド数を 1, 2, 4, ... と変えてMipGenerator::Generateを計測. 結果はLogにも出力
+	//!
+	//! @param[in] width          生成する画像の幅
+	//! @param[in] height         生成する画像の高さ
+	//! @param[in] filter         filter
+	//! @param[in] iterationCount 計測回数
+	//!
+	//! @return スレッド数毎の計測結果を返却
+	std::vector<MipGenerationResult> MipGeneration(uint32_t width, uint32_t height, MipFilter filter, uint32_t iterationCount = 3);
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// MipAccuracyResult structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct MipAccuracyResult {
+		uint32_t maxBoxError;      //!< doubleで計算したsRGBのbox filterとの最大差 (8bit)
+		bool     isFlatExact;      //!< 単色の画像が全てのmipで同じ色になるか
+		float    maxCoverageError; //!< alpha coverageを保った時の各mipの通過率の最大差
+	};
+
+	//! @brief MipGeneratorの精度を検証. 結果はLogにも出力
+	//!
+	//! @param[in] width  生成する画像の幅. 2の累乗
+	//! @param[in] height 生成する画像の高さ. 2の累乗
+	//!
+	//! @return 検証結果を返却
+	MipAccuracyResult MipAccuracy(uint32_t width = 256, uint32_t height = 256);
+
+}
\ No newline at end of file
@@ -0,0 +1,458 @@
+#include "TextureCooker.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+#include <bit>
+
+// engine
+#include <AtlasPacker.h>
+
+// lib
+#include <Parallel.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kMinParallelBlocks = 64 * 64; //!< これ未満のlevelはスレッドを立てない
+
+	constexpr uint64_t kHashPrime = 0x9E3779B185EBCA87ull; //!< HashSourceで元画像のhashを合わせる
+
+	//-----------------------------------------------------------------------------------------
+	// DDS
+	//-----------------------------------------------------------------------------------------
+	constexpr uint32_t kDdsMagic = MeshCache::MakeFourCC('D', 'D', 'S', ' ');
+	constexpr uint32_t kDdsDx10  = MeshCache::MakeFourCC('D', 'X', '1', '0');
+
+	constexpr uint32_t kDdsdCaps        = 0x1;
+	constexpr uint32_t kDdsdHeight      = 0x2;
+	constexpr uint32_t kDdsdWidth       = 0x4;
+	constexpr uint32_t kDdsdPixelFormat = 0x1000;
+	constexpr uint32_t kDdsdMipMapCount = 0x20000;
+	constexpr uint32_t kDdsdLinearSize  = 0x80000;
+
+	constexpr uint32_t kDdpfFourCC = 0x4;
+
+	constexpr uint32_t kDdsCapsComplex = 0x8;
+	constexpr uint32_t kDdsCapsTexture = 0x1000;
+	constexpr uint32_t kDdsCapsMipMap  = 0x400000;
+
+	constexpr uint32_t kDimensionTexture2D = 3;
+
+	//! @brief DXGI_FORMATの値. windowsのheaderに依存しないよう定義
+	constexpr uint32_t kDxgiFormatBC1Unorm     = 71;
+	constexpr uint32_t kDxgiFormatBC1UnormSrgb = 72;
+	constexpr uint32_t kDxgiFormatBC3Unorm     = 77;
+	constexpr uint32_t kDxgiFormatBC3UnormSrgb = 78;
+	constexpr uint32_t kDxgiFormatBC5Unorm     = 83;
+	constexpr uint32_t kDxgiFormatBC7Unorm     = 98;
+	constexpr uint32_t kDxgiFormatBC7UnormSrgb = 99;
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// DdsPixelFormat structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct DdsPixelFormat {
+		uint32_t size;
+		uint32_t flags;
+		uint32_t fourCC;
+		uint32_t rgbBitCount;
+		uint32_t rBitMask;
+		uint32_t gBitMask;
+		uint32_t bBitMask;
+		uint32_t aBitMask;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// DdsHeader structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct DdsHeader {
+		uint32_t       size;
+		uint32_t       flags;
+		uint32_t       height;
+		uint32_t       width;
+		uint32_t       pitchOrLinearSize;
+		uint32_t       depth;
+		uint32_t       mipMapCount;
+		uint32_t       reserved1[11]; //!< [0] kMagic, [1] kVersion, [2, 3] 元画像のhash
+		DdsPixelFormat pixelFormat;
+		uint32_t       caps;
+		uint32_t       caps2;
+		uint32_t       caps3;
+		uint32_t       caps4;
+		uint32_t       reserved2;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// DdsHeaderDx10 structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct DdsHeaderDx10 {
+		uint32_t dxgiFormat;
+		uint32_t resourceDimension;
+		uint32_t miscFlag;
+		uint32_t arraySize;
+		uint32_t miscFlags2;
+	};
+
+	static_assert(sizeof(DdsHeader) == 124, "DDS_HEADER size");
+
+	constexpr uint64_t kDataOffset = sizeof(uint32_t) + sizeof(DdsHeader) + sizeof(DdsHeaderDx10); //!< level0のblockの位置
+
+	//! @brief DXGI_FORMATの4x4 blockのbyteサイズ. 未対応のformatは0
+	uint32_t GetFormatBlockSize(uint32_t dxgiFormat) {
+		switch (dxgiFormat) {
+			case kDxgiFormatBC1Unorm:
+			case kDxgiFormatBC1UnormSrgb:
+				return 8;
+
+			case kDxgiFormatBC3Unorm:
+			case kDxgiFormatBC3UnormSrgb:
+			case kDxgiFormatBC5Unorm:
+			case kDxgiFormatBC7Unorm:
+			case kDxgiFormatBC7UnormSrgb:
+				return 16;
+
+			default:
+				return 0;
+		}
+	}
+
+	//! @brief 4x4 blockのpixelを取り出す. 範囲外は端のpixel
+	void LoadBlockPixels(const MipImage& image, uint32_t blockX, uint32_t blockY, uint8_t* pixels) {
+		for (uint32_t y = 0; y < 4; ++y) {
+			uint32_t sy = (std::min)(blockY * 4 + y, image.height - 1);
+
+			for (uint32_t x = 0; x < 4; ++x) {
+				uint32_t sx = (std::min)(blockX * 4 + x, image.width - 1);
+
+				std::memcpy(pixels + (y * 4 + x) * 4, image.pixels + image.rowPitch * sy + sx * 4, 4);
+			}
+		}
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureCooker methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string TextureCooker::GetCookedFilePath(const std::string& filePath) {
+	return filePath + kExtension;
+}
+
+uint32_t TextureCooker::GetDxgiFormat(TextureCompression compression, bool isSrgb) {
+	switch (compression) {
+		case TEXTURE_COMPRESSION_BC1:
+			return isSrgb ? kDxgiFormatBC1UnormSrgb : kDxgiFormatBC1Unorm;
+
+		case TEXTURE_COMPRESSION_BC3:
+			return isSrgb ? kDxgiFormatBC3UnormSrgb : kDxgiFormatBC3Unorm;
+
+		case TEXTURE_COMPRESSION_BC5:
+			return kDxgiFormatBC5Unorm;
+
+		case TEXTURE_COMPRESSION_BC7:
+			return isSrgb ? kDxgiFormatBC7UnormSrgb : kDxgiFormatBC7Unorm;
+
+		default:
+			assert(false); //!< 未対応のformat
+			return 0;
+	}
+}
+
+std::vector<uint8_t> TextureCooker::Compress(const MipImage& image, TextureCompression compression, uint32_t threadCount) {
+	uint32_t blockSize   = BlockCompressor::GetBlockSize(compression);
+	uint32_t blockWidth  = (image.width + 3) / 4;
+	uint32_t blockHeight = (image.height + 3) / 4;
+
+	std::vector<uint8_t> result(static_cast<size_t>(blockWidth) * blockHeight * blockSize);
+
+	if (blockWidth * blockHeight < kMinParallelBlocks) {
+		threadCount = 1;
+	}
+
+	Parallel::For(blockHeight, [&](uint32_t blockY) {
+		uint8_t pixels[16 * 4];
+
+		for (uint32_t blockX = 0; blockX < blockWidth; ++blockX) {
+			LoadBlockPixels(image, blockX, blockY, pixels);
+			BlockCompressor::Encode(compression, pixels, result.data() + (static_cast<size_t>(blockY) * blockWidth + blockX) * blockSize);
+		}
+	}, threadCount);
+
+	return result;
+}
+
+bool TextureCooker::Write(const std::string& filePath, const MipChain& chain, const CookOptions& options, uint64_t sourceHash) {
+	const MipImage& top = chain.levels[0];
+
+	if (top.width % 4 != 0 || top.height % 4 != 0) { //!< BCのlevel0は4の倍数でなければならない
+		return false;
+	}
+
+	bool isSrgb = options.mip.isSrgb && options.compression != TEXTURE_COMPRESSION_BC5;
+
+	// header
+	DdsHeader header = {};
+	header.size              = sizeof(DdsHeader);
+	header.flags             = kDdsdCaps | kDdsdHeight | kDdsdWidth | kDdsdPixelFormat | kDdsdMipMapCount | kDdsdLinearSize;
+	header.height            = top.height;
+	header.width             = top.width;
+	header.pitchOrLinearSize = (top.width / 4) * (top.height / 4) * BlockCompressor::GetBlockSize(options.compression);
+	header.mipMapCount       = static_cast<uint32_t>(chain.levels.size());
+	header.reserved1[0]      = kMagic;
+	header.reserved1[1]      = kVersion;
+	header.reserved1[2]      = static_cast<uint32_t>(sourceHash);
+	header.reserved1[3]      = static_cast<uint32_t>(sourceHash >> 32);
+	header.caps              = kDdsCapsTexture | kDdsCapsComplex | kDdsCapsMipMap;
+
+	header.pixelFormat.size   = sizeof(DdsPixelFormat);
+	header.pixelFormat.flags  = kDdpfFourCC;
+	header.pixelFormat.fourCC = kDdsDx10;
+
+	DdsHeaderDx10 headerDx10 = {};
+	headerDx10.dxgiFormat        = GetDxgiFormat(options.compression, isSrgb);
+	headerDx10.resourceDimension = kDimensionTexture2D;
+	headerDx10.arraySize         = 1;
+
+	// 書き込み途中のファイルを読まないよう, 一時ファイルに書き込んでから置き換える
+	std::string tempFilePath = MeshCache::MakeTempFilePath(filePath);
+
+	{
+		std::ofstream file(tempFilePath, std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open()) {
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&kDdsMagic), sizeof(kDdsMagic));
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(&headerDx10), sizeof(headerDx10));
+
+		for (const auto& image : chain.levels) {
+			std::vector<uint8_t> blocks = Compress(image, options.compression, options.threadCount);
+			file.write(reinterpret_cast<const char*>(blocks.data()), blocks.size());
+		}
+
+		if (!file.good()) {
+			file.close();
+
+			std::error_code error;
+			std::filesystem::remove(tempFilePath, error);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempFilePath, filePath, error);
+
+	if (error) {
+		std::filesystem::remove(tempFilePath, error);
+		return false;
+	}
+
+	return true;
+}
+
+uint64_t TextureCooker::HashSource(const std::string& filePath) {
+	uint64_t result = MeshCache::HashFile(filePath);
+
+	if (!std::filesystem::path(filePath).extension().string().ends_with(AtlasPacker::kExtension)) {
+		return result;
+	}
+
+	// 配置ファイルが同じでも, 元画像が変わればatlasを作り直す
+	AtlasLayout layout = {};
+
+	if (!AtlasPacker::ReadLayout(filePath, layout)) {
+		return result;
+	}
+
+	for (const auto& sourcePath : layout.filePaths) {
+		result = std::rotl(result ^ MeshCache::HashFile(sourcePath), 27) * kHashPrime;
+	}
+
+	return (result == 0) ? 1 : result; //!< 0はファイルなしとして扱う
+}
+
+bool TextureCooker::IsFresh(const std::string& filePath) {
+	std::ifstream file(GetCookedFilePath(filePath), std::ios::binary);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	uint32_t  magic  = 0;
+	DdsHeader header = {};
+
+	file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+	if (!file.good() || magic != kDdsMagic || header.reserved1[0] != kMagic || header.reserved1[1] != kVersion) {
+		return false;
+	}
+
+	uint64_t sourceHash = static_cast<uint64_t>(header.reserved1[2]) | (static_cast<uint64_t>(header.reserved1[3]) << 32);
+
+	return sourceHash == HashSource(filePath);
+}
+
+bool TextureCooker::ReadInfo(const std::string& cookedFilePath, CookedInfo& info) {
+	std::ifstream file(cookedFilePath, std::ios::binary);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	uint32_t      magic      = 0;
+	DdsHeader     header     = {};
+	DdsHeaderDx10 headerDx10 = {};
+
+	file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	file.read(reinterpret_cast<char*>(&headerDx10), sizeof(headerDx10));
+
+	if (!file.good() || magic != kDdsMagic || header.reserved1[0] != kMagic || header.reserved1[1] != kVersion) {
+		return false;
+	}
+
+	if (GetFormatBlockSize(headerDx10.dxgiFormat) == 0 || header.mipMapCount == 0) {
+		return false;
+	}
+
+	info.dxgiFormat = headerDx10.dxgiFormat;
+	info.width      = header.width;
+	info.height     = header.height;
+	info.levelCount = header.mipMapCount;
+
+	return true;
+}
+
+bool TextureCooker::ReadLevels(const std::string& cookedFilePath, const CookedInfo& info, uint32_t topLevel, std::vector<uint8_t>& blocks) {
+	if (topLevel >= info.levelCount) {
+		return false;
+	}
+
+	std::ifstream file(cookedFilePath, std::ios::binary);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	uint64_t offset   = kDataOffset;
+	uint64_t byteSize = 0;
+
+	for (uint32_t level = 0; level < info.levelCount; ++level) {
+		if (level < topLevel) {
+			offset += GetLevelByteSize(info, level);
+
+		} else {
+			byteSize += GetLevelByteSize(info, level);
+		}
+	}
+
+	blocks.resize(byteSize);
+
+	file.seekg(static_cast<std::streamoff>(offset));
+	file.read(reinterpret_cast<char*>(blocks.data()), static_cast<std::streamsize>(byteSize));
+
+	return file.good();
+}
+
+uint64_t TextureCooker::GetLevelByteSize(const CookedInfo& info, uint32_t level) {
+	uint64_t blockWidth  = ((std::max)(info.width >> level, 1u) + 3) / 4;
+	uint64_t blockHeight = ((std::max)(info.height >> level, 1u) + 3) / 4;
+
+	return blockWidth * blockHeight * GetFormatBlockSize(info.dxgiFormat);
+}
+
+std::vector<std::string> TextureCooker::SplitCommandLine(const std::string& commandLine) {
+	std::vector<std::string> result;
+
+	std::string token;
+	bool        isQuoted = false;
+	bool        isToken  = false;
+
+	for (char c : commandLine) {
+		if (c == '"') {
+			isQuoted = !isQuoted;
+			isToken  = true;
+			continue;
+		}
+
+		if ((c == ' ' || c == '\t') && !isQuoted) {
+			if (isToken) {
+				result.push_back(token);
+				token.clear();
+				isToken = false;
+			}
+
+			continue;
+		}
+
+		token.push_back(c);
+		isToken = true;
+	}
+
+	if (isToken) {
+		result.push_back(token);
+	}
+
+	return result;
+}
+
+bool TextureCooker::ParseOption(const std::string& token, CookOptions& options) {
+	if (token == "--bc1") {
+		options.compression = TEXTURE_COMPRESSION_BC1;
+
+	} else if (token == "--bc3") {
+		options.compression = TEXTURE_COMPRESSION_BC3;
+
+	} else if (token == "--bc5") {
+		options.compression = TEXTURE_COMPRESSION_BC5;
+		options.mip.isSrgb  = false;
+
+	} else if (token == "--bc7") {
+		options.compression = TEXTURE_COMPRESSION_BC7;
+
+	} else if (token == "--linear") {
+		options.mip.isSrgb = false;
+
+	} else if (token == "--kaiser") {
+		options.mip.filter = MIP_FILTER_KAISER;
+
+	} else if (token == "--alpha-coverage") {
+		options.mip.isPreserveAlphaCoverage = true;
+
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+bool TextureCooker::ParseCommandLine(const std::string& commandLine, std::vector<std::string>& filePaths, CookOptions& options) {
+	std::vector<std::string> tokens = SplitCommandLine(commandLine);
+
+	if (tokens.empty() || tokens[0] != kCommandLineArg) {
+		return false;
+	}
+
+	filePaths.clear();
+	options = {};
+
+	for (size_t i = 1; i < tokens.size(); ++i) {
+		if (!ParseOption(tokens[i], options)) {
+			filePaths.push_back(tokens[i]);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// engine
+#include <MipGenerator.h>
+#include <BlockCompressor.h>
+#include <MeshCache.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureCooker namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace TextureCooker {
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const uint32_t kMagic   = MeshCache::MakeFourCC('C', 'T', 'E', 'X'); //!< DDS_HEADER::reserved1[0]
+	static const uint32_t kVersion = 1;                                          //!< formatを変更したら更新
+
+	static const char kExtension[]      = ".dds";
+	static const char kCommandLineArg[] = "--cook-texture";
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// CookedInfo structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct CookedInfo { //!< cookedファイルのheader
+		uint32_t dxgiFormat;
+		uint32_t width;
+		uint32_t height;
+		uint32_t levelCount;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// CookOptions structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct CookOptions {
+		TextureCompression compression = TEXTURE_COMPRESSION_BC7;
+		MipOptions         mip;             //!< isSrgbはDDSのformatにも使う. BC5は常にlinear
+		uint32_t           threadCount = 0; //!< 0の場合はParallel::GetThreadCount()
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 元画像のファイルパスからcookedファイルのパスを取得
+	std::string GetCookedFilePath(const std::string& filePath);
+
+	//! @brief DDSに書き込むDXGI_FORMATの値を取得
+	uint32_t GetDxgiFormat(TextureCompression compression, bool isSrgb);
+
+	//! @brief 一枚を4x4 block単位で圧縮. block行を分割して並列に処理する
+	//!
+	//! @param[in] image       8bit RGBAの画像. 4の倍数でない端はpixelを複製する
+	//! @param[in] compression 圧縮format
+	//! @param[in] threadCount 使用するスレッド数. 0の場合はParallel::GetThreadCount()
+	//!
+	//! @return blockを行順に並べたdataを返却
+	std::vector<uint8_t> Compress(const MipImage& image, TextureCompression compression, uint32_t threadCount = 0);
+
+	//! @brief mipmapを圧縮してDDSファイルに書き込む
+	//!
+	//! 元画像のhashはDDS_HEADER::reserved1に書き込み, 一般的なDDSとしても読み込める
+	//!
+	//! @param[in] filePath   cookedファイルパス
+	//! @param[in] chain      mipmap生成済みの画像. levels[0]の幅, 高さは4の倍数
+	//! @param[in] options    圧縮format
+	//! @param[in] sourceHash 元画像ファイルのhash (HashSource)
+	//!
+	//! @retval true  書き込み成功
+	//! @retval false 書き込み失敗, または4の倍数ではない
+	bool Write(const std::string& filePath, const MipChain& chain, const CookOptions& options, uint64_t sourceHash);
+
+	//! @brief cookedファイルに書き込む元画像のhash
+	//!
+	//! atlasの配置ファイル (.atlas) の場合は, 配置ファイルに含まれる全ての元画像のhashも合わせる
+	//!
+	//! @param[in] filePath 元画像, または配置ファイルのファイルパス
+	uint64_t HashSource(const std::string& filePath);
+
+	//! @brief cookedファイルが存在し, 元画像から変更がないか
+	//!
+	//! @param[in] filePath 元画像のファイルパス. .atlasの場合は各元画像の変更も確認する
+	bool IsFresh(const std::string& filePath);
+
+	//! @brief cookedファイルのheaderを読み込む
+	//!
+	//! @param[in]  cookedFilePath cookedファイルパス
+	//! @param[out] info           header
+	//!
+	//! @retval true  TextureCookerで書き込んだDDSだった
+	//! @retval false 読み込み失敗, または他のDDS
+	bool ReadInfo(const std::string& cookedFilePath, CookedInfo& info);
+
+	//! @brief topLevel以降のmipのblockだけを読み込む. それより大きいmipはseekで読み飛ばす
+	//!
+	//! @param[in]  cookedFilePath cookedファイルパス
+	//! @param[in]  info           ReadInfoの結果
+	//! @param[in]  topLevel       読み込む先頭のlevel
+	//! @param[out] blocks         各levelのblockを順に詰めたdata
+	//!
+	//! @retval true  読み込み成功
+	//! @retval false 読み込み失敗
+	bool ReadLevels(const std::string& cookedFilePath, const CookedInfo& info, uint32_t topLevel, std::vector<uint8_t>& blocks);
+
+	//! @brief levelのblockのbyteサイズ
+	uint64_t GetLevelByteSize(const CookedInfo& info, uint32_t level);
+
+	//! @brief 空白区切り. ""で囲まれた部分は一つとする
+	std::vector<std::string> SplitCommandLine(const std::string& commandLine);
+
+	//! @brief "--bc1"などの圧縮の指定を一つ解析
+	//!
+	//! @retval true  optionsに反映した
+	//! @retval false 圧縮の指定ではない
+	bool ParseOption(const std::string& token, CookOptions& options);
+
+	//! @brief "--cook-texture [--bc1|--bc3|--bc5|--bc7] [--linear] [--kaiser] [--alpha-coverage] files..." を解析
+	//!
+	//! @param[in]  commandLine コマンドライン引数
+	//! @param[out] filePaths   cookする元画像のファイルパス
+	//! @param[out] options     圧縮format
+	//!
+	//! @retval true  cookの指定だった
+	//! @retval false cookの指定ではない
+	bool ParseCommandLine(const std::string& commandLine, std::vector<std::string>& filePaths, CookOptions& options);
+
+}
\ No newline at end of file
@@ -6,14 +6,219 @@
 #include <windows.h>
 #include <Logger.h>
 
+// c++
+#include <cstring>
+#include <algorithm>
+
 #include <MyEngine.h>
 #include <DirectXCommon.h>
+#include <MipGenerator.h>
+#include <TextureCooker.h>
+#include <AtlasPacker.h>
+#include <Camera3D.h>
+#include <Environment.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief MipGeneratorで扱える8bit RGBAのformatか
+	bool IsMipGeneratorFormat(DXGI_FORMAT format) {
+		switch (format) {
+			case DXGI_FORMAT_R8G8B8A8_UNORM:
+			case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+			case DXGI_FORMAT_B8G8R8A8_UNORM:
+			case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
+	//! @brief textureのresourceが確保するbyteサイズ
+	uint64_t GetTextureByteSize(ID3D12Device* device, const DirectX::TexMetadata& metadata) {
+		D3D12_RESOURCE_DESC desc = {};
+		desc.Width            = UINT(metadata.width);
+		desc.Height           = UINT(metadata.height);
+		desc.MipLevels        = UINT16(metadata.mipLevels);
+		desc.DepthOrArraySize = UINT16(metadata.arraySize);
+		desc.Format           = metadata.format;
+		desc.SampleDesc.Count = 1;
+		desc.Dimension        = D3D12_RESOURCE_DIMENSION(metadata.dimension);
+
+		return device->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+	}
+
+	//! @brief metadataのmipの大きさ
+	MipRange GetMipRange(const DirectX::TexMetadata& metadata) {
+		return {
+			static_cast<uint32_t>(metadata.width), static_cast<uint32_t>(metadata.height), static_cast<uint32_t>(metadata.mipLevels),
+			0, DirectX::IsCompressed(metadata.format)
+		};
+	}
+
+	//! @brief topLevel以降のmipをコピー
+	HRESULT ExtractMips(const DirectX::ScratchImage& mipImage, uint32_t topLevel, DirectX::ScratchImage& result) {
+		const DirectX::TexMetadata& metadata = mipImage.GetMetadata();
+		const DirectX::Image*       top      = mipImage.GetImage(topLevel, 0, 0);
+
+		size_t levelCount = metadata.mipLevels - topLevel;
+
+		auto hr = result.Initialize2D(metadata.format, top->width, top->height, 1, levelCount);
+
+		if (FAILED(hr)) {
+			return hr;
+		}
+
+		for (size_t i = 0; i < levelCount; ++i) {
+			const DirectX::Image* source      = mipImage.GetImage(topLevel + i, 0, 0);
+			const DirectX::Image* destination = result.GetImage(i, 0, 0);
+
+			assert(source->slicePitch == destination->slicePitch);
+			std::memcpy(destination->pixels, source->pixels, source->slicePitch);
+		}
+
+		return hr;
+	}
+
+	//! @brief 幅, 高さがminimalMipSize以下のmipからmipmapの末尾をコピー
+	//!
+	//! @retval true  コピーした
+	//! @retval false level0が既にminimalMipSize以下, またはblock圧縮で4の倍数のmipがない
+	bool CreateMinimalImage(const DirectX::ScratchImage& mipImage, uint32_t minimalMipSize, DirectX::ScratchImage& minimalImage) {
+		const DirectX::TexMetadata& metadata = mipImage.GetMetadata();
+
+		if (metadata.width <= minimalMipSize && metadata.height <= minimalMipSize) {
+			return false;
+		}
+
+		uint32_t topLevel = TextureStreaming::GetTopLevel(GetMipRange(metadata), 1, minimalMipSize);
+
+		if (topLevel == 0) { //!< BCのresourceは先頭levelが4の倍数でなければならない
+			return false;
+		}
+
+		return SUCCEEDED(ExtractMips(mipImage, topLevel, minimalImage));
+	}
+
+	//! @brief levelから末尾までのmipを持つtextureのbyteサイズ
+	uint64_t GetStreamByteSize(ID3D12Device* device, const MipRange& range, uint32_t level, DXGI_FORMAT format) {
+		DirectX::TexMetadata metadata = {};
+		metadata.width     = TextureStreaming::GetLevelWidth(range, level);
+		metadata.height    = TextureStreaming::GetLevelHeight(range, level);
+		metadata.depth     = 1;
+		metadata.arraySize = 1;
+		metadata.mipLevels = range.levelCount - level;
+		metadata.format    = format;
+		metadata.dimension = DirectX::TEX_DIMENSION_TEXTURE2D;
+
+		return GetTextureByteSize(device, metadata);
+	}
+
+	//! @brief WICでdecodeし, 8bit RGBAに変換
+	HRESULT DecodeRgba(const std::string& filePath, DirectX::ScratchImage& image) {
+		std::wstring filePathW = ToWstring(filePath); //!< wstringに変換
+
+		auto hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_NONE, nullptr, image);
+
+		if (FAILED(hr)) {
+			return hr;
+		}
+
+		// block圧縮, MipGeneratorはRGBAの順で扱う
+		if (image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM && image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) {
+			DirectX::ScratchImage converted = {};
+
+			hr = DirectX::Convert(
+				image.GetImages(), image.GetImageCount(), image.GetMetadata(),
+				DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT,
+				converted
+			);
+
+			if (FAILED(hr)) {
+				return hr;
+			}
+
+			image = std::move(converted);
+		}
+
+		return hr;
+	}
+
+	//! @brief 配置の元画像をdecodeしてatlasを生成
+	//!
+	//! @retval true  生成した
+	//! @retval false 元画像の読み込みに失敗, または配置と大きさが違う
+	bool BuildAtlasChain(const AtlasLayout& layout, const MipOptions& options, uint32_t threadCount, MipChain& chain) {
+		std::vector<DirectX::ScratchImage> images(layout.filePaths.size());
+		std::vector<MipImage>              sources(layout.filePaths.size());
+
+		for (size_t i = 0; i < layout.filePaths.size(); ++i) {
+			if (FAILED(DecodeRgba(layout.filePaths[i], images[i]))) {
+				return false;
+			}
+
+			const DirectX::Image* image = images[i].GetImage(0, 0, 0);
+			sources[i] = { image->pixels, static_cast<uint32_t>(image->width), static_cast<uint32_t>(image->height), image->rowPitch };
+
+			if (sources[i].width != layout.rects[i].width || sources[i].height != layout.rects[i].height) { //!< 配置後に元画像が変更された
+				return false;
+			}
+		}
+
+		chain = AtlasPacker::Build(sources, layout, options, threadCount);
+
+		return true;
+	}
+
+	//! @brief 配置ファイルから圧縮しないatlasを生成
+	HRESULT DecodeAtlas(const std::string& layoutPath, DirectX::ScratchImage& mipImage) {
+		AtlasLayout layout = {};
+
+		if (!AtlasPacker::ReadLayout(layoutPath, layout)) {
+			return E_FAIL;
+		}
+
+		MipChain chain = {};
+
+		if (!BuildAtlasChain(layout, {}, 0, chain)) {
+			return E_FAIL;
+		}
+
+		auto hr = mipImage.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, layout.width, layout.height, 1, chain.levels.size());
+
+		if (FAILED(hr)) {
+			return hr;
+		}
+
+		for (size_t level = 0; level < chain.levels.size(); ++level) {
+			const DirectX::Image* destination = mipImage.GetImage(level, 0, 0);
+			const MipImage&       source      = chain.levels[level];
+
+			for (uint32_t y = 0; y < source.height; ++y) {
+				std::memcpy(destination->pixels + destination->rowPitch * y, source.pixels + source.rowPitch * y, static_cast<size_t>(source.width) * 4);
+			}
+		}
+
+		return hr;
+	}
+
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Texture methods
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 void Texture::Load(const std::string& filePath, DirectXCommon* dxCommon) {
+	Create(TextureMethod::LoadTexture(filePath), dxCommon);
+
+	// 転送の完了を待つ
+	dxCommon->Sent();
+}
+
+void Texture::Create(const DirectX::ScratchImage& mipImage, DirectXCommon* dxCommon) {
 
 	// dxCommonの保存
 	dxCommon_ = dxCommon;
@@ -22,15 +227,14 @@ void Texture::Load(const std::string& filePath, DirectXCommon* dxCommon) {
 	ID3D12Device* device = dxCommon_->GetDeviceObj()->GetDevice();
 	ID3D12GraphicsCommandList* commandList = dxCommon->GetCommandList();
 
-	DirectX::ScratchImage mipImage = TextureMethod::LoadTexture(filePath);
 	const DirectX::TexMetadata metadata = mipImage.GetMetadata();
 
 	textureResource_ = TextureMethod::CreateTextureResource(device, metadata);
+	byteSize_        = GetTextureByteSize(device, metadata);
 	ComPtr<ID3D12Resource> intermediateResouce = TextureMethod::UploadTextureData(textureResource_.Get(), mipImage, device, commandList);
 
-	dxCommon->Sent();
-
-	intermediateResouce->Release();
+	// commandListの完了まで転送元を保持
+	dxCommon->PushStaging(std::move(intermediateResouce));
 
 	// SRV - shaderResourceViewの生成
 	{
@@ -69,65 +273,572 @@ TextureManager::TextureManager() {
 TextureManager::~TextureManager() {
 }
 
-void TextureManager::Init(DirectXCommon* dxCommon) {
+void TextureManager::Init(DirectXCommon* dxCommon, uint32_t workerCount) {
 	// dxCommonの保存
 	dxCommon_ = dxCommon;
 
-	// 初期texture
-	textures_["resources/uvChecker.png"];
-	textures_["resources/monsterBall.png"];
-	textures_["resources/model/uvChecker.png"];
-	textures_["resources/model/monsterBall.png"];
-	/*textures_["resources/model/checkerBoard.png"];*/
+	// 読み込み完了までのfallback. 白の1x1
+	{
+		DirectX::ScratchImage image = {};
+		auto hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 1, 1, 1, 1);
+		assert(SUCCEEDED(hr));
+
+		std::memset(image.GetPixels(), 0xFF, image.GetPixelsSize());
 
-	/*textures_["resources/particleDemo.png"];
-	textures_["resources/model/wireFrame.png"];*/
+		fallback_ = std::make_unique<Texture>(image, dxCommon_);
+	}
 
-	textures_["resources/model/grass.png"];
+	// workerスレッドの生成
+	isTerm_ = false;
 
-	for (auto& pair : textures_) {
-		pair.second.texture = std::make_unique<Texture>(pair.first, dxCommon_);
-		pair.second.referenceNum = 1;
+	for (uint32_t i = 0; i < (std::max)(workerCount, 1u); ++i) {
+		workers_.emplace_back(&TextureManager::Worker, this);
 	}
+
+	// 初期texture. decodeはworkerスレッドで並列に行い, 転送はまとめて実行する
+	LoadTexture("resources/uvChecker.png");
+	LoadTexture("resources/monsterBall.png");
+	LoadTexture("resources/model/uvChecker.png");
+	LoadTexture("resources/model/monsterBall.png");
+	/*LoadTexture("resources/model/checkerBoard.png");*/
+
+	/*LoadTexture("resources/particleDemo.png");
+	LoadTexture("resources/model/wireFrame.png");*/
+
+	LoadTexture("resources/model/grass.png");
+
+	Flush();
 }
 
 void TextureManager::Term() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isTerm_ = true;
+	}
+
+	condition_.notify_all();
+
+	for (auto& worker : workers_) {
+		worker.join();
+	}
 
-	for (auto& pair : textures_) {
-		pair.second.texture.reset();
-		pair.second.referenceNum = NULL;
+	workers_.clear();
+
+	requests_.clear();
+	streamRequests_.clear();
+	completed_.clear();
+
+	for (auto& data : textures_) {
+		if (data.handle != nullptr) {
+			data.handle->texture_.reset();
+			data.referenceNum = NULL;
+		}
 	}
 
 	textures_.clear();
+	freeIds_.clear();
+	ids_.clear();
+	atlasEntries_.clear();
+	fallback_.reset();
 	dxCommon_ = nullptr;
 }
 
-void TextureManager::LoadTexture(const std::string& filePath) {
-	auto it = textures_.find(filePath);
-	if (it != textures_.end()) { //!< 同一keyが見つかった場合
+TextureId TextureManager::LoadTexture(const std::string& filePath) {
+	assert(fallback_ != nullptr); //!< Init前に呼び出された
+
+	// atlasに含まれる元画像
+	if (auto atlas = atlasEntries_.find(filePath); atlas != atlasEntries_.end()) {
+		textures_[atlas->second.id].referenceNum++;
+		return atlas->second.id;
+	}
+
+	auto [it, isInserted] = ids_.try_emplace(filePath, kInvalidTextureId);
+
+	if (!isInserted) { //!< 同一keyが見つかった場合
 		// 参照数にインクリメント
-		textures_[filePath].referenceNum++;
-		return;
+		textures_[it->second].referenceNum++;
+		return it->second;
+	}
+
+	// slotの確保
+	TextureId id;
+
+	if (!freeIds_.empty()) {
+		id = freeIds_.back();
+		freeIds_.pop_back();
+
+	} else {
+		id = static_cast<TextureId>(textures_.size());
+		textures_.emplace_back();
+	}
+
+	it->second = id;
+
+	// textureの登録. 転送まではfallbackを返す
+	TextureData& data = textures_[id];
+	data.handle = std::make_shared<TextureHandle>();
+	data.handle->fallback_ = fallback_.get();
+	data.filePath      = filePath;
+	data.referenceNum  = 1;
+	data.lastUsedFrame = frame_;
+	data.isStreaming   = isStreaming_;
+
+	if (data.isStreaming) { //!< 小さいmipだけを先に読み込む
+		PushRequest(id, 0, kMinimalMipSize);
+
+	} else {
+		PushRequest(id);
+	}
+
+	return id;
+}
+
+TextureId TextureManager::LoadAtlas(const std::string& layoutPath) {
+	AtlasLayout layout = {};
+
+	if (!AtlasPacker::ReadLayout(layoutPath, layout)) {
+		Log("[TextureManager] failed to load atlas: " + layoutPath + "\n");
+		return kInvalidTextureId;
+	}
+
+	TextureId id = LoadTexture(layoutPath);
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(layout.filePaths.size()); ++i) {
+		if (ids_.contains(layout.filePaths[i])) { //!< 単独で読み込み済みの元画像
+			continue;
+		}
+
+		atlasEntries_[layout.filePaths[i]] = { id, AtlasPacker::MakeUvTransform(layout, i) };
 	}
 
-	// textureの登録
-	textures_[filePath].texture = std::make_unique<Texture>(filePath, dxCommon_);
-	textures_[filePath].referenceNum = 1;
+	return id;
 }
 
-void TextureManager::UnloadTexture(const std::string& filePath) {
-	auto it = textures_.find(filePath);
-	assert(it != textures_.end()); //!< 同一keyが見つからなかった
+TextureId TextureManager::CreateAtlas(const std::string& layoutPath, const std::vector<std::string>& filePaths, const AtlasOptions& options) {
+	if (!TextureMethod::PackAtlas(layoutPath, filePaths, options)) {
+		return kInvalidTextureId;
+	}
+
+	return LoadAtlas(layoutPath);
+}
+
+void TextureManager::UnloadTexture(TextureId id) {
+	assert(id < textures_.size() && textures_[id].handle != nullptr); //!< 解放済みのid
+
+	TextureData& data = textures_[id];
 
 	// 参照先が消える
-	textures_[filePath].referenceNum--;
+	data.referenceNum--;
+
+	if (data.referenceNum == 0 && !data.handle->IsReady()) { //!< 読み込み途中で参照先がない場合
+		// handleの参照がrequestのみとなり, Worker, Commitで破棄される
+		ReleaseTexture(id);
+	}
+
+	// 読み込み済みの場合は, 予算を超えるまでUpdateResidencyで解放しない
+}
+
+void TextureManager::SetPriority(TextureId id, int32_t priority) {
+	assert(id < textures_.size() && textures_[id].handle != nullptr); //!< 解放済みのid
+	textures_[id].priority = priority;
+}
+
+void TextureManager::RequestMip(TextureId id, const Sphere& sphere, const Camera3D& camera) {
+	assert(id < textures_.size() && textures_[id].handle != nullptr); //!< 解放済みのid
+
+	TextureData& data = textures_[id];
+
+	if (!data.isStreaming || data.minimalByteSize == 0) { //!< 最初の読み込み前
+		return;
+	}
+
+	float screenSize = TextureStreaming::ComputeScreenSize(
+		sphere, camera.GetCamera().translate, camera.GetProjectionMatrix().m[1][1], static_cast<float>(kWindowHeight)
+	);
+
+	uint32_t level = TextureStreaming::ComputeMipLevel(data.mips, screenSize, mipBias_);
+
+	if (data.requestedFrame != frame_) {
+		data.requestedFrame = frame_;
+		data.requestedLevel = level;
+		data.screenSize     = screenSize;
+		return;
+	}
+
+	// 同じframeの要求は大きい方
+	data.requestedLevel = (std::min)(data.requestedLevel, level);
+	data.screenSize     = (std::max)(data.screenSize, screenSize);
+}
+
+bool TextureManager::CookTexture(const std::string& filePath, const TextureCooker::CookOptions& options) {
+	return TextureMethod::CookTexture(filePath, options);
+}
+
+bool TextureManager::BuildAtlas(
+	const std::string& layoutPath, const std::vector<std::string>& filePaths,
+	const AtlasOptions& options, const TextureCooker::CookOptions& cookOptions) {
+	return TextureMethod::BuildAtlas(layoutPath, filePaths, options, cookOptions);
+}
+
+void TextureManager::Commit(uint32_t maxCount) {
+	uint32_t commitCount       = 0;
+	uint64_t streamingByteSize = 0;
+
+	while (commitCount < maxCount) {
+		Request request;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			if (completed_.empty()) {
+				return;
+			}
+
+			if (completed_.front().isStream) { //!< streamingのmipは1frameの転送量を制限する. 残りは次のframe
+				uint64_t byteSize = completed_.front().mipImage.GetPixelsSize();
+
+				if (streamingByteSize != 0 && streamingByteSize + byteSize > streamingByteBudget_) {
+					return;
+				}
+
+				streamingByteSize += byteSize;
+			}
+
+			request = std::move(completed_.front());
+			completed_.pop_front();
+		}
+
+		if (CommitRequest(request)) {
+			++commitCount;
+		}
+	}
+}
+
+void TextureManager::Flush() {
+	while (true) {
+		std::deque<Request> completed;
+		bool isFinished = false;
 
-	if (textures_[filePath].referenceNum == 0) { //!< 参照先がない場合
-		textures_[filePath].texture.reset();
-		textures_.erase(filePath);
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			completedCondition_.wait(lock, [this]() { return !completed_.empty() || (requests_.empty() && streamRequests_.empty() && workingCount_ == 0); });
+
+			completed.swap(completed_);
+			isFinished = requests_.empty() && streamRequests_.empty() && workingCount_ == 0;
+		}
+
+		for (auto& request : completed) {
+			CommitRequest(request);
+
+			if (dxCommon_->GetStagingQueue()->GetPendingByteSize() >= kMaxBatchByteSize) { //!< staging bufferが多すぎる場合は途中で実行
+				dxCommon_->Sent();
+			}
+		}
+
+		if (isFinished) {
+			break;
+		}
+	}
+
+	// 積んだ転送をまとめて実行し, staging bufferを解放
+	if (dxCommon_->GetStagingQueue()->GetPendingCount() != 0) {
+		dxCommon_->Sent();
 	}
 }
 
+void TextureManager::UpdateResidency() {
+	++frame_;
+
+	// 前frameに要求されたmipのうち, 読み込むもの
+	std::vector<TextureStreaming::Candidate> streams;
+
+	{
+		std::vector<TextureStreaming::Candidate> candidates;
+		uint32_t pendingCount = 0;
+
+		for (TextureId id = 0; id < static_cast<TextureId>(textures_.size()); ++id) {
+			const TextureData& data = textures_[id];
+
+			if (data.handle == nullptr || !data.handle->IsReady() || !data.isStreaming) {
+				continue;
+			}
+
+			if (data.isStreamPending) {
+				++pendingCount;
+				continue;
+			}
+
+			if (data.requestedFrame + 1 != frame_) {
+				continue;
+			}
+
+			uint32_t level = TextureStreaming::GetTopLevel(data.mips, data.requestedLevel);
+
+			if (level < data.mips.topLevel) { //!< 画面上の大きさに対してmipが足りない
+				candidates.push_back({ id, level, data.screenSize * static_cast<float>(data.mips.topLevel - level) });
+			}
+		}
+
+		if (pendingCount < kMaxStreamingRequestCount) {
+			streams = TextureStreaming::SelectRequests(candidates, kMaxStreamingRequestCount - pendingCount);
+		}
+	}
+
+	std::vector<int32_t> streamIndices(textures_.size(), -1); //!< streamsのindex
+
+	for (size_t i = 0; i < streams.size(); ++i) {
+		streamIndices[streams[i].id] = static_cast<int32_t>(i);
+	}
+
+	std::vector<TextureResidency::Entry> entries;
+	std::vector<TextureId>               ids; //!< entriesと同じ順
+
+	entries.reserve(textures_.size());
+	ids.reserve(textures_.size());
+
+	for (TextureId id = 0; id < static_cast<TextureId>(textures_.size()); ++id) {
+		TextureData& data = textures_[id];
+
+		if (data.handle == nullptr || !data.handle->IsReady()) {
+			continue;
+		}
+
+		TextureResidency::Entry entry = {};
+		entry.byteSize        = data.byteSize;
+		entry.minimalByteSize = data.minimalByteSize;
+		entry.lastUsedFrame   = data.lastUsedFrame;
+		entry.referenceNum    = data.referenceNum;
+		entry.priority        = data.priority;
+		entry.isMinimal       = data.isMinimal;
+
+		if (data.isRestoring) { //!< 読み込み待ちの全mipを予算に含め, 縮小の候補から外す
+			entry.lastUsedFrame = frame_;
+			entry.isMinimal     = false;
+		}
+
+		if (data.isStreamPending) { //!< 読み込み待ちのmipを予算に含め, 縮小の候補から外す
+			entry.byteSize      = data.streamByteSize;
+			entry.lastUsedFrame = frame_;
+
+		} else if (streamIndices[id] >= 0) { //!< 大きいmipの読み込みは, 最小mipからの復元として予算を判定する
+			data.streamByteSize = GetStreamByteSize(dxCommon_->GetDeviceObj()->GetDevice(), data.mips, streams[streamIndices[id]].level, data.format);
+
+			entry.byteSize        = data.streamByteSize;
+			entry.minimalByteSize = data.byteSize;
+			entry.lastUsedFrame   = (std::max)(data.lastUsedFrame, data.requestedFrame);
+			entry.isMinimal       = true;
+		}
+
+		entries.push_back(entry);
+		ids.push_back(id);
+	}
+
+	// 描画の記録前なので, 前frameまでのGPUの処理は完了している
+	for (const auto& action : TextureResidency::Plan(entries, budget_, frame_)) {
+		TextureId    id   = ids[action.index];
+		TextureData& data = textures_[id];
+
+		switch (action.action) {
+			case RESIDENCY_ACTION_RELEASE:
+				data.handle->texture_.reset();
+				ReleaseTexture(id);
+				break;
+
+			case RESIDENCY_ACTION_MINIMIZE:
+				assert(data.minimalImage.GetImageCount() != 0);
+				data.handle->texture_ = std::make_unique<Texture>(data.minimalImage, dxCommon_);
+				data.mips.topLevel = data.minimalLevel;
+
+				if (data.isStreaming) { //!< streamingは転送済みのmipのbyteサイズを持つ
+					data.byteSize = data.minimalByteSize;
+
+				} else {
+					data.isMinimal = true;
+				}
+				break;
+
+			case RESIDENCY_ACTION_RESTORE:
+				if (data.isStreaming) {
+					const TextureStreaming::Candidate& stream = streams[streamIndices[id]];
+
+					data.isStreamPending = true;
+					PushStreamRequest(id, stream.level, stream.priority);
+
+				} else {
+					data.isRestoring = true;
+					PushRequest(id);
+				}
+				break;
+		}
+	}
+}
+
+uint64_t TextureManager::GetResidentByteSize() const {
+	uint64_t result = 0;
+
+	for (const auto& data : textures_) {
+		if (data.handle != nullptr && data.handle->IsReady()) {
+			result += data.isMinimal ? data.minimalByteSize : data.byteSize;
+		}
+	}
+
+	return result;
+}
+
+uint32_t TextureManager::GetPendingCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return static_cast<uint32_t>(requests_.size() + streamRequests_.size() + completed_.size()) + workingCount_;
+}
+
+void TextureManager::Worker() {
+	// WICの使用にCOMの初期化が必要
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+	while (true) {
+		Request request;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return isTerm_ || !requests_.empty() || !streamRequests_.empty(); });
+
+			if (isTerm_) {
+				break;
+			}
+
+			if (!requests_.empty()) { //!< fallbackを表示しているtextureを先に読み込む
+				request = std::move(requests_.front());
+				requests_.pop_front();
+
+			} else {
+				std::pop_heap(streamRequests_.begin(), streamRequests_.end(), &TextureManager::ComparePriority);
+				request = std::move(streamRequests_.back());
+				streamRequests_.pop_back();
+			}
+
+			++workingCount_;
+		}
+
+		if (request.handle.use_count() > 1) { //!< 読み込み前にunloadされていない
+			request.isFailed = FAILED(TextureMethod::DecodeTexture(request.filePath, request.minLevel, request.maxTopSize, request.mipImage, request.range));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			completed_.push_back(std::move(request));
+			--workingCount_;
+		}
+
+		completedCondition_.notify_all();
+	}
+
+	CoUninitialize();
+}
+
+bool TextureManager::CommitRequest(Request& request) {
+	if (request.handle.use_count() == 1) { //!< 読み込み中にunloadされた
+		return false;
+	}
+
+	// unload後に再利用されたslotは別のhandleとなる
+	TextureData* data = (request.id < textures_.size() && textures_[request.id].handle == request.handle) ? &textures_[request.id] : nullptr;
+
+	if (request.isFailed) {
+		request.handle->isFailed_ = true;
+		Log("[TextureManager] failed to load: " + request.filePath + "\n");
+
+		if (data != nullptr && data->isRestoring) { //!< 全mipを読み込めない場合は最小mipのまま固定する
+			data->byteSize    = data->minimalByteSize;
+			data->isMinimal   = false;
+			data->isRestoring = false;
+		}
+
+		if (data != nullptr && data->isStreamPending) { //!< 大きいmipを読み込めない場合は現在のmipのまま固定する
+			data->isStreaming     = false;
+			data->isStreamPending = false;
+			data->minimalByteSize = data->byteSize;
+		}
+
+		return false;
+	}
+
+	// resourceの生成と転送の記録. 転送はcommandListの実行時に行われる
+	request.handle->texture_ = std::make_unique<Texture>(request.mipImage, dxCommon_);
+
+	if (data != nullptr) {
+		data->byteSize        = request.handle->texture_->GetByteSize();
+		data->lastUsedFrame   = (std::max)(data->lastUsedFrame, frame_);
+		data->isMinimal       = false;
+		data->isRestoring     = false;
+		data->isStreamPending = false;
+		data->mips            = request.range;
+		data->format          = request.mipImage.GetMetadata().format;
+
+		if (data->minimalByteSize == 0) { //!< 初回の読み込み
+			if (data->isStreaming) { //!< kMinimalMipSize以下のmipだけを読み込んでいる
+				data->minimalByteSize = data->byteSize;
+				data->minimalLevel    = request.range.topLevel;
+				data->minimalImage    = std::move(request.mipImage);
+
+			} else if (CreateMinimalImage(request.mipImage, kMinimalMipSize, data->minimalImage)) {
+				data->minimalByteSize = GetTextureByteSize(dxCommon_->GetDeviceObj()->GetDevice(), data->minimalImage.GetMetadata());
+				data->minimalLevel    = request.range.levelCount - static_cast<uint32_t>(data->minimalImage.GetMetadata().mipLevels);
+
+			} else {
+				data->minimalByteSize = data->byteSize;
+			}
+		}
+	}
+
+	return true;
+}
+
+void TextureManager::PushRequest(TextureId id, uint32_t minLevel, uint32_t maxTopSize) {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		Request request;
+		request.handle     = textures_[id].handle;
+		request.id         = id;
+		request.filePath   = textures_[id].filePath;
+		request.minLevel   = minLevel;
+		request.maxTopSize = maxTopSize;
+
+		requests_.push_back(std::move(request));
+	}
+
+	condition_.notify_one();
+}
+
+void TextureManager::PushStreamRequest(TextureId id, uint32_t level, float priority) {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		Request request;
+		request.handle   = textures_[id].handle;
+		request.id       = id;
+		request.filePath = textures_[id].filePath;
+		request.minLevel = level;
+		request.priority = priority;
+		request.isStream = true;
+
+		streamRequests_.push_back(std::move(request));
+		std::push_heap(streamRequests_.begin(), streamRequests_.end(), &TextureManager::ComparePriority);
+	}
+
+	condition_.notify_one();
+}
+
+void TextureManager::ReleaseTexture(TextureId id) {
+	ids_.erase(textures_[id].filePath);
+
+	// atlasの元画像は, 以降のLoadTextureで単独に読み込む
+	std::erase_if(atlasEntries_, [id](const auto& entry) { return entry.second.id == id; });
+
+	textures_[id] = {};
+	freeIds_.push_back(id);
+}
+
 //=========================================================================================
 // static methods
 //=========================================================================================
@@ -141,6 +852,31 @@ TextureManager* TextureManager::GetInstance() {
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 DirectX::ScratchImage TextureMethod::LoadTexture(const std::string& filePath) {
+	DirectX::ScratchImage mipImage = {};
+
+	auto hr = DecodeTexture(filePath, mipImage);
+	assert(SUCCEEDED(hr));
+
+	return mipImage;
+}
+
+HRESULT TextureMethod::DecodeTexture(const std::string& filePath, DirectX::ScratchImage& mipImage) {
+	// cook済みのDDSがあれば, mipmapごとそのまま使う
+	if (TextureCooker::IsFresh(filePath)) {
+		std::wstring cookedFilePathW = ToWstring(TextureCooker::GetCookedFilePath(filePath));
+
+		auto hr = DirectX::LoadFromDDSFile(cookedFilePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, mipImage);
+
+		if (SUCCEEDED(hr)) {
+			return hr;
+		}
+	}
+
+	// cookしていないatlasは元画像から生成
+	if (AtlasPacker::IsLayoutFile(filePath)) {
+		return DecodeAtlas(filePath, mipImage);
+	}
+
 	DirectX::ScratchImage image = {};
 	std::wstring filePathW = ToWstring(filePath); //!< wstringに変換
 
@@ -151,11 +887,46 @@ DirectX::ScratchImage TextureMethod::LoadTexture(const std::string& filePath) {
 		image
 	);
 
-	assert(SUCCEEDED(hr));
+	if (FAILED(hr)) {
+		return hr;
+	}
 
-	// MipMapsの生成
-	DirectX::ScratchImage mipImage = {};
+	const DirectX::TexMetadata& metadata = image.GetMetadata();
+
+	if (IsMipGeneratorFormat(metadata.format)) { //!< 8bit RGBAはMipGeneratorで生成
+		uint32_t width      = static_cast<uint32_t>(metadata.width);
+		uint32_t height     = static_cast<uint32_t>(metadata.height);
+		uint32_t levelCount = MipGenerator::GetLevelCount(width, height);
+
+		hr = mipImage.Initialize2D(metadata.format, width, height, 1, levelCount);
+
+		if (FAILED(hr)) {
+			return hr;
+		}
+
+		std::vector<MipImage> levels(levelCount);
+
+		for (uint32_t level = 0; level < levelCount; ++level) {
+			const DirectX::Image* mip = mipImage.GetImage(level, 0, 0);
+			levels[level] = { mip->pixels, static_cast<uint32_t>(mip->width), static_cast<uint32_t>(mip->height), mip->rowPitch };
+		}
 
+		// level0のコピー
+		const DirectX::Image* source = image.GetImage(0, 0, 0);
+
+		for (uint32_t y = 0; y < height; ++y) {
+			std::memcpy(levels[0].pixels + levels[0].rowPitch * y, source->pixels + source->rowPitch * y, static_cast<size_t>(width) * 4);
+		}
+
+		MipOptions options = {};
+		options.isSrgb = DirectX::IsSRGB(metadata.format);
+
+		MipGenerator::Generate(levels.data(), levelCount, options);
+
+		return S_OK;
+	}
+
+	// MipMapsの生成
 	hr = DirectX::GenerateMipMaps(
 		image.GetImages(),
 		image.GetImageCount(),
@@ -165,9 +936,136 @@ DirectX::ScratchImage TextureMethod::LoadTexture(const std::string& filePath) {
 		mipImage
 	);
 
-	assert(SUCCEEDED(hr));
+	return hr;
+}
 
-	return mipImage;
+bool TextureMethod::CookTexture(const std::string& filePath, const TextureCooker::CookOptions& options) {
+	DirectX::ScratchImage image = {};
+
+	if (FAILED(DecodeRgba(filePath, image))) {
+		return false;
+	}
+
+	const DirectX::Image* source = image.GetImage(0, 0, 0);
+
+	MipChain chain = MipGenerator::CreateChain(static_cast<uint32_t>(source->width), static_cast<uint32_t>(source->height));
+
+	for (uint32_t y = 0; y < chain.levels[0].height; ++y) {
+		std::memcpy(chain.levels[0].pixels + chain.levels[0].rowPitch * y, source->pixels + source->rowPitch * y, chain.levels[0].rowPitch);
+	}
+
+	MipOptions mipOptions = options.mip;
+	mipOptions.isSrgb = options.mip.isSrgb && options.compression != TEXTURE_COMPRESSION_BC5;
+
+	MipGenerator::Generate(chain, mipOptions, options.threadCount);
+
+	bool result = TextureCooker::Write(TextureCooker::GetCookedFilePath(filePath), chain, options, TextureCooker::HashSource(filePath));
+
+	Log("[TextureMethod::CookTexture] " + filePath + (result ? " -> " + TextureCooker::GetCookedFilePath(filePath) : " failed") + "\n");
+
+	return result;
+}
+
+bool TextureMethod::PackAtlas(const std::string& layoutPath, const std::vector<std::string>& filePaths, const AtlasOptions& options) {
+	std::vector<uint32_t> widths(filePaths.size());
+	std::vector<uint32_t> heights(filePaths.size());
+
+	for (size_t i = 0; i < filePaths.size(); ++i) { //!< 大きさだけを読み込む
+		DirectX::TexMetadata metadata = {};
+		std::wstring filePathW = ToWstring(filePaths[i]);
+
+		if (FAILED(DirectX::GetMetadataFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_NONE, metadata))) {
+			Log("[TextureMethod::PackAtlas] failed to load: " + filePaths[i] + "\n");
+			return false;
+		}
+
+		widths[i]  = static_cast<uint32_t>(metadata.width);
+		heights[i] = static_cast<uint32_t>(metadata.height);
+	}
+
+	AtlasLayout layout = {};
+	layout.filePaths = filePaths;
+
+	if (!AtlasPacker::Pack(widths, heights, options, layout)) {
+		Log("[TextureMethod::PackAtlas] " + layoutPath + " does not fit\n");
+		return false;
+	}
+
+	return AtlasPacker::WriteLayout(layoutPath, layout);
+}
+
+bool TextureMethod::BuildAtlas(
+	const std::string& layoutPath, const std::vector<std::string>& filePaths,
+	const AtlasOptions& options, const TextureCooker::CookOptions& cookOptions) {
+
+	AtlasLayout layout = {};
+	MipChain    chain  = {};
+
+	MipOptions mipOptions = cookOptions.mip;
+	mipOptions.isSrgb = cookOptions.mip.isSrgb && cookOptions.compression != TEXTURE_COMPRESSION_BC5;
+
+	bool result = PackAtlas(layoutPath, filePaths, options)
+		&& AtlasPacker::ReadLayout(layoutPath, layout)
+		&& BuildAtlasChain(layout, mipOptions, cookOptions.threadCount, chain)
+		&& TextureCooker::Write(TextureCooker::GetCookedFilePath(layoutPath), chain, cookOptions, TextureCooker::HashSource(layoutPath));
+
+	Log("[TextureMethod::BuildAtlas] " + layoutPath + (result ? " -> " + TextureCooker::GetCookedFilePath(layoutPath) : " failed") + "\n");
+
+	return result;
+}
+
+HRESULT TextureMethod::DecodeTexture(const std::string& filePath, uint32_t minLevel, uint32_t maxTopSize, DirectX::ScratchImage& mipImage, MipRange& range) {
+	// cook済みのDDSは先頭levelより大きいmipを読み飛ばす
+	if (TextureCooker::IsFresh(filePath)) {
+		std::string               cookedFilePath = TextureCooker::GetCookedFilePath(filePath);
+		TextureCooker::CookedInfo info           = {};
+		std::vector<uint8_t>      blocks;
+
+		if (TextureCooker::ReadInfo(cookedFilePath, info)) {
+			range          = { info.width, info.height, info.levelCount, 0, true };
+			range.topLevel = TextureStreaming::GetTopLevel(range, minLevel, maxTopSize);
+
+			if (TextureCooker::ReadLevels(cookedFilePath, info, range.topLevel, blocks)) {
+				auto hr = mipImage.Initialize2D(
+					static_cast<DXGI_FORMAT>(info.dxgiFormat),
+					TextureStreaming::GetLevelWidth(range, range.topLevel), TextureStreaming::GetLevelHeight(range, range.topLevel),
+					1, range.levelCount - range.topLevel
+				);
+
+				if (SUCCEEDED(hr)) {
+					size_t offset = 0;
+
+					for (size_t i = 0; i < mipImage.GetImageCount(); ++i) {
+						const DirectX::Image& image = mipImage.GetImages()[i];
+
+						assert(offset + image.slicePitch <= blocks.size());
+						std::memcpy(image.pixels, blocks.data() + offset, image.slicePitch);
+						offset += image.slicePitch;
+					}
+
+					return hr;
+				}
+			}
+		}
+	}
+
+	DirectX::ScratchImage image = {};
+
+	auto hr = DecodeTexture(filePath, image);
+
+	if (FAILED(hr)) {
+		return hr;
+	}
+
+	range          = GetMipRange(image.GetMetadata());
+	range.topLevel = TextureStreaming::GetTopLevel(range, minLevel, maxTopSize);
+
+	if (range.topLevel == 0) {
+		mipImage = std::move(image);
+		return hr;
+	}
+
+	return ExtractMips(image, range.topLevel, mipImage);
 }
 
 ID3D12Resource* TextureMethod::CreateTextureResource(ID3D12Device* device, const DirectX::TexMetadata& metadata) {
@@ -13,14 +13,33 @@
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 
 // ComPtr
 #include <ComPtr.h>
 
+// engine
+#include <TextureCooker.h>
+#include <TextureResidency.h>
+#include <TextureStreaming.h>
+#include <AtlasPacker.h>
+
 //-----------------------------------------------------------------------------------------
 // forward
 //-----------------------------------------------------------------------------------------
 class DirectXCommon;
+class Camera3D;
+
+//-----------------------------------------------------------------------------------------
+// using
+//-----------------------------------------------------------------------------------------
+using TextureId = uint32_t; //!< TextureManager::LoadTextureで返す番号. UnloadTextureで参照がなくなるまで変わらない
+
+static const TextureId kInvalidTextureId = UINT32_MAX;
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Texture class
@@ -35,13 +54,23 @@ public:
 	//! @brief コンストラクタ
 	Texture(const std::string& filePath, DirectXCommon* dxCommon) { Load(filePath, dxCommon); }
 
+	//! @brief コンストラクタ. 転送はcommandListに積むだけ
+	Texture(const DirectX::ScratchImage& mipImage, DirectXCommon* dxCommon) { Create(mipImage, dxCommon); }
+
 	//! @brief デストラクタ
 	~Texture() { Unload(); }
 
-	//! @brief テクスチャのロード
+	//! @brief テクスチャのロード. 転送の完了までGPUを待つ
 	//! 
 	//! @param[in] filePath ファイルパス
 	void Load(const std::string& filePath, DirectXCommon* dxCommon);
+
+	//! @brief decode済みのimageからresource, SRVを生成し, 転送をcommandListに積む
+	//! 
+	//! staging bufferはDirectXCommonがfence通過後に解放する
+	//! 
+	//! @param[in] mipImage mipmap生成済みのimage
+	void Create(const DirectX::ScratchImage& mipImage, DirectXCommon* dxCommon);
 	
 	//! @brief テクスチャの解放
 	void Unload();
@@ -51,21 +80,75 @@ public:
 	//! @return テクスチャのGPUハンドルを返却
 	const D3D12_GPU_DESCRIPTOR_HANDLE& GetHandle() const { return handleGPU_; }
 
+	//! @brief resourceが確保するbyteサイズを取得
+	uint64_t GetByteSize() const { return byteSize_; }
+
 private:
 
 	ComPtr<ID3D12Resource>      textureResource_;
 	D3D12_GPU_DESCRIPTOR_HANDLE handleGPU_;
 	uint32_t                    descriptorIndex_;
+	uint64_t                    byteSize_;
 
 	DirectXCommon* dxCommon_;
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureHandle class
+////////////////////////////////////////////////////////////////////////////////////////////
+class TextureHandle { //!< TextureManager::LoadTextureの結果. GPUに転送されるまではfallbackを返す
+public:
+
+	//=========================================================================================
+	// public methods
+	//=========================================================================================
+
+	//! @brief resourceの生成, 転送の記録まで完了しているか
+	bool IsReady() const { return texture_ != nullptr; }
+
+	//! @brief 読み込みに失敗したか. 失敗した場合はfallbackのまま
+	bool IsFailed() const { return isFailed_; }
+
+	//! @brief 描画に使うtextureのGPUハンドルを取得
+	//!
+	//! @return 転送後は読み込んだtexture, それまではfallbackのGPUハンドルを返却
+	const D3D12_GPU_DESCRIPTOR_HANDLE& GetHandle() const { return texture_ != nullptr ? texture_->GetHandle() : fallback_->GetHandle(); }
+
+private:
+
+	//=========================================================================================
+	// private variables
+	//=========================================================================================
+
+	friend class TextureManager;
+
+	std::unique_ptr<Texture> texture_;
+	const Texture*           fallback_ = nullptr;
+	bool                     isFailed_ = false;
+
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // TextureManager class
 ////////////////////////////////////////////////////////////////////////////////////////////
 class TextureManager {
 public:
 
+	//=========================================================================================
+	// public variables
+	//=========================================================================================
+
+	static const uint32_t kDefaultWorkerCount = 2;
+	static const uint32_t kDefaultCommitCount = 4; //!< 1frameあたりにresourceを生成するtexture数
+
+	static const uint64_t kMaxBatchByteSize = 256ull << 20; //!< Flushで一度に転送するstaging bufferの上限
+
+	static const uint64_t kDefaultBudget = 512ull << 20; //!< textureのresidentなbyteサイズの上限
+	static const uint32_t kMinimalMipSize = 64;          //!< 縮小時に残すmipの幅, 高さの上限. streamingでは最初に読み込むmip
+
+	static const uint64_t kDefaultStreamingByteBudget = 16ull << 20; //!< 1frameで転送するstreamingのmipのbyteサイズ
+	static const uint32_t kMaxStreamingRequestCount   = 8;           //!< 同時に読み込むstreamingのrequest数
+
 	//=========================================================================================
 	// public methods
 	//=========================================================================================
@@ -76,22 +159,168 @@ public:
 	//! @brief デストラクタ
 	~TextureManager();
 
-	//! @brief 初期化処理
-	void Init(DirectXCommon* dxCommon);
+	//! @brief 初期化処理. workerスレッドとfallbackのtextureを生成
+	//!
+	//! @param[in] workerCount workerスレッド数
+	void Init(DirectXCommon* dxCommon, uint32_t workerCount = kDefaultWorkerCount);
 
-	//! @brief 終了処理
+	//! @brief 終了処理. 読み込み途中のrequestは破棄される
 	void Term();
 
-	const D3D12_GPU_DESCRIPTOR_HANDLE& GetHandleGPU(const std::string& key) const {
-		auto it = textures_.find(key);
-		assert(it != textures_.end());
+	//! @brief textureのGPUハンドルを取得. 使用したframeを記録する
+	//!
+	//! @return 転送前はfallback, 縮小中は最小mipのGPUハンドルを返却
+	const D3D12_GPU_DESCRIPTOR_HANDLE& GetHandleGPU(TextureId id) {
+		assert(id < textures_.size() && textures_[id].handle != nullptr); //!< 解放済みのid
 
-		return it->second.texture->GetHandle();
+		textures_[id].lastUsedFrame = frame_;
+		return textures_[id].handle->GetHandle();
 	}
 
-	void LoadTexture(const std::string& filePath);
+	//! @brief keyからGPUハンドルを取得. 毎frame呼び出す場合はGetTextureIdの結果を保持すること
+	const D3D12_GPU_DESCRIPTOR_HANDLE& GetHandleGPU(const std::string& key) { return GetHandleGPU(GetTextureId(key)); }
 
-	void UnloadTexture(const std::string& filePath);
+	//! @brief keyからidを取得
+	//!
+	//! @return 読み込まれていない場合はkInvalidTextureId, atlasの元画像の場合はatlasのidを返却
+	TextureId GetTextureId(const std::string& key) const {
+		if (auto it = ids_.find(key); it != ids_.end()) {
+			return it->second;
+		}
+
+		auto atlas = atlasEntries_.find(key);
+		return atlas != atlasEntries_.end() ? atlas->second.id : kInvalidTextureId;
+	}
+
+	//! @brief 読み込み状態の取得用handle
+	const std::shared_ptr<TextureHandle>& GetTextureHandle(TextureId id) const {
+		assert(id < textures_.size() && textures_[id].handle != nullptr); //!< 解放済みのid
+		return textures_[id].handle;
+	}
+
+	//! @brief textureの読み込みをworkerスレッドに依頼. 読み込み済みの場合は参照数を増やす
+	//!
+	//! decode, mipmapの生成はworkerスレッド, resourceの生成と転送の記録はCommitで行う.
+	//! atlasに含まれる元画像の場合はatlasの参照数を増やし, atlasのidを返す
+	//!
+	//! @param[in] filePath ファイルパス
+	//!
+	//! @return idを返却. 転送まではfallbackを返す
+	TextureId LoadTexture(const std::string& filePath);
+
+	//! @brief 配置ファイルのatlasを読み込み, 以降の元画像のLoadTextureをatlasに置き換える
+	//!
+	//! cook済みのDDSがあればそれを, なければworkerスレッドで元画像からatlasを生成する.
+	//! 既に単独で読み込まれている元画像は置き換えない. atlasの参照はUnloadTextureで減らす
+	//!
+	//! @param[in] layoutPath 配置ファイルのパス
+	//!
+	//! @return atlasのidを返却. 配置ファイルを読み込めない場合はkInvalidTextureId
+	TextureId LoadAtlas(const std::string& layoutPath);
+
+	//! @brief 元画像を配置して配置ファイルを書き出し, LoadAtlasで読み込む
+	//!
+	//! @param[in] layoutPath 書き出す配置ファイルのパス
+	//! @param[in] filePaths  まとめる元画像のファイルパス
+	//! @param[in] options    padding, 大きさの上限
+	//!
+	//! @return atlasのidを返却. 配置できない場合はkInvalidTextureId
+	TextureId CreateAtlas(const std::string& layoutPath, const std::vector<std::string>& filePaths, const AtlasOptions& options = {});
+
+	//! @brief 元画像のuvをatlas上のuvに変換する行列. Material::uvTransformの右から掛ける. modelのmaterialはModel::GetUvTransformで掛ける
+	//!
+	//! @return atlasに含まれない場合は単位行列を返却
+	Matrix4x4 GetUvTransform(const std::string& filePath) const {
+		auto it = atlasEntries_.find(filePath);
+		return it != atlasEntries_.end() ? it->second.uvTransform : Matrix4x4::MakeIdentity();
+	}
+
+	//! @brief 参照数を減らす. 参照がなくなったtextureは予算を超えるまで保持し, 再度のLoadTextureで使う
+	//!
+	//! 参照がなくなったidは, 再度のLoadTextureで別の値になる場合がある
+	void UnloadTexture(TextureId id);
+
+	void UnloadTexture(const std::string& filePath) { UnloadTexture(GetTextureId(filePath)); }
+
+	//! @brief 予算を超えた時に縮小する順番を設定. 低いものから縮小される
+	void SetPriority(TextureId id, int32_t priority);
+
+	//! @brief 以降のLoadTextureをstreamingで読み込むか
+	//!
+	//! streamingのtextureは最初にkMinimalMipSize以下のmipだけを読み込み, RequestMipで要求された
+	//! 大きいmipを優先度順に読み込む. cook済みのDDSは必要なmipだけをファイルから読み込む
+	void SetStreaming(bool isStreaming) { isStreaming_ = isStreaming; }
+
+	bool IsStreaming() const { return isStreaming_; }
+
+	//! @brief 描画するmeshの画面上の大きさから必要なmipを要求. streamingのtexture以外は何もしない
+	//!
+	//! frame中の要求のうち最も大きいmipを, 次のUpdateResidencyで読み込む
+	//!
+	//! @param[in] id     texture
+	//! @param[in] sphere textureを貼るmeshのworld空間の境界球
+	//! @param[in] camera 描画に使うカメラ
+	void RequestMip(TextureId id, const Sphere& sphere, const Camera3D& camera);
+
+	//! @brief 1frameで転送するstreamingのmipのbyteサイズ. 一つのmipはこれを超えても転送する
+	void SetStreamingByteBudget(uint64_t byteSize) { streamingByteBudget_ = byteSize; }
+
+	//! @brief streamingで選ぶmipのbias. 正の値でより小さいmipを選ぶ
+	void SetMipBias(float bias) { mipBias_ = bias; }
+
+	//! @brief textureをblock圧縮したDDSを書き出す. 以降のLoadTextureではDDSが使われる
+	//!
+	//! 読み込み済みのtextureは置き換えない
+	//!
+	//! @param[in] filePath 元画像のファイルパス
+	//! @param[in] options  圧縮format
+	//!
+	//! @retval true  書き出し成功
+	//! @retval false 読み込み, 書き出しに失敗. または幅, 高さが4の倍数ではない
+	bool CookTexture(const std::string& filePath, const TextureCooker::CookOptions& options = {});
+
+	//! @brief 元画像を配置し, block圧縮したatlasのDDSと配置ファイルを書き出す. 以降のLoadAtlasではDDSが使われる
+	//!
+	//! @param[in] layoutPath  書き出す配置ファイルのパス
+	//! @param[in] filePaths   まとめる元画像のファイルパス
+	//! @param[in] options     padding, 大きさの上限
+	//! @param[in] cookOptions 圧縮format
+	//!
+	//! @retval true  書き出し成功
+	//! @retval false 読み込み, 配置, 書き出しに失敗
+	bool BuildAtlas(
+		const std::string& layoutPath, const std::vector<std::string>& filePaths,
+		const AtlasOptions& options = {}, const TextureCooker::CookOptions& cookOptions = {}
+	);
+
+	//! @brief workerスレッドの処理が終わったtextureのresourceを生成し, 転送をcommandListに積む. 描画スレッドから呼び出す
+	//!
+	//! @param[in] maxCount 生成するtextureの最大数
+	void Commit(uint32_t maxCount = kDefaultCommitCount);
+
+	//! @brief 読み込み途中のtextureを全て転送する. frameの記録外で呼び出す
+	//!
+	//! resourceの生成と転送の記録をまとめて行い, commandListの実行とGPUの完了待ちは
+	//! staging bufferがkMaxBatchByteSizeを超えた時と最後の一度だけ行う
+	void Flush();
+
+	//! @brief frameを進め, 予算を超えている場合は使われていないtextureを解放, 縮小する. 描画スレッドから呼び出す
+	//!
+	//! 参照のないtextureは解放, 参照のあるtextureは最小mipに置き換える.
+	//! 縮小したtextureが再び使われた場合は, 予算に収まれば全mipを読み込み直す.
+	//! streamingのtextureは前frameに要求されたmipを, 予算に収まる範囲で読み込む
+	void UpdateResidency();
+
+	//! @brief residentなbyteサイズの上限を設定
+	void SetBudget(uint64_t budget) { budget_ = budget; }
+
+	uint64_t GetBudget() const { return budget_; }
+
+	//! @brief 読み込み済みtextureのbyteサイズの合計
+	uint64_t GetResidentByteSize() const;
+
+	//! @brief 読み込み途中のrequest数
+	uint32_t GetPendingCount();
 
 	static TextureManager* GetInstance();
 
@@ -101,18 +330,114 @@ private:
 	// TextureData structure
 	////////////////////////////////////////////////////////////////////////////////////////////
 	struct TextureData {
-		std::unique_ptr<Texture> texture;
-		uint32_t referenceNum = 0;
+		std::shared_ptr<TextureHandle> handle; //!< nullptrの場合は空きslot
+		std::string                    filePath;
+		uint32_t                       referenceNum = 0;
+
+		// residency
+		int32_t               priority        = 0;
+		uint64_t              lastUsedFrame   = 0;
+		uint64_t              byteSize        = 0; //!< 全mipのbyteサイズ
+		uint64_t              minimalByteSize = 0;
+		DirectX::ScratchImage minimalImage;          //!< 縮小時に使うmip. 縮小できない場合は空
+		uint32_t              minimalLevel    = 0;     //!< minimalImageの先頭level
+		bool                  isMinimal       = false;
+		bool                  isRestoring     = false; //!< 全mipの読み込み待ち
+
+		// streaming
+		MipRange    mips            = {};    //!< GPUにあるmip
+		DXGI_FORMAT format          = DXGI_FORMAT_UNKNOWN;
+		bool        isStreaming     = false; //!< byteSizeは転送済みのmipのbyteサイズ
+		bool        isStreamPending = false; //!< 大きいmipの読み込み待ち
+		uint64_t    streamByteSize  = 0;     //!< 読み込み待ちのmipのbyteサイズ
+		uint32_t    requestedLevel  = 0;
+		uint64_t    requestedFrame  = 0;
+		float       screenSize      = 0.0f;  //!< requestedFrameでの画面上の大きさ
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// AtlasEntry structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct AtlasEntry { //!< atlasに含まれる元画像
+		TextureId id;          //!< atlasのid
+		Matrix4x4 uvTransform;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Request structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Request {
+		std::shared_ptr<TextureHandle> handle;
+		TextureId                      id = kInvalidTextureId;
+		std::string                    filePath;
+		uint32_t                       minLevel   = 0;     //!< 読み込む先頭levelの下限
+		uint32_t                       maxTopSize = 0;     //!< 先頭levelの幅, 高さの上限. 0の場合は制限しない
+		float                          priority   = 0.0f;  //!< streamingの優先度
+		bool                           isStream   = false; //!< streamingの大きいmip
+		DirectX::ScratchImage          mipImage; //!< workerスレッドの処理結果
+		MipRange                       range    = {};
+		bool                           isFailed = false;
 	};
 
 	//=========================================================================================
 	// private variables
 	//=========================================================================================
 
-	std::unordered_map<std::string, TextureData> textures_;
-	//!< key = filePath, value = texture
+	std::vector<TextureData>                   textures_; //!< index = TextureId
+	std::vector<TextureId>                     freeIds_;  //!< 空きslot
+	std::unordered_map<std::string, TextureId> ids_;
+	//!< key = filePath, value = texturesのindex. 読み込みとkeyの検索にのみ使う
+
+	std::unordered_map<std::string, AtlasEntry> atlasEntries_; //!< key = 元画像のfilePath
 
 	DirectXCommon* dxCommon_;
+
+	std::vector<std::thread> workers_;
+
+	std::mutex              mutex_;
+	std::condition_variable condition_;
+	std::condition_variable completedCondition_; //!< Flushの待機用
+	std::deque<Request>     requests_;  //!< workerスレッドの処理待ち
+	std::vector<Request>    streamRequests_; //!< streamingの処理待ち. priorityのheap. requestsの後に処理する
+	std::deque<Request>     completed_; //!< Commit待ち
+	uint32_t                workingCount_ = 0;
+	bool                    isTerm_       = false;
+
+	std::unique_ptr<Texture> fallback_;
+
+	uint64_t budget_ = kDefaultBudget;
+	uint64_t frame_  = 0;
+
+	bool     isStreaming_         = false;
+	uint64_t streamingByteBudget_ = kDefaultStreamingByteBudget;
+	float    mipBias_             = 0.0f;
+
+	//=========================================================================================
+	// private methods
+	//=========================================================================================
+
+	void Worker();
+
+	//! @brief requestのresourceを生成し, 転送をcommandListに積む
+	//!
+	//! @return resourceを生成した場合true
+	bool CommitRequest(Request& request);
+
+	//! @brief workerスレッドに読み込みを依頼
+	//!
+	//! @param[in] minLevel   読み込む先頭levelの下限
+	//! @param[in] maxTopSize 先頭levelの幅, 高さの上限. 0の場合は制限しない
+	void PushRequest(TextureId id, uint32_t minLevel = 0, uint32_t maxTopSize = 0);
+
+	//! @brief workerスレッドにstreamingのmipの読み込みを依頼. 通常のrequestの後に優先度順で処理される
+	void PushStreamRequest(TextureId id, uint32_t level, float priority);
+
+	//! @brief streamRequestsのheapの比較
+	static bool ComparePriority(const Request& a, const Request& b) { return a.priority < b.priority; }
+
+	//! @brief slotを空け, keyとatlasの元画像を削除
+	void ReleaseTexture(TextureId id);
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -122,6 +447,64 @@ namespace TextureMethod {
 
 	DirectX::ScratchImage LoadTexture(const std::string& filePath);
 
+	//! @brief 元画像をmipmap生成, block圧縮してcookedファイルに書き出す
+	//!
+	//! @param[in] filePath 元画像のファイルパス
+	//! @param[in] options  圧縮format
+	//!
+	//! @retval true  書き出し成功
+	//! @retval false 読み込み, 書き出しに失敗
+	bool CookTexture(const std::string& filePath, const TextureCooker::CookOptions& options);
+
+	//! @brief 元画像の大きさから配置を決め, 配置ファイルを書き出す
+	//!
+	//! @param[in] layoutPath 配置ファイルのパス
+	//! @param[in] filePaths  まとめる元画像のファイルパス
+	//! @param[in] options    padding, 大きさの上限
+	//!
+	//! @retval true  書き出し成功
+	//! @retval false 読み込み, 配置, 書き出しに失敗
+	bool PackAtlas(const std::string& layoutPath, const std::vector<std::string>& filePaths, const AtlasOptions& options);
+
+	//! @brief PackAtlasの後, atlasをmipmap生成, block圧縮してcookedファイルに書き出す
+	//!
+	//! @param[in] layoutPath  配置ファイルのパス. atlasはTextureCooker::GetCookedFilePathに書き出す
+	//! @param[in] filePaths   まとめる元画像のファイルパス
+	//! @param[in] options     padding, 大きさの上限
+	//! @param[in] cookOptions 圧縮format
+	//!
+	//! @retval true  書き出し成功
+	//! @retval false 読み込み, 配置, 書き出しに失敗
+	bool BuildAtlas(
+		const std::string& layoutPath, const std::vector<std::string>& filePaths,
+		const AtlasOptions& options, const TextureCooker::CookOptions& cookOptions
+	);
+
+	//! @brief textureのdecodeとmipmapの生成. 失敗してもassertしない
+	//!
+	//! 元画像と一致するcookedファイルがある場合はそちらを読み込む.
+	//! cookしていない配置ファイルは元画像から圧縮しないatlasを生成する
+	//!
+	//! @param[in]  filePath ファイルパス
+	//! @param[out] mipImage mipmap生成済みのimage
+	//!
+	//! @return 失敗した場合はFAILEDとなるHRESULTを返却
+	HRESULT DecodeTexture(const std::string& filePath, DirectX::ScratchImage& mipImage);
+
+	//! @brief 先頭levelを指定してtextureを読み込む. 失敗してもassertしない
+	//!
+	//! cook済みのDDSは先頭levelより大きいmipをファイルから読み込まない.
+	//! それ以外は全mipをdecodeしてから先頭level以降を取り出す
+	//!
+	//! @param[in]  filePath   ファイルパス
+	//! @param[in]  minLevel   先頭levelの下限
+	//! @param[in]  maxTopSize 先頭levelの幅, 高さの上限. 0の場合は制限しない
+	//! @param[out] mipImage   先頭level以降のmip
+	//! @param[out] range      全mipの大きさと先頭level
+	//!
+	//! @return 失敗した場合はFAILEDとなるHRESULTを返却
+	HRESULT DecodeTexture(const std::string& filePath, uint32_t minLevel, uint32_t maxTopSize, DirectX::ScratchImage& mipImage, MipRange& range);
+
 	ID3D12Resource* CreateTextureResource(ID3D12Device* device, const DirectX::TexMetadata& metadata);
 
 	[[nodiscard]]
@@ -0,0 +1,154 @@
+#include "TextureResidency.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief 使用中か
+	bool IsInUse(const TextureResidency::Entry& entry, uint64_t currentFrame, uint32_t idleFrameCount) {
+		return currentFrame < entry.lastUsedFrame + idleFrameCount;
+	}
+
+	//! @brief 解放, 縮小で減るbyteサイズ
+	uint64_t GetFreeableByteSize(const TextureResidency::Entry& entry) {
+		if (entry.referenceNum == 0) {
+			return TextureResidency::GetResidentByteSize(entry);
+		}
+
+		if (entry.isMinimal || entry.byteSize <= entry.minimalByteSize) {
+			return 0;
+		}
+
+		return entry.byteSize - entry.minimalByteSize;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureResidency methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+uint64_t TextureResidency::GetResidentByteSize(const Entry& entry) {
+	return entry.isMinimal ? entry.minimalByteSize : entry.byteSize;
+}
+
+uint64_t TextureResidency::GetResidentByteSize(const std::vector<Entry>& entries) {
+	uint64_t result = 0;
+
+	for (const auto& entry : entries) {
+		result += GetResidentByteSize(entry);
+	}
+
+	return result;
+}
+
+std::vector<TextureResidency::Action> TextureResidency::Plan(
+	const std::vector<Entry>& entries, uint64_t budget, uint64_t currentFrame, uint32_t idleFrameCount) {
+
+	std::vector<Action> result;
+
+	uint64_t residentByteSize = GetResidentByteSize(entries);
+
+	// 解放, 縮小の候補. 参照なし -> priority -> 古い順
+	std::vector<uint32_t> victims;
+	uint64_t              freeableByteSize = 0;
+
+	// 戻す候補. priority -> 新しい順
+	std::vector<uint32_t> restores;
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(entries.size()); ++i) {
+		const Entry& entry = entries[i];
+
+		if (IsInUse(entry, currentFrame, idleFrameCount)) {
+			if (entry.isMinimal && entry.referenceNum != 0) {
+				restores.push_back(i);
+			}
+
+			continue;
+		}
+
+		uint64_t freeable = GetFreeableByteSize(entry);
+
+		if (freeable != 0) {
+			victims.push_back(i);
+			freeableByteSize += freeable;
+		}
+	}
+
+	std::sort(victims.begin(), victims.end(), [&](uint32_t a, uint32_t b) {
+		const Entry& lhs = entries[a];
+		const Entry& rhs = entries[b];
+
+		if ((lhs.referenceNum == 0) != (rhs.referenceNum == 0)) {
+			return lhs.referenceNum == 0;
+		}
+
+		if (lhs.priority != rhs.priority) {
+			return lhs.priority < rhs.priority;
+		}
+
+		if (lhs.lastUsedFrame != rhs.lastUsedFrame) {
+			return lhs.lastUsedFrame < rhs.lastUsedFrame;
+		}
+
+		return a < b;
+	});
+
+	std::sort(restores.begin(), restores.end(), [&](uint32_t a, uint32_t b) {
+		const Entry& lhs = entries[a];
+		const Entry& rhs = entries[b];
+
+		if (lhs.priority != rhs.priority) {
+			return lhs.priority > rhs.priority;
+		}
+
+		if (lhs.lastUsedFrame != rhs.lastUsedFrame) {
+			return lhs.lastUsedFrame > rhs.lastUsedFrame;
+		}
+
+		return a < b;
+	});
+
+	size_t victimIndex = 0;
+
+	// victimsを先頭から解放, 縮小し, targetByteSize以下にする
+	auto Evict = [&](uint64_t targetByteSize) {
+		while (residentByteSize > targetByteSize && victimIndex < victims.size()) {
+			uint32_t     index = victims[victimIndex++];
+			const Entry& entry = entries[index];
+			uint64_t     freeable = GetFreeableByteSize(entry);
+
+			result.push_back({ index, entry.referenceNum == 0 ? RESIDENCY_ACTION_RELEASE : RESIDENCY_ACTION_MINIMIZE });
+
+			residentByteSize -= freeable;
+			freeableByteSize -= freeable;
+		}
+	};
+
+	// 予算を超えている分
+	Evict(budget);
+
+	// 使用中の最小mipを, 使われていないtextureを縮小して収まる場合に戻す
+	for (uint32_t index : restores) {
+		const Entry& entry = entries[index];
+		uint64_t     required = entry.byteSize - entry.minimalByteSize;
+
+		if (required > budget || residentByteSize - freeableByteSize + required > budget) {
+			continue;
+		}
+
+		Evict(budget - required);
+
+		result.push_back({ index, RESIDENCY_ACTION_RESTORE });
+		residentByteSize += required;
+	}
+
+	return result;
+}
\ No newline at end of file
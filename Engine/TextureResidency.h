@@ -0,0 +1,78 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+#include <vector>
+
+//-----------------------------------------------------------------------------------------
+// enum
+//-----------------------------------------------------------------------------------------
+enum ResidencyAction {
+	RESIDENCY_ACTION_RELEASE,  //!< 参照のないtextureを解放
+	RESIDENCY_ACTION_MINIMIZE, //!< 最小mipのtextureに置き換える
+	RESIDENCY_ACTION_RESTORE,  //!< 全mipを読み込み直す
+
+	kResidencyActionCount
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureResidency namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace TextureResidency { //!< textureのメモリ予算の判定. D3D12に依存しない
+
+	//-----------------------------------------------------------------------------------------
+	// constant
+	//-----------------------------------------------------------------------------------------
+	static const uint32_t kDefaultIdleFrameCount = 2; //!< このframe数以内に使われたtextureは使用中として扱う
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Entry structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Entry {
+		uint64_t byteSize;        //!< 全mipのbyteサイズ
+		uint64_t minimalByteSize; //!< 最小mipのbyteサイズ. 縮小できない場合はbyteSizeと同じ
+		uint64_t lastUsedFrame;
+		uint32_t referenceNum;
+		int32_t  priority;        //!< 低いものから縮小する
+		bool     isMinimal;       //!< 最小mipに置き換え済み
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Action structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Action {
+		uint32_t        index; //!< entriesのindex
+		ResidencyAction action;
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 現在のbyteサイズ
+	uint64_t GetResidentByteSize(const Entry& entry);
+
+	//! @brief 全entryのbyteサイズの合計
+	uint64_t GetResidentByteSize(const std::vector<Entry>& entries);
+
+	//! @brief 予算に収めるための処理を決める
+	//!
+	//! 使われていないtextureを, 参照のないもの, priorityの低いもの, 最後に使われたframeの古いものの順に
+	//! 解放, 縮小する. 最小mipで使用中のtextureは予算に収まる場合に限り, priorityの高いものから戻す.
+	//! 使用中のtextureは縮小しないため, 使用中のtextureだけで予算を超える場合は超えたままとなる
+	//!
+	//! @param[in] entries        texture毎の状態
+	//! @param[in] budget         予算のbyteサイズ
+	//! @param[in] currentFrame   現在のframe
+	//! @param[in] idleFrameCount このframe数以内に使われたtextureは使用中
+	//!
+	//! @return 解放, 縮小, 戻すtextureを実行順に返却
+	std::vector<Action> Plan(
+		const std::vector<Entry>& entries, uint64_t budget, uint64_t currentFrame,
+		uint32_t idleFrameCount = kDefaultIdleFrameCount
+	);
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "TextureStreaming.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureStreaming methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+float TextureStreaming::ComputeScreenSize(const Sphere& sphere, const Vector3f& cameraPosition, float projectionScale, float screenHeight) {
+	float distance = Vector::Length(sphere.center - cameraPosition);
+
+	if (distance <= sphere.radius) {
+		return screenHeight;
+	}
+
+	// 直径 * (1単位あたりのpixel数)
+	return 2.0f * sphere.radius * projectionScale * screenHeight * 0.5f / distance;
+}
+
+uint32_t TextureStreaming::ComputeMipLevel(const MipRange& range, float screenSize, float bias) {
+	uint32_t size = (std::max)(range.width, range.height);
+
+	if (screenSize <= 1.0f) {
+		return range.levelCount - 1;
+	}
+
+	float level = std::floor(std::log2(static_cast<float>(size) / screenSize) + bias);
+
+	if (level <= 0.0f) {
+		return 0;
+	}
+
+	return (std::min)(static_cast<uint32_t>(level), range.levelCount - 1);
+}
+
+uint32_t TextureStreaming::GetTopLevel(const MipRange& range, uint32_t minLevel, uint32_t maxSize) {
+	uint32_t result = (std::min)(minLevel, range.levelCount - 1);
+
+	if (maxSize != 0) {
+		while (result + 1 < range.levelCount && (GetLevelWidth(range, result) > maxSize || GetLevelHeight(range, result) > maxSize)) {
+			++result;
+		}
+	}
+
+	if (range.isBlockCompressed) { //!< BCのresourceは先頭levelが4の倍数でなければならない
+		while (result != 0 && (GetLevelWidth(range, result) % 4 != 0 || GetLevelHeight(range, result) % 4 != 0)) {
+			--result;
+		}
+	}
+
+	return result;
+}
+
+uint32_t TextureStreaming::GetLevelWidth(const MipRange& range, uint32_t level) {
+	return (std::max)(range.width >> level, 1u);
+}
+
+uint32_t TextureStreaming::GetLevelHeight(const MipRange& range, uint32_t level) {
+	return (std::max)(range.height >> level, 1u);
+}
+
+std::vector<TextureStreaming::Candidate> TextureStreaming::SelectRequests(std::vector<Candidate>& candidates, uint32_t maxCount) {
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+		if (a.priority != b.priority) {
+			return a.priority > b.priority;
+		}
+
+		return a.id < b.id;
+	});
+
+	size_t count = (std::min)(candidates.size(), static_cast<size_t>(maxCount));
+
+	return std::vector<Candidate>(candidates.begin(), candidates.begin() + count);
+}
\ No newline at end of file
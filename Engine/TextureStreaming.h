@@ -0,0 +1,83 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+#include <vector>
+
+// lib
+#include <Collider.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// MipRange structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct MipRange { //!< 全mipの大きさと, 読み込んだ先頭のlevel
+	uint32_t width;      //!< level0の幅
+	uint32_t height;     //!< level0の高さ
+	uint32_t levelCount; //!< 全mip数
+	uint32_t topLevel;   //!< 読み込んだ先頭のlevel
+	bool     isBlockCompressed;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TextureStreaming namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace TextureStreaming { //!< mipのstreamingの判定. D3D12に依存しない
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Candidate structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Candidate {
+		uint32_t id;       //!< TextureId
+		uint32_t level;    //!< 読み込む先頭のlevel
+		float    priority; //!< 高いものから読み込む
+	};
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 境界球の画面上の直径 (pixel)
+	//!
+	//! @param[in] sphere          world空間の境界球
+	//! @param[in] cameraPosition  カメラの位置
+	//! @param[in] projectionScale 射影行列のm[1][1]
+	//! @param[in] screenHeight    画面の高さ (pixel)
+	//!
+	//! @return 直径を返却. カメラが境界球の内側にある場合は画面の高さ
+	float ComputeScreenSize(const Sphere& sphere, const Vector3f& cameraPosition, float projectionScale, float screenHeight);
+
+	//! @brief 画面上の大きさに必要なmipのlevel
+	//!
+	//! textureのuvが境界球の直径に一度だけ貼られているとみなし, 1pixelあたりのtexel数が1以下となるlevelを選ぶ
+	//!
+	//! @param[in] range      textureの大きさ
+	//! @param[in] screenSize ComputeScreenSizeの結果
+	//! @param[in] bias       正の値でより小さいmipを選ぶ
+	uint32_t ComputeMipLevel(const MipRange& range, float screenSize, float bias = 0.0f);
+
+	//! @brief resourceの先頭にできるlevel
+	//!
+	//! minLevel以上かつ幅, 高さがmaxSize以下の最初のlevelを選ぶ. block圧縮の場合は
+	//! 幅, 高さが4の倍数となるlevelまで大きい方へ戻す
+	//!
+	//! @param[in] range    textureの大きさ. topLevelは使わない
+	//! @param[in] minLevel 最小のlevel
+	//! @param[in] maxSize  先頭levelの幅, 高さの上限. 0の場合は制限しない
+	uint32_t GetTopLevel(const MipRange& range, uint32_t minLevel, uint32_t maxSize = 0);
+
+	//! @brief levelの幅, 高さ
+	uint32_t GetLevelWidth(const MipRange& range, uint32_t level);
+	uint32_t GetLevelHeight(const MipRange& range, uint32_t level);
+
+	//! @brief 読み込むtextureを優先度順に選ぶ
+	//!
+	//! @param[in,out] candidates 候補. 優先度の降順に並び替えられる
+	//! @param[in]     maxCount   選ぶ数
+	//!
+	//! @return 選んだ候補を返却
+	std::vector<Candidate> SelectRequests(std::vector<Candidate>& candidates, uint32_t maxCount);
+
+}
\ No newline at end of file
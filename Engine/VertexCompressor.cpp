@@ -0,0 +1,384 @@
+#include "VertexCompressor.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cassert>
+
+// simd
+#include <emmintrin.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kBlockSize = 4; //!< 一度に処理する頂点数
+
+	constexpr float kUnorm16Max = 65535.0f;
+	constexpr float kSnorm16Max = 32767.0f;
+
+	//=========================================================================================
+	// half
+	//=========================================================================================
+
+	//! @brief float4個をhalfに変換. 各32bit laneの下位16bitに格納 (round to nearest even)
+	__m128i FloatToHalf(__m128 value) {
+		const __m128i kSignMask       = _mm_set1_epi32(0x80000000);
+		const __m128i kHalfMax        = _mm_set1_epi32((127 + 16) << 23);               //!< これ以上はinf
+		const __m128i kNanBit         = _mm_set1_epi32(0x200);
+		const __m128i kInfinity       = _mm_set1_epi32(0x7C00);
+		const __m128i kMinNormal      = _mm_set1_epi32((127 - 14) << 23);               //!< これ未満は非正規化数
+		const __m128i kSubnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i kNormalBias     = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));     //!< 指数の補正と丸め
+
+		__m128 sign     = _mm_and_ps(value, _mm_castsi128_ps(kSignMask));
+		__m128 absolute = _mm_xor_ps(value, sign);
+
+		__m128i absoluteBits = _mm_castps_si128(absolute);
+
+		__m128i isNan       = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		__m128i isRegular   = _mm_cmpgt_epi32(kHalfMax, absoluteBits);
+		__m128i isSubnormal = _mm_cmpgt_epi32(kMinNormal, absoluteBits);
+
+		__m128i infOrNan = _mm_or_si128(_mm_and_si128(isNan, kNanBit), kInfinity);
+
+		// 非正規化数. 加算で仮数部を丸める
+		__m128i subnormal = _mm_sub_epi32(
+			_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(kSubnormalMagic))), kSubnormalMagic
+		);
+
+		// 正規化数. 仮数部の最下位bitが奇数なら切り上げ側に寄せる
+		__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+		__m128i normal      = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absoluteBits, kNormalBias), mantissaOdd), 13);
+
+		__m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		__m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNan));
+
+		return _mm_or_si128(result, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+	}
+
+	//! @brief 各32bit laneの下位16bitのhalfをfloatに変換
+	__m128 HalfToFloat(__m128i value) {
+		const __m128i kNoSignMask = _mm_set1_epi32(0x7FFF);
+		const __m128  kMagic      = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)); //!< 2^112. 指数のbiasを補正
+		const __m128i kMaxFinite  = _mm_set1_epi32(0x7BFF);
+		const __m128  kInfNanExp  = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+		__m128i exponentMantissa = _mm_and_si128(value, kNoSignMask);
+		__m128i sign             = _mm_slli_epi32(_mm_xor_si128(value, exponentMantissa), 16);
+
+		__m128 scaled   = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), kMagic);
+		__m128 infOrNan = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(exponentMantissa, kMaxFinite)), kInfNanExp);
+
+		return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infOrNan));
+	}
+
+	//! @brief 32bit lane二つ分を16bitに詰める. 下位16bitのみ有効
+	__m128i Pack16(__m128i low, __m128i high) {
+		// 符号拡張してから飽和packすれば値が変わらない
+		return _mm_packs_epi32(
+			_mm_srai_epi32(_mm_slli_epi32(low, 16), 16),
+			_mm_srai_epi32(_mm_slli_epi32(high, 16), 16)
+		);
+	}
+
+	//=========================================================================================
+	// octahedral
+	//=========================================================================================
+
+	//! @brief normal4個 (SoA) を八面体に展開した[-1, 1]の二次元に変換
+	void OctahedralEncode(__m128 x, __m128 y, __m128 z, __m128& resultX, __m128& resultY) {
+		const __m128 kSignMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+		const __m128 kOne      = _mm_set1_ps(1.0f);
+
+		__m128 absoluteSum = _mm_add_ps(
+			_mm_add_ps(_mm_andnot_ps(kSignMask, x), _mm_andnot_ps(kSignMask, y)), _mm_andnot_ps(kSignMask, z)
+		);
+
+		// 長さ0のnormalは(0, 0)
+		__m128 inverse = _mm_and_ps(_mm_cmpgt_ps(absoluteSum, _mm_setzero_ps()), _mm_div_ps(kOne, absoluteSum));
+
+		__m128 octX = _mm_mul_ps(x, inverse);
+		__m128 octY = _mm_mul_ps(y, inverse);
+
+		// 下半球は対角線で折り返す
+		__m128 isLower = _mm_cmplt_ps(z, _mm_setzero_ps());
+
+		__m128 foldX = _mm_mul_ps(_mm_sub_ps(kOne, _mm_andnot_ps(kSignMask, octY)), _mm_or_ps(_mm_and_ps(octX, kSignMask), kOne));
+		__m128 foldY = _mm_mul_ps(_mm_sub_ps(kOne, _mm_andnot_ps(kSignMask, octX)), _mm_or_ps(_mm_and_ps(octY, kSignMask), kOne));
+
+		resultX = _mm_or_ps(_mm_and_ps(isLower, foldX), _mm_andnot_ps(isLower, octX));
+		resultY = _mm_or_ps(_mm_and_ps(isLower, foldY), _mm_andnot_ps(isLower, octY));
+	}
+
+	//! @brief OctahedralEncodeの逆変換. 結果は正規化される
+	void OctahedralDecode(__m128 octX, __m128 octY, __m128& resultX, __m128& resultY, __m128& resultZ) {
+		const __m128 kSignMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+		const __m128 kOne      = _mm_set1_ps(1.0f);
+
+		__m128 z = _mm_sub_ps(_mm_sub_ps(kOne, _mm_andnot_ps(kSignMask, octX)), _mm_andnot_ps(kSignMask, octY));
+		__m128 t = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+
+		// x >= 0 なら -t, x < 0 なら +t
+		__m128 x = _mm_add_ps(octX, _mm_xor_ps(t, _mm_andnot_ps(_mm_cmplt_ps(octX, _mm_setzero_ps()), kSignMask)));
+		__m128 y = _mm_add_ps(octY, _mm_xor_ps(t, _mm_andnot_ps(_mm_cmplt_ps(octY, _mm_setzero_ps()), kSignMask)));
+
+		__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+		__m128 inverse = _mm_div_ps(kOne, length); //!< 八面体上の点は長さ0にならない
+
+		resultX = _mm_mul_ps(x, inverse);
+		resultY = _mm_mul_ps(y, inverse);
+		resultZ = _mm_mul_ps(z, inverse);
+	}
+
+	//! @brief [-1, 1]をsnorm16に変換
+	__m128i ToSnorm16(__m128 value) {
+		value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+		return _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(kSnorm16Max)));
+	}
+
+	//! @brief 各32bit laneの下位16bitのsnorm16を[-1, 1]に変換
+	__m128 FromSnorm16(__m128i value) {
+		__m128 result = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(value, 16), 16));
+		return _mm_max_ps(_mm_mul_ps(result, _mm_set1_ps(1.0f / kSnorm16Max)), _mm_set1_ps(-1.0f));
+	}
+
+	//=========================================================================================
+	// block
+	//=========================================================================================
+
+	//! @brief 頂点kBlockSize個のuvとnormalを変換
+	void EncodeAttributes(const VertexData* vertices, uint16_t (*texcoords)[2], int16_t (*normals)[2]) {
+		// uv. 2頂点分で一つのregister
+		__m128 texcoord01 = _mm_setr_ps(vertices[0].texcoord.x, vertices[0].texcoord.y, vertices[1].texcoord.x, vertices[1].texcoord.y);
+		__m128 texcoord23 = _mm_setr_ps(vertices[2].texcoord.x, vertices[2].texcoord.y, vertices[3].texcoord.x, vertices[3].texcoord.y);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(texcoords), Pack16(FloatToHalf(texcoord01), FloatToHalf(texcoord23)));
+
+		// normal. SoAに並べ替えて4頂点同時に処理
+		__m128 x = _mm_setr_ps(vertices[0].normal.x, vertices[1].normal.x, vertices[2].normal.x, vertices[3].normal.x);
+		__m128 y = _mm_setr_ps(vertices[0].normal.y, vertices[1].normal.y, vertices[2].normal.y, vertices[3].normal.y);
+		__m128 z = _mm_setr_ps(vertices[0].normal.z, vertices[1].normal.z, vertices[2].normal.z, vertices[3].normal.z);
+
+		__m128 octX, octY;
+		OctahedralEncode(x, y, z, octX, octY);
+
+		// (x0, x1, x2, x3), (y0, y1, y2, y3) -> (x0, y0, x1, y1, ...)
+		__m128i snormX = ToSnorm16(octX);
+		__m128i snormY = ToSnorm16(octY);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(normals), Pack16(_mm_unpacklo_epi32(snormX, snormY), _mm_unpackhi_epi32(snormX, snormY)));
+	}
+
+	//! @brief EncodeAttributesの逆変換
+	void DecodeAttributes(const uint16_t (*texcoords)[2], const int16_t (*normals)[2], VertexData* vertices) {
+		alignas(16) float values[4][4];
+
+		// uv
+		__m128i halfs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texcoords));
+
+		_mm_store_ps(values[0], HalfToFloat(_mm_unpacklo_epi16(halfs, _mm_setzero_si128())));
+		_mm_store_ps(values[1], HalfToFloat(_mm_unpackhi_epi16(halfs, _mm_setzero_si128())));
+
+		for (uint32_t i = 0; i < kBlockSize; ++i) {
+			vertices[i].texcoord = { values[i / 2][(i % 2) * 2 + 0], values[i / 2][(i % 2) * 2 + 1] };
+		}
+
+		// normal. (x0, y0, x1, y1, ...) -> SoA
+		__m128i snorms = _mm_loadu_si128(reinterpret_cast<const __m128i*>(normals));
+		__m128  xy01   = FromSnorm16(_mm_unpacklo_epi16(snorms, snorms));
+		__m128  xy23   = FromSnorm16(_mm_unpackhi_epi16(snorms, snorms));
+
+		__m128 octX = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 octY = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 1, 3, 1));
+
+		__m128 x, y, z;
+		OctahedralDecode(octX, octY, x, y, z);
+
+		_mm_store_ps(values[0], x);
+		_mm_store_ps(values[1], y);
+		_mm_store_ps(values[2], z);
+
+		for (uint32_t i = 0; i < kBlockSize; ++i) {
+			vertices[i].normal = { values[0][i], values[1][i], values[2][i] };
+		}
+	}
+
+	//! @brief kBlockSize個ずつ処理. 端数は0埋めした一時領域で処理する
+	template <typename Src, typename Dst, typename F>
+	void ForEachBlock(const Src* src, uint32_t count, Dst* dst, F&& function) {
+		uint32_t blockCount = count / kBlockSize;
+
+		for (uint32_t block = 0; block < blockCount; ++block) {
+			function(src + block * kBlockSize, dst + block * kBlockSize);
+		}
+
+		uint32_t remain = count - blockCount * kBlockSize;
+
+		if (remain == 0) {
+			return;
+		}
+
+		Src srcBlock[kBlockSize] = {};
+		Dst dstBlock[kBlockSize] = {};
+
+		std::memcpy(srcBlock, src + blockCount * kBlockSize, sizeof(Src) * remain);
+		function(srcBlock, dstBlock);
+		std::memcpy(dst + blockCount * kBlockSize, dstBlock, sizeof(Dst) * remain);
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// VertexCompressor methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+VertexQuantization VertexCompressor::ComputeQuantization(const VertexData* vertices, uint32_t count) {
+	VertexQuantization result = {};
+	result.scale = { 1.0f, 1.0f, 1.0f };
+
+	if (count == 0) {
+		return result;
+	}
+
+	__m128 min = _mm_loadu_ps(&vertices[0].position.x);
+	__m128 max = min;
+
+	for (uint32_t i = 1; i < count; ++i) {
+		__m128 position = _mm_loadu_ps(&vertices[i].position.x);
+
+		min = _mm_min_ps(min, position);
+		max = _mm_max_ps(max, position);
+	}
+
+	alignas(16) float minValues[4];
+	alignas(16) float extents[4];
+	_mm_store_ps(minValues, min);
+	_mm_store_ps(extents, _mm_sub_ps(max, min));
+
+	result.offset = { minValues[0], minValues[1], minValues[2] };
+	result.scale  = { extents[0], extents[1], extents[2] }; //!< 幅0の軸は常にoffset
+
+	return result;
+}
+
+void VertexCompressor::Encode(const VertexData* vertices, uint32_t count, VertexDataPacked* result) {
+	ForEachBlock(vertices, count, result, [](const VertexData* src, VertexDataPacked* dst) {
+		uint16_t texcoords[kBlockSize][2];
+		int16_t  normals[kBlockSize][2];
+
+		EncodeAttributes(src, texcoords, normals);
+
+		for (uint32_t i = 0; i < kBlockSize; ++i) {
+			dst[i].position = { src[i].position.x, src[i].position.y, src[i].position.z };
+			std::memcpy(dst[i].texcoord, texcoords[i], sizeof(dst[i].texcoord));
+			std::memcpy(dst[i].normal, normals[i], sizeof(dst[i].normal));
+		}
+	});
+}
+
+void VertexCompressor::Encode(const VertexData* vertices, uint32_t count, const VertexQuantization& quantization, VertexDataQuantized* result) {
+	const __m128  offset = _mm_setr_ps(quantization.offset.x, quantization.offset.y, quantization.offset.z, 0.0f);
+	const __m128  factor = _mm_setr_ps(
+		quantization.scale.x > 0.0f ? kUnorm16Max / quantization.scale.x : 0.0f,
+		quantization.scale.y > 0.0f ? kUnorm16Max / quantization.scale.y : 0.0f,
+		quantization.scale.z > 0.0f ? kUnorm16Max / quantization.scale.z : 0.0f,
+		0.0f
+	);
+	const __m128  w    = _mm_setr_ps(0.0f, 0.0f, 0.0f, kUnorm16Max); //!< wは常に1
+	const __m128i bias = _mm_set1_epi32(0x8000);
+
+	ForEachBlock(vertices, count, result, [&](const VertexData* src, VertexDataQuantized* dst) {
+		uint16_t texcoords[kBlockSize][2];
+		int16_t  normals[kBlockSize][2];
+
+		EncodeAttributes(src, texcoords, normals);
+
+		for (uint32_t i = 0; i < kBlockSize; ++i) {
+			__m128 value = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&src[i].position.x), offset), factor);
+			value = _mm_min_ps(_mm_max_ps(_mm_add_ps(value, w), _mm_setzero_ps()), _mm_set1_ps(kUnorm16Max));
+
+			// unsignedの飽和packがないので, 符号付きの範囲にずらしてpackする
+			__m128i unorm = _mm_sub_epi32(_mm_cvtps_epi32(value), bias);
+			unorm = _mm_xor_si128(_mm_packs_epi32(unorm, unorm), _mm_set1_epi16(static_cast<short>(0x8000)));
+
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst[i].position), unorm);
+			std::memcpy(dst[i].texcoord, texcoords[i], sizeof(dst[i].texcoord));
+			std::memcpy(dst[i].normal, normals[i], sizeof(dst[i].normal));
+		}
+	});
+}
+
+void VertexCompressor::Decode(const VertexDataPacked* vertices, uint32_t count, VertexData* result) {
+	ForEachBlock(vertices, count, result, [](const VertexDataPacked* src, VertexData* dst) {
+		uint16_t texcoords[kBlockSize][2];
+		int16_t  normals[kBlockSize][2];
+
+		for (uint32_t i = 0; i < kBlockSize; ++i) {
+			dst[i].position = { src[i].position.x, src[i].position.y, src[i].position.z, 1.0f };
+			std::memcpy(texcoords[i], src[i].texcoord, sizeof(texcoords[i]));
+			std::memcpy(normals[i], src[i].normal, sizeof(normals[i]));
+		}
+
+		DecodeAttributes(texcoords, normals, dst);
+	});
+}
+
+void VertexCompressor::Decode(const VertexDataQuantized* vertices, uint32_t count, const VertexQuantization& quantization, VertexData* result) {
+	const __m128 offset = _mm_setr_ps(quantization.offset.x, quantization.offset.y, quantization.offset.z, 0.0f);
+	const __m128 factor = _mm_setr_ps(
+		quantization.scale.x / kUnorm16Max, quantization.scale.y / kUnorm16Max, quantization.scale.z / kUnorm16Max, 1.0f / kUnorm16Max
+	);
+
+	ForEachBlock(vertices, count, result, [&](const VertexDataQuantized* src, VertexData* dst) {
+		uint16_t texcoords[kBlockSize][2];
+		int16_t  normals[kBlockSize][2];
+
+		for (uint32_t i = 0; i < kBlockSize; ++i) {
+			__m128i unorm = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src[i].position)), _mm_setzero_si128());
+			__m128  value = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(unorm), factor), offset);
+
+			_mm_storeu_ps(&dst[i].position.x, value);
+			std::memcpy(texcoords[i], src[i].texcoord, sizeof(texcoords[i]));
+			std::memcpy(normals[i], src[i].normal, sizeof(normals[i]));
+		}
+
+		DecodeAttributes(texcoords, normals, dst);
+	});
+}
+
+void VertexCompressor::Measure(const VertexData* vertices, const VertexData* decoded, uint32_t count, float& maxPositionError, float& maxTexcoordError, float& maxNormalAngle) {
+	maxPositionError = 0.0f;
+	maxTexcoordError = 0.0f;
+	maxNormalAngle   = 0.0f;
+
+	for (uint32_t i = 0; i < count; ++i) {
+		Vector3f position = {
+			vertices[i].position.x - decoded[i].position.x,
+			vertices[i].position.y - decoded[i].position.y,
+			vertices[i].position.z - decoded[i].position.z,
+		};
+
+		maxPositionError = (std::max)(maxPositionError, Vector::Length(position));
+
+		maxTexcoordError = (std::max)({
+			maxTexcoordError,
+			std::abs(vertices[i].texcoord.x - decoded[i].texcoord.x),
+			std::abs(vertices[i].texcoord.y - decoded[i].texcoord.y),
+		});
+
+		float length = Vector::Length(vertices[i].normal);
+
+		if (length == 0.0f) {
+			continue;
+		}
+
+		float dot = std::clamp(Vector::Dot(vertices[i].normal, decoded[i].normal) / length, -1.0f, 1.0f);
+		maxNormalAngle = (std::max)(maxNormalAngle, std::acos(dot));
+	}
+}
\ No newline at end of file
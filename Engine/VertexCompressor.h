@@ -0,0 +1,61 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <vector>
+#include <cstdint>
+
+// structure
+#include <ObjectStructure.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// VertexCompressor namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace VertexCompressor {
+
+	//-----------------------------------------------------------------------------------------
+	// methods
+	//-----------------------------------------------------------------------------------------
+
+	//! @brief 頂点の位置のAABBから量子化の範囲を計算
+	//!
+	//! @param[in] vertices 頂点
+	//! @param[in] count    頂点数
+	//!
+	//! @return 量子化の範囲を返却. 頂点がない場合はscale 1, offset 0
+	VertexQuantization ComputeQuantization(const VertexData* vertices, uint32_t count);
+
+	//! @brief float3位置, half uv, octahedral normalに変換 (SSE2)
+	//!
+	//! @param[in]  vertices 頂点
+	//! @param[in]  count    頂点数
+	//! @param[out] result   変換後の頂点. count分の領域が必要
+	void Encode(const VertexData* vertices, uint32_t count, VertexDataPacked* result);
+
+	//! @brief unorm16位置, half uv, octahedral normalに変換 (SSE2)
+	//!
+	//! @param[in]  vertices     頂点
+	//! @param[in]  count        頂点数
+	//! @param[in]  quantization ComputeQuantizationで計算した範囲
+	//! @param[out] result       変換後の頂点. count分の領域が必要
+	void Encode(const VertexData* vertices, uint32_t count, const VertexQuantization& quantization, VertexDataQuantized* result);
+
+	//! @brief VertexDataPackedから復元 (SSE2). normalは正規化される
+	void Decode(const VertexDataPacked* vertices, uint32_t count, VertexData* result);
+
+	//! @brief VertexDataQuantizedから復元 (SSE2). normalは正規化される
+	void Decode(const VertexDataQuantized* vertices, uint32_t count, const VertexQuantization& quantization, VertexData* result);
+
+	//! @brief 変換前後の最大誤差を計測
+	//!
+	//! @param[in]  vertices         変換前の頂点
+	//! @param[in]  decoded          復元した頂点
+	//! @param[in]  count            頂点数
+	//! @param[out] maxPositionError 位置の最大誤差 (距離)
+	//! @param[out] maxTexcoordError uvの最大誤差
+	//! @param[out] maxNormalAngle   normalの最大誤差 (radian)
+	void Measure(const VertexData* vertices, const VertexData* decoded, uint32_t count, float& maxPositionError, float& maxTexcoordError, float& maxNormalAngle);
+
+}
\ No newline at end of file
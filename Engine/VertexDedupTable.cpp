@@ -0,0 +1,102 @@
+#include "VertexDedupTable.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr size_t kMinCapacity = 64;
+
+	//! 負荷率の上限 (size / capacity). 超えた場合に拡張
+	constexpr size_t kMaxLoadNumerator   = 7;
+	constexpr size_t kMaxLoadDenominator = 10;
+
+	size_t NextPowerOfTwo(size_t value) {
+		size_t result = kMinCapacity;
+		while (result < value) {
+			result <<= 1;
+		}
+
+		return result;
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// VertexDedupTable class methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void VertexDedupTable::Reserve(size_t count) {
+	size_t capacity = NextPowerOfTwo(count * kMaxLoadDenominator / kMaxLoadNumerator + 1);
+
+	if (capacity > slots_.size()) {
+		Rehash(capacity);
+	}
+}
+
+size_t VertexDedupTable::GetReserveMemorySize(size_t count) {
+	return NextPowerOfTwo(count * kMaxLoadDenominator / kMaxLoadNumerator + 1) * sizeof(Slot);
+}
+
+void VertexDedupTable::Clear() {
+	size_ = 0;
+	generation_++;
+
+	if (generation_ == 0) { //!< 一周したのでslotを初期化
+		for (auto& slot : slots_) {
+			slot.generation = 0;
+		}
+
+		generation_ = 1;
+	}
+}
+
+uint32_t VertexDedupTable::FindOrInsert(const FaceKey& key, uint32_t value, bool& isInserted) {
+	if ((size_ + 1) * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator) {
+		Rehash(NextPowerOfTwo(slots_.size() * 2));
+	}
+
+	for (size_t index = Hash(key) & mask_;; index = (index + 1) & mask_) {
+		Slot& slot = slots_[index];
+
+		if (slot.generation != generation_) { //!< 空slot
+			slot.key        = key;
+			slot.value      = value;
+			slot.generation = generation_;
+
+			size_++;
+			isInserted = true;
+			return value;
+		}
+
+		if (slot.key == key) {
+			isInserted = false;
+			return slot.value;
+		}
+	}
+}
+
+void VertexDedupTable::Rehash(size_t capacity) {
+	std::vector<Slot> oldSlots(capacity, Slot{ {}, 0, 0 });
+	oldSlots.swap(slots_);
+
+	uint32_t oldGeneration = generation_;
+
+	mask_       = capacity - 1;
+	size_       = 0;
+	generation_ = 1;
+
+	for (const auto& slot : oldSlots) {
+		if (slot.generation != oldGeneration) {
+			continue;
+		}
+
+		for (size_t index = Hash(slot.key) & mask_;; index = (index + 1) & mask_) {
+			if (slots_[index].generation != generation_) {
+				slots_[index] = { slot.key, slot.value, generation_ };
+				size_++;
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
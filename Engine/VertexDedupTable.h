@@ -0,0 +1,95 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// FaceKey structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct FaceKey { //!< obj face "v/vt/vn" の番号. 省略された番号は0
+	uint32_t v;
+	uint32_t vt;
+	uint32_t vn;
+
+	bool operator==(const FaceKey& other) const {
+		return v == other.v && vt == other.vt && vn == other.vn;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// VertexDedupTable class
+////////////////////////////////////////////////////////////////////////////////////////////
+class VertexDedupTable { //!< FaceKey -> 頂点番号 のopen addressing hash table
+public:
+
+	//=========================================================================================
+	// public methods
+	//=========================================================================================
+
+	//! @brief 要素数に対してテーブルを確保. 確保済みの要素は保持される
+	//!
+	//! @param[in] count 想定する要素数
+	void Reserve(size_t count);
+
+	//! @brief 全要素の削除. テーブルの解放はしない
+	void Clear();
+
+	//! @brief keyを探し, なければvalueで登録
+	//!
+	//! @param[in]  key        検索するkey
+	//! @param[in]  value      登録する値
+	//! @param[out] isInserted 新しく登録したか
+	//!
+	//! @return keyに対応する値を返却
+	uint32_t FindOrInsert(const FaceKey& key, uint32_t value, bool& isInserted);
+
+	//! @brief 登録されている要素数を取得
+	size_t GetSize() const { return size_; }
+
+	//! @brief 確保しているテーブルのbyteサイズを取得
+	size_t GetMemorySize() const { return slots_.capacity() * sizeof(Slot); }
+
+	//! @brief Reserve(count)で確保されるテーブルのbyteサイズを取得
+	static size_t GetReserveMemorySize(size_t count);
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// Slot structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct Slot {
+		FaceKey  key;
+		uint32_t value;
+		uint32_t generation; //!< generation_と異なる場合は空
+	};
+
+	//=========================================================================================
+	// private variables
+	//=========================================================================================
+
+	std::vector<Slot> slots_;
+
+	size_t   mask_       = 0;
+	size_t   size_       = 0;
+	uint32_t generation_ = 1; //!< Clear()で進め, 全slotを一括で空にする
+
+	//=========================================================================================
+	// private methods
+	//=========================================================================================
+
+	static size_t Hash(const FaceKey& key) {
+		uint64_t hash = key.v;
+		hash = hash * 0x9E3779B97F4A7C15ull ^ key.vt;
+		hash = hash * 0x9E3779B97F4A7C15ull ^ key.vn;
+		hash *= 0xBF58476D1CE4E5B9ull;
+		return static_cast<size_t>(hash ^ (hash >> 31));
+	}
+
+	void Rehash(size_t capacity);
+
+};
\ No newline at end of file
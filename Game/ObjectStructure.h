@@ -3,6 +3,9 @@
 //-----------------------------------------------------------------------------------------
 // include
 //-----------------------------------------------------------------------------------------
+// c++
+#include <cstdint>
+
 // Geometry
 #include <Vector2.h>
 #include <Vector3.h>
@@ -22,6 +25,25 @@ struct VertexData {
 	Vector3f normal;
 };
 
+struct VertexDataPacked { //!< VERTEX_FORMAT_PACKED (20byte)
+	Vector3f position;
+	uint16_t texcoord[2]; //!< half
+	int16_t  normal[2];   //!< octahedral (snorm16)
+};
+
+struct VertexDataQuantized { //!< VERTEX_FORMAT_QUANTIZED (16byte)
+	uint16_t position[4]; //!< unorm16. VertexQuantizationで復元. wは常に1
+	uint16_t texcoord[2]; //!< half
+	int16_t  normal[2];   //!< octahedral (snorm16)
+};
+
+struct VertexQuantization { //!< 量子化された位置の復元. position = value * scale + offset
+	Vector3f offset;
+	float    padding0;
+	Vector3f scale;
+	float    padding1;
+};
+
 struct TransformationMatrix {
 	Matrix4x4 wvp;
 	Matrix4x4 world;
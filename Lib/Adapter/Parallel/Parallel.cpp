@@ -0,0 +1,78 @@
+#include "Parallel.h"
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Parallel class methods
+////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t Parallel::GetThreadCount() {
+	return (std::max)(std::thread::hardware_concurrency(), 1u);
+}
+
+void Parallel::For(uint32_t count, const std::function<void(uint32_t index)>& function, uint32_t threadCount) {
+	if (count == 0) {
+		return;
+	}
+
+	if (threadCount == 0) {
+		threadCount = GetThreadCount();
+	}
+
+	threadCount = (std::min)(threadCount, count);
+
+	if (threadCount == 1) { //!< スレッドを立てる必要がない
+		for (uint32_t i = 0; i < count; ++i) {
+			function(i);
+		}
+
+		return;
+	}
+
+	std::atomic<uint32_t> nextIndex = 0;
+
+	// 最初の例外を呼び出し元に返す
+	std::exception_ptr exception;
+	std::mutex         exceptionMutex;
+
+	auto worker = [&]() {
+		for (uint32_t i = nextIndex++; i < count; i = nextIndex++) {
+			try {
+				function(i);
+
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(exceptionMutex);
+
+				if (exception == nullptr) {
+					exception = std::current_exception();
+				}
+			}
+		}
+	};
+
+	// 呼び出しスレッドも処理に参加
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+
+	for (uint32_t i = 0; i < threadCount - 1; ++i) {
+		threads.emplace_back(worker);
+	}
+
+	worker();
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	if (exception != nullptr) {
+		std::rethrow_exception(exception);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+#include <cstdint>
+#include <functional>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Parallel class
+////////////////////////////////////////////////////////////////////////////////////////////
+class Parallel {
+public:
+
+	//=========================================================================================
+	// public methods
+	//=========================================================================================
+
+	//! @brief 使用できるスレッド数を取得
+	//!
+	//! @return スレッド数を返却. 最低1
+	static uint32_t GetThreadCount();
+
+	//! @brief [0, count) のindexを複数スレッドで処理. 全て終わるまで戻らない
+	//!
+	//! @param[in] count       処理数
+	//! @param[in] function    index毎の処理
+	//! @param[in] threadCount 使用するスレッド数. 0の場合はGetThreadCount()
+	static void For(uint32_t count, const std::function<void(uint32_t index)>& function, uint32_t threadCount = 0);
+
+};
\ No newline at end of file
@@ -66,6 +66,8 @@ public:
 
 	const Matrix4x4 GetViewProjectionMatrix() const { return viewMatrix_ * projectionMatrix_; }
 
+	const Matrix4x4& GetProjectionMatrix() const { return projectionMatrix_; }
+
 	const D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() {
 		return resource_->GetGPUVirtualAddress();
 	}
@@ -1,5 +1,11 @@
 #include "Collider.h"
 
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cmath>
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Collider namespace
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -27,3 +33,112 @@ bool Collider::AABBToPoint(const AABB& aabb, const Vector3f& point) {
 
 	return false;
 }
+
+
+Frustum Collider::MakeFrustum(const Matrix4x4& viewProj) {
+	Frustum result;
+
+	// 行ベクトル形式なので, clip座標は各列との内積
+	auto column = [&](int c) {
+		return Plane{ { viewProj.m[0][c], viewProj.m[1][c], viewProj.m[2][c] }, viewProj.m[3][c] };
+	};
+
+	auto add = [](const Plane& a, const Plane& b, float sign) {
+		return Plane{ { a.normal.x + b.normal.x * sign, a.normal.y + b.normal.y * sign, a.normal.z + b.normal.z * sign }, a.distance + b.distance * sign };
+	};
+
+	Plane x = column(0);
+	Plane y = column(1);
+	Plane z = column(2);
+	Plane w = column(3);
+
+	result.planes[0] = add(w, x, 1.0f);  //!< left
+	result.planes[1] = add(w, x, -1.0f); //!< right
+	result.planes[2] = add(w, y, 1.0f);  //!< bottom
+	result.planes[3] = add(w, y, -1.0f); //!< top
+	result.planes[4] = z;                //!< near (0 <= z)
+	result.planes[5] = add(w, z, -1.0f); //!< far
+
+	// 距離で判定できるよう正規化
+	for (auto& plane : result.planes) {
+		float length = Vector::Length(plane.normal);
+
+		if (length != 0.0f) {
+			plane.normal   *= 1.0f / length;
+			plane.distance /= length;
+		}
+	}
+
+	return result;
+}
+
+bool Collider::SphereToFrustum(const Sphere& sphere, const Frustum& frustum) {
+
+	for (const auto& plane : frustum.planes) {
+		if (Vector::Dot(plane.normal, sphere.center) + plane.distance < -sphere.radius) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Collider::AABBToFrustum(const AABB& aabb, const Frustum& frustum) {
+
+	for (const auto& plane : frustum.planes) {
+		// 平面の法線方向に最も進んだ頂点
+		Vector3f positive = {
+			plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x,
+			plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y,
+			plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z,
+		};
+
+		if (Vector::Dot(plane.normal, positive) + plane.distance < 0.0f) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+AABB Collider::TransformAABB(const AABB& aabb, const Matrix4x4& matrix) {
+	AABB result;
+
+	// 平行移動から始め, 各要素の寄与のmin/maxを加える
+	result.min = { matrix.m[3][0], matrix.m[3][1], matrix.m[3][2] };
+	result.max = result.min;
+
+	const float min[3] = { aabb.min.x, aabb.min.y, aabb.min.z };
+	const float max[3] = { aabb.max.x, aabb.max.y, aabb.max.z };
+
+	float* resultMin[3] = { &result.min.x, &result.min.y, &result.min.z };
+	float* resultMax[3] = { &result.max.x, &result.max.y, &result.max.z };
+
+	for (int row = 0; row < 3; ++row) {
+		for (int column = 0; column < 3; ++column) {
+			float a = matrix.m[row][column] * min[row];
+			float b = matrix.m[row][column] * max[row];
+
+			*resultMin[column] += (a < b) ? a : b;
+			*resultMax[column] += (a < b) ? b : a;
+		}
+	}
+
+	return result;
+}
+
+Sphere Collider::TransformSphere(const Sphere& sphere, const Matrix4x4& matrix) {
+	Sphere result;
+	result.center = Matrix::Transform(sphere.center, matrix);
+
+	float scaleSq = 0.0f;
+
+	for (int row = 0; row < 3; ++row) {
+		float lengthSq = matrix.m[row][0] * matrix.m[row][0] + matrix.m[row][1] * matrix.m[row][1] + matrix.m[row][2] * matrix.m[row][2];
+		scaleSq = (lengthSq > scaleSq) ? lengthSq : scaleSq;
+	}
+
+	result.radius = sphere.radius * std::sqrt(scaleSq);
+
+	return result;
+}
\ No newline at end of file
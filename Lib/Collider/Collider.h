@@ -5,6 +5,7 @@
 //-----------------------------------------------------------------------------------------
 // Geometry
 #include <Vector3.h>
+#include <Matrix4x4.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // AABB structure
@@ -14,6 +15,29 @@ struct AABB {
 	Vector3f max;
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////
+// Sphere structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct Sphere {
+	Vector3f center;
+	float    radius;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Plane structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct Plane { //!< dot(normal, p) + distance >= 0 が表側
+	Vector3f normal;
+	float    distance;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Frustum structure
+////////////////////////////////////////////////////////////////////////////////////////////
+struct Frustum { //!< 内側が表になる6平面 (left, right, bottom, top, near, far)
+	Plane planes[6];
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Collider namespace
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -37,4 +61,45 @@ namespace Collider {
 	//! @retval false 衝突してない
 	bool AABBToPoint(const AABB& aabb, const Vector3f& point);
 
+	//! @brief viewProjection行列から視錐台を作成
+	//! 
+	//! @param[in] viewProj viewProjection行列. world行列を掛けた場合はlocal空間の視錐台になる
+	//! 
+	//! @return 視錐台を返却
+	Frustum MakeFrustum(const Matrix4x4& viewProj);
+
+	//! @brief Sphereと視錐台の判定
+	//! 
+	//! @param[in] sphere  Sphere
+	//! @param[in] frustum 視錐台
+	//! 
+	//! @retval true  一部でも視錐台の内側にある
+	//! @retval false 完全に外側
+	bool SphereToFrustum(const Sphere& sphere, const Frustum& frustum);
+
+	//! @brief AABBと視錐台の判定
+	//! 
+	//! @param[in] aabb    AABB
+	//! @param[in] frustum 視錐台
+	//! 
+	//! @retval true  一部でも視錐台の内側にある (保守的)
+	//! @retval false 完全に外側
+	bool AABBToFrustum(const AABB& aabb, const Frustum& frustum);
+
+	//! @brief 行列で変換したAABBを包むAABB
+	//! 
+	//! @param[in] aabb   local空間のAABB
+	//! @param[in] matrix world行列 (アフィン変換)
+	//! 
+	//! @return 変換後のAABBを返却
+	AABB TransformAABB(const AABB& aabb, const Matrix4x4& matrix);
+
+	//! @brief 行列で変換したSphereを包むSphere
+	//! 
+	//! @param[in] sphere local空間のSphere
+	//! @param[in] matrix world行列 (アフィン変換). 半径は最大の軸scaleで拡大
+	//! 
+	//! @return 変換後のSphereを返却
+	Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& matrix);
+
 }
\ No newline at end of file
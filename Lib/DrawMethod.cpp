@@ -1,12 +1,17 @@
 #include "DrawMethod.h"
 
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+#include <DirectXCommon.h>
+
 DrawData DrawMethods::Sphere(float radius, uint32_t kSubdivision) {
 	DrawData result;
 	float M_PI = std::numbers::pi_v<float>;
 
 	// vertexResourceの作成
 	uint32_t vertexSize = (kSubdivision + 1) * (kSubdivision + 1);
-	result.vertex = std::make_unique<DxObject::BufferResource<VertexData>>(MyEngine::GetDevicesObj(), vertexSize);
+	result.vertex = std::make_unique<DxObject::BufferResource<VertexData>>(MyEngine::GetDevicesObj(), vertexSize, BUFFER_USAGE_STATIC);
 
 	const float kLatEvery = M_PI / static_cast<float>(kSubdivision);
 	const float kLonEvery = (M_PI * 2.0f) / static_cast<float>(kSubdivision);
@@ -42,24 +47,28 @@ DrawData DrawMethods::Sphere(float radius, uint32_t kSubdivision) {
 	}
 
 	// indexResourceの作成
-	uint32_t indexSize = (kSubdivision) * (kSubdivision + 1) * 6;
-	result.index = std::make_unique<DxObject::IndexBufferResource>(MyEngine::GetDevicesObj(), indexSize);
+	uint32_t indexSize = (kSubdivision) * (kSubdivision) * 6;
+	result.index = std::make_unique<DxObject::IndexBufferResource>(MyEngine::GetDevicesObj(), indexSize, vertexSize, BUFFER_USAGE_STATIC); //!< 頂点数が少なければ16bit
 
-	for (uint32_t latIndex = 0; latIndex <= kSubdivision; ++latIndex) {
+	for (uint32_t latIndex = 0; latIndex < kSubdivision; ++latIndex) { //!< 最後の緯度は次の行がないので三角形を作らない
 		for (uint32_t lonIndex = 0; lonIndex < kSubdivision; ++lonIndex) {
 			// indexResourceに書き込み
 			uint32_t currentIndex = (latIndex * kSubdivision + lonIndex) * 6;
 			uint32_t startVertexIndex = (latIndex * (kSubdivision + 1) + lonIndex);
 
-			result.index->operator[](currentIndex) = startVertexIndex;                            // pointA
-			result.index->operator[](currentIndex + 1) = (startVertexIndex + (kSubdivision + 1)); // pointB
-			result.index->operator[](currentIndex + 2) = (startVertexIndex + 1);                  // pointC
+			result.index->Set(currentIndex, startVertexIndex);                            // pointA
+			result.index->Set(currentIndex + 1, (startVertexIndex + (kSubdivision + 1))); // pointB
+			result.index->Set(currentIndex + 2, (startVertexIndex + 1));                  // pointC
 
-			result.index->operator[](currentIndex + 3) = (startVertexIndex + (kSubdivision + 1));     // pointB
-			result.index->operator[](currentIndex + 4) = (startVertexIndex + (kSubdivision + 1) + 1); // pointD
-			result.index->operator[](currentIndex + 5) = (startVertexIndex + 1);                      // pointC
+			result.index->Set(currentIndex + 3, (startVertexIndex + (kSubdivision + 1)));     // pointB
+			result.index->Set(currentIndex + 4, (startVertexIndex + (kSubdivision + 1) + 1)); // pointD
+			result.index->Set(currentIndex + 5, (startVertexIndex + 1));                      // pointC
 		}
 	}
 
+	// 書き換えないのでDEFAULT heapへ転送
+	MyEngine::GetDxCommon()->UploadBuffer(result.vertex.get());
+	MyEngine::GetDxCommon()->UploadBuffer(result.index.get());
+
 	return result;
 }
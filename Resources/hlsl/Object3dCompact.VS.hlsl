@@ -0,0 +1,49 @@
+#include "Object3d.hlsli"
+
+struct TransformationMatrix {
+	float4x4 wvp;
+	float4x4 world;
+	float4x4 worldInverceTranspose;
+};
+ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
+
+struct VertexQuantization { //!< VERTEX_FORMAT_PACKEDではscale 1, offset 0
+	float3 offset;
+	float3 scale;
+};
+ConstantBuffer<VertexQuantization> gVertexQuantization : register(b1);
+
+struct VSInput {
+	float4 position : POSITION0; //!< float3 または unorm16
+	float2 texcoord : TEXCOORD0; //!< half
+	float2 normal   : NORMAL0;   //!< octahedral (snorm16)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// octahedral normalの復元
+////////////////////////////////////////////////////////////////////////////////////////////
+float3 DecodeOctahedral(float2 oct) {
+	float3 normal = float3(oct.x, oct.y, 1.0f - abs(oct.x) - abs(oct.y));
+	float  t      = saturate(-normal.z);
+	
+	normal.xy += t * (1.0f - 2.0f * step(0.0f, normal.xy)); //!< 0以上なら-t, 負なら+t
+	
+	return normalize(normal);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// メイン
+////////////////////////////////////////////////////////////////////////////////////////////
+VSOutput main(VSInput input) {
+	
+	VSOutput output;
+	
+	float4 position = float4(input.position.xyz * gVertexQuantization.scale + gVertexQuantization.offset, 1.0f);
+	
+	output.position = mul(position, gTransformationMatrix.wvp);
+	output.worldPos = mul(position, gTransformationMatrix.world);
+	output.texcoord = input.texcoord;
+	output.normal = normalize(mul(DecodeOctahedral(input.normal), (float3x3)gTransformationMatrix.worldInverceTranspose));
+	
+	return output;
+}
\ No newline at end of file
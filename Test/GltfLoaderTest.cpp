@@ -0,0 +1,153 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <filesystem>
+
+// engine
+#include <GltfLoader.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	//! @brief 三角形一つ分の位置 (float3 x 3 = 36byte) を参照するaccessor, bufferView
+	const std::string kBuffers =
+		R"("buffers": [ { "byteLength": 36 } ],)"
+		R"("bufferViews": [ { "buffer": 0, "byteLength": 36 } ],)";
+
+	const std::string kAccessor =
+		R"("accessors": [ { "bufferView": 0, "count": 3, "componentType": 5126, "type": "VEC3" } ],)";
+
+	const std::string kMesh =
+		R"("meshes": [ { "primitives": [ { "attributes": { "POSITION": 0 } } ] } ],)";
+
+	void WriteValue(std::ofstream& file, uint32_t value) {
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	//! @brief jsonと三角形一つのBIN chunkでglbを書き出す
+	void WriteGlb(const std::string& filePath, std::string json) {
+		json.resize((json.size() + 3) / 4 * 4, ' ');
+
+		float bin[9] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+
+		WriteValue(file, 0x46546C67); // "glTF"
+		WriteValue(file, 2);
+		WriteValue(file, static_cast<uint32_t>(12 + 8 + json.size() + 8 + sizeof(bin)));
+
+		WriteValue(file, static_cast<uint32_t>(json.size()));
+		WriteValue(file, 0x4E4F534A); // "JSON"
+		file.write(json.data(), json.size());
+
+		WriteValue(file, static_cast<uint32_t>(sizeof(bin)));
+		WriteValue(file, 0x004E4942); // "BIN\0"
+		file.write(reinterpret_cast<const char*>(bin), sizeof(bin));
+	}
+
+	//! @brief glbを書き出して読み込む
+	ModelRawData Parse(const std::string& directoryPath, const std::string& json) {
+		WriteGlb(directoryPath + "/test.glb", json);
+		return GltfLoader::ParseGlb(directoryPath, "test.glb");
+	}
+
+	//! @brief 不正なglbは例外, 無限ループにならずerrorを返す
+	void ExpectFailed(const std::string& directoryPath, const std::string& json, const std::string& name) {
+		ModelRawData rawData = Parse(directoryPath, json);
+		TestCheck::Expect(!rawData.error.empty(), name + " is accepted");
+		TestCheck::Expect(rawData.meshs.empty(), name + " returns meshs");
+	}
+
+	void TestValid(const std::string& directoryPath) {
+		ModelRawData rawData = Parse(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("nodes": [ { "mesh": 0, "children": [ 1 ] }, { "mesh": 0, "matrix": [ 1,0,0,0, 0,1,0,0, 0,0,1,0, 1,2,3,1 ] } ],)"
+			+ R"("scenes": [ { "nodes": [ 0 ] } ] })");
+
+		TestCheck::Expect(rawData.error.empty(), "valid glb failed: " + rawData.error);
+		TestCheck::Expect(rawData.meshs.size() == 2, "mesh count " + std::to_string(rawData.meshs.size()));
+
+		if (rawData.meshs.size() == 2) {
+			TestCheck::Expect(rawData.meshs[1].indices.size() == 3, "index count");
+			TestCheck::Expect(rawData.meshs[1].vertices[0].position.x == 1.0f && rawData.meshs[1].vertices[0].position.z == -3.0f, "child matrix is not applied");
+		}
+	}
+
+	void TestMissingProperty(const std::string& directoryPath) {
+		std::string scene = R"("nodes": [ { "mesh": 0 } ], "scenes": [ { "nodes": [ 0 ] } ] })";
+
+		ExpectFailed(directoryPath, "{" + kBuffers
+			+ R"("accessors": [ { "bufferView": 0, "componentType": 5126, "type": "VEC3" } ],)" + kMesh + scene, "accessor without count");
+		ExpectFailed(directoryPath, "{" + kBuffers
+			+ R"("accessors": [ { "bufferView": 0, "count": 3, "type": "VEC3" } ],)" + kMesh + scene, "accessor without componentType");
+		ExpectFailed(directoryPath, "{" + kBuffers
+			+ R"("accessors": [ { "bufferView": 0, "count": 3, "componentType": 5126 } ],)" + kMesh + scene, "accessor without type");
+
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor
+			+ R"("meshes": [ { "primitives": [ { "mode": 4 } ] } ],)" + scene, "primitive without attributes");
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor
+			+ R"("meshes": [ { } ],)" + scene, "mesh without primitives");
+	}
+
+	void TestOutOfRange(const std::string& directoryPath) {
+		std::string scene = R"("nodes": [ { "mesh": 0 } ], "scenes": [ { "nodes": [ 0 ] } ] })";
+
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("materials": [ { "pbrMetallicRoughness": { "baseColorTexture": { "index": 3 } } } ],)" + scene, "texture out of range");
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("textures": [ { "source": 2 } ], "materials": [ { "normalTexture": { "index": 0 } } ],)" + scene, "image out of range");
+	}
+
+	void TestInvalidType(const std::string& directoryPath) {
+		std::string scene = R"("scenes": [ { "nodes": [ 0 ] } ] })";
+
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("nodes": [ { "mesh": 0, "matrix": [ 1, 0, 0 ] } ],)" + scene, "matrix with 3 elements");
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("nodes": [ { "mesh": 0, "matrix": [ "1","0","0","0", "0","1","0","0", "0","0","1","0", "0","0","0","1" ] } ],)" + scene, "matrix of strings");
+		ExpectFailed(directoryPath, "{" + kBuffers
+			+ R"("accessors": [ { "bufferView": 0, "count": "3", "componentType": 5126, "type": "VEC3" } ],)" + kMesh
+			+ R"("nodes": [ { "mesh": 0 } ],)" + scene, "string count");
+	}
+
+	void TestCyclicNode(const std::string& directoryPath) {
+		std::string scene = R"("scenes": [ { "nodes": [ 0 ] } ] })";
+
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("nodes": [ { "mesh": 0, "children": [ 1 ] }, { "children": [ 0 ] } ],)" + scene, "cyclic children");
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("nodes": [ { "children": [ 0 ] } ],)" + scene, "self child");
+		ExpectFailed(directoryPath, "{" + kBuffers + kAccessor + kMesh
+			+ R"("nodes": [ { "children": [ 2 ] }, { "children": [ 2 ] }, { "mesh": 0 } ],)"
+			+ R"("scenes": [ { "nodes": [ 0, 1 ] } ] })", "node with two parents");
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "GltfLoaderTest";
+	std::filesystem::create_directories(directory);
+
+	TestValid(directory.string());
+	TestMissingProperty(directory.string());
+	TestOutOfRange(directory.string());
+	TestInvalidType(directory.string());
+	TestCyclicNode(directory.string());
+
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <filesystem>
+
+// engine
+#include <MeshCache.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint64_t kObjHash      = 0x1234;
+	constexpr uint32_t kThreadCount  = 8;
+	constexpr uint32_t kWriteCount   = 16;   //!< thread毎の書き込み回数
+	constexpr uint32_t kTriangleStep = 4096; //!< 書き込みが重なるよう, threadのmesh毎に大きさを変える
+
+	//! @brief triangleCount個の三角形を持つmeshを一つ作る
+	ModelRawData CreateRawData(uint32_t triangleCount) {
+		ModelRawData rawData;
+
+		MeshRawData& mesh = rawData.meshs.emplace_back();
+
+		for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+			mesh.vertices.push_back({ { static_cast<float>(i), 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } });
+			mesh.indices.push_back(i);
+		}
+
+		rawData.materials.resize(1);
+
+		return rawData;
+	}
+
+	//! @brief 一時ファイル名は呼び出し毎に異なる
+	void TestTempFilePath() {
+		std::string path = "model.obj.cmesh";
+		TestCheck::Expect(MeshCache::MakeTempFilePath(path) != MeshCache::MakeTempFilePath(path), "temp file path is reused");
+	}
+
+	//! @brief 同じcookedファイルを同時に書き込んでも, 最後に残るファイルはどれか一つの完全な内容
+	void TestConcurrentWrite(const std::string& directoryPath) {
+		std::string filePath = MeshCache::GetCookedFilePath(directoryPath, "model.obj");
+
+		std::vector<std::thread> threads;
+		std::atomic<uint32_t>    failedCount = 0;
+
+		for (uint32_t t = 0; t < kThreadCount; ++t) {
+			threads.emplace_back([&filePath, &failedCount, t]() {
+				ModelRawData rawData = CreateRawData((t + 1) * kTriangleStep);
+
+				for (uint32_t i = 0; i < kWriteCount; ++i) {
+					if (!MeshCache::Write(filePath, rawData, kObjHash, 0)) {
+						++failedCount;
+					}
+				}
+			});
+		}
+
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		TestCheck::Expect(failedCount == 0, std::to_string(failedCount.load()) + " concurrent writes failed");
+
+		MeshCache::CookedFile cookedFile;
+		TestCheck::Expect(cookedFile.Open(filePath), "open cooked file");
+		TestCheck::Expect(cookedFile.IsFresh(directoryPath, kObjHash), "cooked file is stale");
+
+		const std::vector<MeshCache::MeshView>& meshs = cookedFile.GetMeshs();
+		TestCheck::Expect(meshs.size() == 1, "mesh count");
+
+		if (meshs.size() == 1) {
+			uint32_t triangleCount = meshs[0].indexCount / 3;
+
+			TestCheck::Expect(triangleCount % kTriangleStep == 0 && triangleCount / kTriangleStep - 1 < kThreadCount, "triangle count " + std::to_string(triangleCount));
+			TestCheck::Expect(meshs[0].vertexCount == triangleCount * 3, "vertex count does not match the index count");
+
+			for (uint32_t i = 0; i < meshs[0].vertexCount; ++i) {
+				if (meshs[0].vertices[i].position.x != static_cast<float>(i) || meshs[0].indices[i] != i) {
+					TestCheck::Expect(false, "mixed contents at vertex " + std::to_string(i));
+					break;
+				}
+			}
+		}
+
+		// 一時ファイルが残らない
+		for (const auto& entry : std::filesystem::directory_iterator(directoryPath)) {
+			TestCheck::Expect(entry.path().extension() != ".tmp", "temp file left: " + entry.path().filename().string());
+		}
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "MeshCacheTest";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	TestTempFilePath();
+	TestConcurrentWrite(directory.string());
+
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+// engine
+#include <MeshOptimizer.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	using Triangle = std::array<uint32_t, 3>;
+
+	constexpr uint32_t kGridDivision = 120;
+	constexpr uint32_t kSeed         = 12345;
+
+	bool IsNear(float a, float b) {
+		return std::abs(a - b) < 1.0e-5f;
+	}
+
+	//! @brief (division + 1)^2 頂点の格子. 頂点の位置は(x, y)の整数
+	std::vector<VertexData> CreateGridVertices(uint32_t division) {
+		std::vector<VertexData> vertices;
+
+		for (uint32_t y = 0; y <= division; ++y) {
+			for (uint32_t x = 0; x <= division; ++x) {
+				vertices.push_back({ { static_cast<float>(x), static_cast<float>(y), 0.0f, 1.0f }, { 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } });
+			}
+		}
+
+		return vertices;
+	}
+
+	//! @brief step毎の頂点で格子の三角形を作り, 三角形の順番をshuffleする
+	std::vector<uint32_t> CreateShuffledGridIndices(uint32_t division, uint32_t step, std::mt19937& random) {
+		uint32_t stride = division + 1;
+
+		std::vector<Triangle> triangles;
+
+		for (uint32_t y = 0; y + step <= division; y += step) {
+			for (uint32_t x = 0; x + step <= division; x += step) {
+				uint32_t a = y * stride + x;
+				uint32_t b = a + step;
+				uint32_t c = a + step * stride;
+				uint32_t d = c + step;
+
+				triangles.push_back({ a, c, b });
+				triangles.push_back({ b, c, d });
+			}
+		}
+
+		std::shuffle(triangles.begin(), triangles.end(), random);
+
+		std::vector<uint32_t> indices;
+		for (const auto& triangle : triangles) {
+			indices.insert(indices.end(), triangle.begin(), triangle.end());
+		}
+
+		return indices;
+	}
+
+	//! @brief 三角形を頂点の位置で表し, 最小の頂点が先頭になるよう回転して並べる. 回転はwindingを変えない
+	std::vector<Triangle> GetTriangleSet(const std::vector<VertexData>& vertices, const uint32_t* indices, size_t indexCount) {
+		std::vector<Triangle> result;
+
+		for (size_t i = 0; i < indexCount; i += 3) {
+			Triangle triangle = {};
+
+			for (uint32_t k = 0; k < 3; ++k) {
+				const Vector4f& position = vertices[indices[i + k]].position;
+				triangle[k] = static_cast<uint32_t>(position.y) * 65536 + static_cast<uint32_t>(position.x);
+			}
+
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			result.push_back(triangle);
+		}
+
+		std::sort(result.begin(), result.end());
+
+		return result;
+	}
+
+	//! @brief 手計算したACMR, ATVR
+	void TestAnalyzeKnownAnswer() {
+		// 6頂点, 4三角形のstrip. 各頂点は一度だけ変換される
+		std::vector<uint32_t> strip = { 0, 1, 2, 2, 1, 3, 2, 3, 4, 4, 3, 5 };
+
+		MeshOptimizer::CacheStats stats = MeshOptimizer::AnalyzeVertexCache(strip, 6);
+		TestCheck::Expect(IsNear(stats.acmr, 1.5f), "strip acmr " + std::to_string(stats.acmr));
+		TestCheck::Expect(IsNear(stats.atvr, 1.0f), "strip atvr " + std::to_string(stats.atvr));
+
+		// entry数2のFIFOでは, 同じ三角形を二回描画しても全て再変換される
+		std::vector<uint32_t> repeat = { 0, 1, 2, 0, 1, 2 };
+
+		stats = MeshOptimizer::AnalyzeVertexCache(repeat, 3, 2);
+		TestCheck::Expect(IsNear(stats.acmr, 3.0f), "repeat acmr " + std::to_string(stats.acmr));
+		TestCheck::Expect(IsNear(stats.atvr, 2.0f), "repeat atvr " + std::to_string(stats.atvr));
+
+		stats = MeshOptimizer::AnalyzeVertexCache(repeat, 3, 3);
+		TestCheck::Expect(IsNear(stats.acmr, 1.5f), "repeat acmr with 3 entries " + std::to_string(stats.acmr));
+	}
+
+	//! @brief shuffleした格子はcache最適化でACMRが下がり, LOD毎の三角形とwindingは変わらない
+	void TestOptimizeGrid() {
+		std::mt19937 random(kSeed);
+
+		MeshRawData mesh;
+		mesh.vertices = CreateGridVertices(kGridDivision);
+		mesh.indices  = CreateShuffledGridIndices(kGridDivision, 1, random);
+
+		// LOD1は一つおきの頂点で作った粗い格子
+		std::vector<uint32_t> coarse = CreateShuffledGridIndices(kGridDivision, 2, random);
+
+		uint32_t lod0Count = static_cast<uint32_t>(mesh.indices.size());
+		uint32_t lod1Count = static_cast<uint32_t>(coarse.size());
+
+		mesh.indices.insert(mesh.indices.end(), coarse.begin(), coarse.end());
+		mesh.lods = { { 0, lod0Count, 0.0f }, { lod0Count, lod1Count, 1.0f } };
+
+		std::vector<std::vector<Triangle>> before;
+		for (const auto& lod : mesh.lods) {
+			before.push_back(GetTriangleSet(mesh.vertices, mesh.indices.data() + lod.indexOffset, lod.indexCount));
+		}
+
+		size_t vertexCount = mesh.vertices.size();
+
+		MeshOptimizer::OptimizeResult result = MeshOptimizer::Optimize(mesh);
+
+		TestCheck::Expect(result.before.acmr > 2.0f, "shuffled grid acmr before " + std::to_string(result.before.acmr));
+		TestCheck::Expect(result.after.acmr < 1.0f, "grid acmr after " + std::to_string(result.after.acmr));
+		TestCheck::Expect(result.after.acmr < result.before.acmr, "acmr did not improve");
+
+		TestCheck::Expect(mesh.vertices.size() == vertexCount, "vertex count changed");
+		TestCheck::Expect(mesh.indices.size() == lod0Count + lod1Count, "index count changed");
+		TestCheck::Expect(mesh.lods.size() == 2 && mesh.lods[1].indexOffset == lod0Count && mesh.lods[1].indexCount == lod1Count, "lod range changed");
+
+		for (size_t i = 0; i < mesh.lods.size(); ++i) {
+			const MeshLod& lod = mesh.lods[i];
+			TestCheck::Expect(GetTriangleSet(mesh.vertices, mesh.indices.data() + lod.indexOffset, lod.indexCount) == before[i], "triangles or winding changed in lod " + std::to_string(i));
+		}
+	}
+
+	//! @brief 頂点は最初に参照された順に並び, 参照されない頂点は削除される
+	void TestOptimizeVertexFetch() {
+		std::mt19937 random(kSeed);
+
+		std::vector<VertexData> vertices = CreateGridVertices(kGridDivision);
+		std::vector<uint32_t>   indices  = CreateShuffledGridIndices(kGridDivision, 2, random); //!< 奇数番目の行, 列は参照されない
+
+		std::vector<Triangle> before = GetTriangleSet(vertices, indices.data(), indices.size());
+
+		uint32_t referencedCount = (kGridDivision / 2 + 1) * (kGridDivision / 2 + 1);
+
+		MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+
+		TestCheck::Expect(vertices.size() == referencedCount, "vertex count " + std::to_string(vertices.size()));
+
+		uint32_t nextVertex = 0;
+
+		for (size_t i = 0; i < indices.size(); ++i) {
+			if (indices[i] == nextVertex) { //!< 初めて参照された頂点
+				++nextVertex;
+
+			} else if (indices[i] > nextVertex) {
+				TestCheck::Expect(false, "vertex " + std::to_string(indices[i]) + " is used before " + std::to_string(nextVertex));
+				break;
+			}
+		}
+
+		TestCheck::Expect(nextVertex == vertices.size(), "not all vertices are referenced");
+		TestCheck::Expect(GetTriangleSet(vertices, indices.data(), indices.size()) == before, "triangles or winding changed");
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	TestAnalyzeKnownAnswer();
+	TestOptimizeGrid();
+	TestOptimizeVertexFetch();
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cmath>
+#include <string>
+#include <vector>
+#include <numbers>
+#include <algorithm>
+
+// engine
+#include <MipGenerator.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr double   kKaiserWidth = 3.0; //!< MipGenerator.cppと同じ
+	constexpr double   kKaiserAlpha = 4.0;
+	constexpr uint32_t kMaxError    = 1;   //!< floatとdoubleの差で許容する8bitの差
+
+	//=========================================================================================
+	// scalar reference
+	//=========================================================================================
+
+	double SrgbToLinear(double value) {
+		return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+	}
+
+	double LinearToSrgb(double value) {
+		return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+	}
+
+	double Sinc(double x) {
+		if (std::abs(x) < 1e-9) {
+			return 1.0;
+		}
+
+		return std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+	}
+
+	double Kaiser(double x) {
+		if (std::abs(x) >= 1.0) {
+			return 0.0;
+		}
+
+		return std::cyl_bessel_i(0.0, kKaiserAlpha * std::sqrt(1.0 - x * x)) / std::cyl_bessel_i(0.0, kKaiserAlpha);
+	}
+
+	//! @brief 縮小後のindex dstに対する, 縮小前の各indexの重み (合計1)
+	std::vector<double> ComputeWeights(uint32_t srcSize, uint32_t dstSize, uint32_t dst, MipFilter filter) {
+		std::vector<double> result(srcSize, 0.0);
+
+		double scale = static_cast<double>(srcSize) / dstSize;
+
+		if (filter == MIP_FILTER_BOX || scale <= 1.0) {
+			// 縮小後のtexelが覆う範囲と, 縮小前の各texelが重なる長さ
+			for (uint32_t i = 0; i < srcSize; ++i) {
+				result[i] = (std::max)((std::min)((dst + 1) * scale, i + 1.0) - (std::max)(dst * scale, static_cast<double>(i)), 0.0);
+			}
+
+		} else {
+			double center = (dst + 0.5) * scale;
+			double radius = kKaiserWidth * scale;
+
+			for (int32_t i = static_cast<int32_t>(std::floor(center - radius)); i <= static_cast<int32_t>(std::ceil(center + radius)); ++i) {
+				double distance = ((i + 0.5) - center) / scale;
+				result[std::clamp(i, 0, static_cast<int32_t>(srcSize) - 1)] += Sinc(distance) * Kaiser(distance / kKaiserWidth);
+			}
+		}
+
+		double sum = 0.0;
+
+		for (double weight : result) {
+			sum += weight;
+		}
+
+		for (double& weight : result) {
+			weight /= sum;
+		}
+
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// ReferenceLevel structure
+	////////////////////////////////////////////////////////////////////////////////////////////
+	struct ReferenceLevel { //!< linearのdouble RGBA
+		std::vector<double> pixels;
+		uint32_t            width;
+		uint32_t            height;
+	};
+
+	//! @brief 一画素ずつ二次元の重みで縮小する. 量子化前の値を次のlevelに使う
+	std::vector<ReferenceLevel> GenerateReference(const MipImage& source, uint32_t levelCount, const MipOptions& options) {
+		std::vector<ReferenceLevel> result(1);
+		result[0] = { std::vector<double>(static_cast<size_t>(source.width) * source.height * 4), source.width, source.height };
+
+		for (uint32_t y = 0; y < source.height; ++y) {
+			for (uint32_t x = 0; x < source.width; ++x) {
+				for (uint32_t channel = 0; channel < 4; ++channel) {
+					double value = source.pixels[source.rowPitch * y + x * 4 + channel] / 255.0;
+					result[0].pixels[(static_cast<size_t>(y) * source.width + x) * 4 + channel] = (options.isSrgb && channel != 3) ? SrgbToLinear(value) : value;
+				}
+			}
+		}
+
+		for (uint32_t level = 1; level < levelCount; ++level) {
+			const ReferenceLevel& src = result[level - 1];
+
+			ReferenceLevel dst = { {}, (std::max)(src.width / 2, 1u), (std::max)(src.height / 2, 1u) };
+			dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+			for (uint32_t y = 0; y < dst.height; ++y) {
+				std::vector<double> weightY = ComputeWeights(src.height, dst.height, y, options.filter);
+
+				for (uint32_t x = 0; x < dst.width; ++x) {
+					std::vector<double> weightX = ComputeWeights(src.width, dst.width, x, options.filter);
+
+					for (uint32_t channel = 0; channel < 4; ++channel) {
+						double sum = 0.0;
+
+						for (uint32_t sy = 0; sy < src.height; ++sy) {
+							if (weightY[sy] == 0.0) {
+								continue;
+							}
+
+							for (uint32_t sx = 0; sx < src.width; ++sx) {
+								sum += weightY[sy] * weightX[sx] * src.pixels[(static_cast<size_t>(sy) * src.width + sx) * 4 + channel];
+							}
+						}
+
+						dst.pixels[(static_cast<size_t>(y) * dst.width + x) * 4 + channel] = std::clamp(sum, 0.0, 1.0);
+					}
+				}
+			}
+
+			result.push_back(std::move(dst));
+		}
+
+		return result;
+	}
+
+	uint8_t Quantize(double value, bool isSrgb) {
+		return static_cast<uint8_t>(std::floor((isSrgb ? LinearToSrgb(value) : value) * 255.0 + 0.5));
+	}
+
+	//=========================================================================================
+	// test
+	//=========================================================================================
+
+	//! @brief 勾配とノイズを混ぜた画像を書き込む
+	void FillImage(const MipImage& image, uint32_t seed) {
+		uint32_t state = seed * 2654435761u + 1;
+
+		for (uint32_t y = 0; y < image.height; ++y) {
+			for (uint32_t x = 0; x < image.width; ++x) {
+				uint8_t* pixel = image.pixels + image.rowPitch * y + x * 4;
+
+				state = state * 1664525u + 1013904223u;
+
+				pixel[0] = static_cast<uint8_t>(x * 255 / (std::max)(image.width - 1, 1u));
+				pixel[1] = static_cast<uint8_t>(y * 255 / (std::max)(image.height - 1, 1u));
+				pixel[2] = static_cast<uint8_t>(state >> 24);
+				pixel[3] = static_cast<uint8_t>((x ^ y) & 1 ? 255 : state >> 16);
+			}
+		}
+	}
+
+	std::string ToString(uint32_t width, uint32_t height, const MipOptions& options) {
+		return std::to_string(width) + "x" + std::to_string(height)
+			+ (options.filter == MIP_FILTER_BOX ? " box" : " kaiser")
+			+ (options.isSrgb ? " srgb" : " linear");
+	}
+
+	//! @brief 全levelがscalarの参照と一致し, スレッド数で結果が変わらない
+	void TestFilter(uint32_t width, uint32_t height, const MipOptions& options) {
+		std::string name = ToString(width, height, options);
+
+		MipChain chain = MipGenerator::CreateChain(width, height);
+		FillImage(chain.levels[0], width * 31 + height);
+
+		// 同じ画像をスレッド数を変えて生成. levelsはコピー先のpixelsを指し直す
+		MipChain threaded = chain;
+
+		for (size_t level = 0; level < threaded.levels.size(); ++level) {
+			threaded.levels[level].pixels = threaded.pixels.data() + (chain.levels[level].pixels - chain.pixels.data());
+		}
+
+		MipGenerator::Generate(chain, options, 1);
+		MipGenerator::Generate(threaded, options, 4);
+
+		TestCheck::Expect(chain.pixels == threaded.pixels, name + ": result depends on thread count");
+
+		std::vector<ReferenceLevel> reference = GenerateReference(chain.levels[0], static_cast<uint32_t>(chain.levels.size()), options);
+
+		for (size_t level = 1; level < chain.levels.size(); ++level) {
+			const MipImage&       image    = chain.levels[level];
+			const ReferenceLevel& expected = reference[level];
+
+			TestCheck::Expect(image.width == expected.width && image.height == expected.height, name + ": level size");
+
+			uint32_t maxError = 0;
+
+			for (uint32_t y = 0; y < image.height; ++y) {
+				for (uint32_t x = 0; x < image.width; ++x) {
+					for (uint32_t channel = 0; channel < 4; ++channel) {
+						int32_t actual = image.pixels[image.rowPitch * y + x * 4 + channel];
+						int32_t value  = Quantize(expected.pixels[(static_cast<size_t>(y) * image.width + x) * 4 + channel], options.isSrgb && channel != 3);
+
+						maxError = (std::max)(maxError, static_cast<uint32_t>(std::abs(actual - value)));
+					}
+				}
+			}
+
+			TestCheck::Expect(maxError <= kMaxError, name + ": level " + std::to_string(level) + " differs by " + std::to_string(maxError));
+		}
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	// 2の累乗, 奇数, 片方の軸だけ1になる大きさ. 27, 29は縮小範囲の端が誤差で元の大きさを超える
+	const uint32_t sizes[][2] = {
+		{ 64, 64 }, { 37, 23 }, { 27, 29 }, { 255, 3 }, { 1, 50 }, { 129, 130 },
+	};
+
+	for (uint32_t filter = 0; filter < kMipFilterCount; ++filter) {
+		for (bool isSrgb : { true, false }) {
+			MipOptions options = {};
+			options.filter = static_cast<MipFilter>(filter);
+			options.isSrgb = isSrgb;
+
+			for (const auto& size : sizes) {
+				TestFilter(size[0], size[1], options);
+			}
+		}
+	}
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+// engine
+#include <ObjStreamImporter.h>
+#include <ProcessMemory.h>
+#include <MeshCache.h>
+#include <ObjLoader.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint32_t kDivision    = 600;       //!< 格子の分割数. 約40MBのobjになる
+	constexpr size_t   kMemoryBudget = 4ull << 20; //!< ObjStreamImporter::kMinMemoryBudget
+
+	using Triangle = std::array<uint64_t, 3>; //!< 頂点(位置, uv, 法線)のhash
+
+	//! @brief 格子状のobjファイルを一行ずつ書き出す. 書き出し中もメモリはほぼ使わない
+	void WriteGridObj(const std::string& filePath, uint32_t division) {
+		std::ofstream file(filePath, std::ios::binary);
+		char line[160] = {};
+
+		for (uint32_t z = 0; z <= division; ++z) {
+			for (uint32_t x = 0; x <= division; ++x) {
+				float u = static_cast<float>(x) / division;
+				float v = static_cast<float>(z) / division;
+
+				int size = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn 0.000000 1.000000 0.000000\n", u, 0.0f, v, u, v);
+				file.write(line, size);
+			}
+		}
+
+		for (uint32_t z = 0; z < division; ++z) {
+			for (uint32_t x = 0; x < division; ++x) {
+				uint32_t a = z * (division + 1) + x + 1; //!< objは1始まり
+				uint32_t b = a + 1;
+				uint32_t c = a + (division + 1) + 1;
+				uint32_t d = a + (division + 1);
+
+				int size = std::snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c, d, d, d);
+				file.write(line, size);
+			}
+		}
+	}
+
+	//! @brief 頂点の内容のhash (FNV-1a). chunk毎に頂点番号が変わるので, 三角形は頂点の内容で比較する
+	uint64_t HashVertex(const VertexData& vertex) {
+		unsigned char bytes[sizeof(VertexData)];
+		std::memcpy(bytes, &vertex, sizeof(VertexData));
+
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (unsigned char byte : bytes) {
+			hash = (hash ^ byte) * 0x100000001B3ull;
+		}
+
+		return hash;
+	}
+
+	//! @brief 三角形を最小のhashが先頭になるよう回転して追加. 回転はwindingを変えない
+	void AppendTriangles(const VertexData* vertices, const uint32_t* indices, size_t indexCount, std::vector<Triangle>& result) {
+		for (size_t i = 0; i + 2 < indexCount; i += 3) {
+			Triangle triangle = { HashVertex(vertices[indices[i]]), HashVertex(vertices[indices[i + 1]]), HashVertex(vertices[indices[i + 2]]) };
+
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			result.push_back(triangle);
+		}
+	}
+
+	//! @brief cookedファイルを読み直し, ObjLoaderでparseした三角形と同じか確認
+	void CheckCookedFile(const std::string& directoryPath, const std::string& filename) {
+		MeshCache::CookedFile cookedFile;
+
+		TestCheck::Expect(cookedFile.Open(MeshCache::GetCookedFilePath(directoryPath, filename)), "open cooked file");
+		TestCheck::Expect(cookedFile.IsFresh(directoryPath, MeshCache::HashFile(directoryPath + "/" + filename)), "cooked file is stale");
+
+		std::vector<Triangle> cooked;
+		for (const auto& mesh : cookedFile.GetMeshs()) {
+			AppendTriangles(mesh.vertices, mesh.indices, mesh.indexCount, cooked); //!< importerはLODを作らない
+		}
+
+		ModelRawData rawData = ObjLoader::ParseMapped(directoryPath, filename);
+		TestCheck::Expect(rawData.error.empty(), "ParseMapped failed: " + rawData.error);
+
+		std::vector<Triangle> parsed;
+		for (const auto& mesh : rawData.meshs) {
+			AppendTriangles(mesh.vertices.data(), mesh.indices.data(), mesh.indices.size(), parsed);
+		}
+
+		std::sort(cooked.begin(), cooked.end());
+		std::sort(parsed.begin(), parsed.end());
+
+		TestCheck::Expect(cooked.size() == parsed.size(), "triangle count " + std::to_string(cooked.size()) + " != " + std::to_string(parsed.size()));
+		TestCheck::Expect(cooked == parsed, "cooked triangles differ from ObjLoader::ParseMapped");
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "ObjStreamImporterTest";
+	std::filesystem::create_directories(directory);
+
+	std::string directoryPath = directory.string();
+	std::string filename      = "grid.obj";
+
+	WriteGridObj(directoryPath + "/" + filename, kDivision);
+
+	size_t fileSize = static_cast<size_t>(std::filesystem::file_size(directory / filename));
+	TestCheck::Expect(fileSize > kMemoryBudget * 8, "obj file is too small: " + std::to_string(fileSize) + " bytes");
+
+	// importの間に増えたworking setを計測
+	bool   isReset    = ProcessMemory::ResetPeakWorkingSetSize();
+	size_t workingSet = ProcessMemory::GetWorkingSetSize();
+
+	ObjStreamImporter::ImportResult result = ObjStreamImporter::Import(directoryPath, filename, kMemoryBudget);
+
+	size_t peakWorkingSet = ProcessMemory::GetPeakWorkingSetSize();
+	size_t growth         = (peakWorkingSet > workingSet) ? peakWorkingSet - workingSet : 0;
+
+	std::printf(
+		"obj %.2fMB, budget %.2fMB, peakMemory %.2fMB, working set +%.2fMB (reset: %s)\n",
+		fileSize / (1024.0 * 1024.0), kMemoryBudget / (1024.0 * 1024.0),
+		result.peakMemory / (1024.0 * 1024.0), growth / (1024.0 * 1024.0), isReset ? "true" : "false"
+	);
+
+	TestCheck::Expect(result.isSuccess, "import failed");
+	TestCheck::Expect(result.indexCount == static_cast<uint64_t>(kDivision) * kDivision * 6, "index count " + std::to_string(result.indexCount));
+	TestCheck::Expect(result.vertexCount >= static_cast<uint64_t>(kDivision + 1) * (kDivision + 1), "vertex count " + std::to_string(result.vertexCount));
+	TestCheck::Expect(result.peakMemory <= kMemoryBudget, "peakMemory " + std::to_string(result.peakMemory) + " bytes exceeds budget");
+	TestCheck::Expect(workingSet != 0 && peakWorkingSet != 0, "working set is not available");
+	TestCheck::Expect(growth <= kMemoryBudget, "working set grew by " + std::to_string(growth) + " bytes, over budget");
+
+	CheckCookedFile(directoryPath, filename);
+
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
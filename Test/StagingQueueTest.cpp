@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+
+// DxObject
+#include <DxBasicStagingQueue.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// MockResource class
+	////////////////////////////////////////////////////////////////////////////////////////////
+	class MockResource { //!< ComPtrの代わり. 破棄された順番を記録する
+	public:
+
+		MockResource(uint32_t id, std::vector<uint32_t>* released) : id_(id), released_(released) {}
+
+		MockResource(MockResource&& other) noexcept : id_(other.id_), released_(other.released_) {
+			other.released_ = nullptr;
+		}
+
+		MockResource& operator=(MockResource&& other) noexcept {
+			Reset();
+			id_       = other.id_;
+			released_ = other.released_;
+			other.released_ = nullptr;
+			return *this;
+		}
+
+		~MockResource() { Reset(); }
+
+		MockResource(const MockResource&) = delete;
+		MockResource& operator=(const MockResource&) = delete;
+
+	private:
+
+		void Reset() {
+			if (released_ != nullptr) {
+				released_->push_back(id_);
+				released_ = nullptr;
+			}
+		}
+
+		uint32_t               id_;
+		std::vector<uint32_t>* released_; //!< moveされた後はnullptr
+	};
+
+	using StagingQueue = DxObject::BasicStagingQueue<MockResource>;
+
+	std::string ToString(const std::vector<uint32_t>& values) {
+		std::string result = "{";
+
+		for (uint32_t value : values) {
+			result += " " + std::to_string(value);
+		}
+
+		return result + " }";
+	}
+
+	//! @brief fenceを通過したものだけが古い順に解放される
+	void TestRelease() {
+		std::vector<uint32_t> released;
+		StagingQueue queue;
+
+		queue.Push(MockResource(0, &released), 1, 100);
+		queue.Push(MockResource(1, &released), 2, 200);
+		queue.Push(MockResource(2, &released), 2, 300);
+		queue.Push(MockResource(3, &released), 4, 400);
+
+		TestCheck::Expect(released.empty(), "released on push: " + ToString(released));
+		TestCheck::Expect(queue.GetPendingCount() == 4, "pending count after push");
+		TestCheck::Expect(queue.GetPendingByteSize() == 1000, "pending byte size after push");
+
+		TestCheck::Expect(queue.Release(0) == 0, "release before any fence");
+		TestCheck::Expect(released.empty(), "released before fence: " + ToString(released));
+
+		TestCheck::Expect(queue.Release(2) == 3, "release up to fence 2");
+		TestCheck::Expect(released == std::vector<uint32_t>{ 0, 1, 2 }, "release order: " + ToString(released));
+		TestCheck::Expect(queue.GetPendingCount() == 1, "pending count after release");
+		TestCheck::Expect(queue.GetPendingByteSize() == 400, "pending byte size after release");
+
+		TestCheck::Expect(queue.Release(3) == 0, "release between fences");
+		TestCheck::Expect(queue.Release(4) == 1, "release last fence");
+		TestCheck::Expect(released == std::vector<uint32_t>{ 0, 1, 2, 3 }, "release all: " + ToString(released));
+		TestCheck::Expect(queue.GetPendingByteSize() == 0, "pending byte size after release all");
+	}
+
+	//! @brief Clear, デストラクタで残りが全て解放される
+	void TestClear() {
+		std::vector<uint32_t> released;
+
+		{
+			StagingQueue queue;
+			queue.Push(MockResource(0, &released), 1, 16);
+			queue.Push(MockResource(1, &released), 2, 16);
+
+			queue.Clear();
+			TestCheck::Expect(released == std::vector<uint32_t>{ 0, 1 }, "clear: " + ToString(released));
+			TestCheck::Expect(queue.GetPendingCount() == 0 && queue.GetPendingByteSize() == 0, "empty after clear");
+
+			queue.Push(MockResource(2, &released), 3, 16);
+		}
+
+		TestCheck::Expect(released == std::vector<uint32_t>{ 0, 1, 2 }, "destructor: " + ToString(released));
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	TestRelease();
+	TestClear();
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
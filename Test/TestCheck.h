@@ -0,0 +1,34 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <cstdio>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// TestCheck namespace
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace TestCheck { //!< ctestから実行するテストの判定
+
+	inline uint32_t sFailedCount = 0;
+
+	//! @brief 条件を確認. 失敗した場合は内容を出力
+	//!
+	//! @param[in] isSuccess 条件
+	//! @param[in] message   失敗時に出力する内容
+	inline void Expect(bool isSuccess, const std::string& message) {
+		if (!isSuccess) {
+			std::fprintf(stderr, "[failed] %s\n", message.c_str());
+			sFailedCount++;
+		}
+	}
+
+	//! @brief mainの戻り値. 一つでも失敗していれば1
+	inline int GetExitCode() {
+		return sFailedCount == 0 ? 0 : 1;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+// engine
+#include <TextureCooker.h>
+#include <AtlasPacker.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	void WriteText(const std::string& filePath, const std::string& text) {
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file << text;
+	}
+
+	//! @brief 4x4の単色をBC1でcookする
+	bool Cook(const std::string& filePath) {
+		MipChain chain = MipGenerator::CreateChain(4, 4, 1);
+		std::fill(chain.pixels.begin(), chain.pixels.end(), static_cast<uint8_t>(128));
+
+		TextureCooker::CookOptions options = {};
+		options.compression = TEXTURE_COMPRESSION_BC1;
+
+		return TextureCooker::Write(TextureCooker::GetCookedFilePath(filePath), chain, options, TextureCooker::HashSource(filePath));
+	}
+
+	//! @brief atlasは配置ファイルが同じでも, 元画像の変更でcookし直す
+	void TestAtlasFresh(const std::string& directoryPath) {
+		// hashはファイルの中身のみを見るので, 画像として正しい必要はない
+		std::string imageA = directoryPath + "/a.png";
+		std::string imageB = directoryPath + "/b.png";
+		WriteText(imageA, "image a");
+		WriteText(imageB, "image b");
+
+		AtlasLayout layout = {};
+		layout.width     = 64;
+		layout.height    = 64;
+		layout.padding   = 4;
+		layout.rects     = { { 4, 4, 16, 16 }, { 28, 4, 16, 16 } };
+		layout.filePaths = { imageA, imageB };
+
+		std::string layoutPath = directoryPath + "/test" + AtlasPacker::kExtension;
+		TestCheck::Expect(AtlasPacker::WriteLayout(layoutPath, layout), "write layout");
+
+		TestCheck::Expect(!TextureCooker::IsFresh(layoutPath), "atlas is fresh before cook");
+		TestCheck::Expect(Cook(layoutPath), "cook atlas");
+		TestCheck::Expect(TextureCooker::IsFresh(layoutPath), "atlas is stale right after cook");
+
+		WriteText(imageB, "image b edited");
+		TestCheck::Expect(!TextureCooker::IsFresh(layoutPath), "atlas stays fresh after a source image changed");
+
+		TestCheck::Expect(Cook(layoutPath), "re-cook atlas");
+		TestCheck::Expect(TextureCooker::IsFresh(layoutPath), "atlas is stale after re-cook");
+
+		std::filesystem::remove(imageA);
+		TestCheck::Expect(!TextureCooker::IsFresh(layoutPath), "atlas stays fresh after a source image was removed");
+	}
+
+	//! @brief atlas以外は画像ファイルのみで判定
+	void TestImageFresh(const std::string& directoryPath) {
+		std::string image = directoryPath + "/c.png";
+		WriteText(image, "image c");
+
+		TestCheck::Expect(TextureCooker::HashSource(image) == MeshCache::HashFile(image), "image hash differs from HashFile");
+		TestCheck::Expect(Cook(image), "cook image");
+		TestCheck::Expect(TextureCooker::IsFresh(image), "image is stale right after cook");
+
+		WriteText(image, "image c edited");
+		TestCheck::Expect(!TextureCooker::IsFresh(image), "image stays fresh after it changed");
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "TextureCookerTest";
+	std::filesystem::create_directories(directory);
+
+	TestAtlasFresh(directory.string());
+	TestImageFresh(directory.string());
+
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// engine
+#include <TextureResidency.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint64_t kCurrentFrame = 100;
+	constexpr uint32_t kIdleFrame    = 2;
+	constexpr uint64_t kIdleUsed     = kCurrentFrame - kIdleFrame;     //!< 使用中ではない最新のframe
+	constexpr uint64_t kInUseUsed    = kCurrentFrame - kIdleFrame + 1; //!< 使用中となる最古のframe
+
+	//! @brief 全mip 100byte, 最小mip 10byteのentry
+	TextureResidency::Entry MakeEntry(uint32_t referenceNum, int32_t priority, uint64_t lastUsedFrame, bool isMinimal = false) {
+		return { 100, 10, lastUsedFrame, referenceNum, priority, isMinimal };
+	}
+
+	std::vector<TextureResidency::Action> Plan(const std::vector<TextureResidency::Entry>& entries, uint64_t budget) {
+		return TextureResidency::Plan(entries, budget, kCurrentFrame, kIdleFrame);
+	}
+
+	std::string ToString(const std::vector<TextureResidency::Action>& actions) {
+		static const char* kNames[kResidencyActionCount] = { "release", "minimize", "restore" };
+
+		std::string result = "{";
+
+		for (const auto& action : actions) {
+			result += " " + std::to_string(action.index) + ":" + kNames[action.action];
+		}
+
+		return result + " }";
+	}
+
+	bool Equals(const std::vector<TextureResidency::Action>& actions, const std::vector<TextureResidency::Action>& expected) {
+		return std::equal(actions.begin(), actions.end(), expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.index == rhs.index && lhs.action == rhs.action;
+		});
+	}
+
+	void Expect(const std::string& name, const std::vector<TextureResidency::Action>& actions, const std::vector<TextureResidency::Action>& expected) {
+		TestCheck::Expect(Equals(actions, expected), name + ": " + ToString(actions) + ", expected " + ToString(expected));
+	}
+
+	//! @brief 参照のないtextureは, priority, 使用frameに関わらず参照のあるものより先に解放
+	void TestUnreferencedFirst() {
+		std::vector<TextureResidency::Entry> entries = {
+			MakeEntry(1, -10, 0),         //!< priorityが低く古いが参照あり
+			MakeEntry(0, 10, kIdleUsed),
+		};
+
+		Expect("unreferenced first", Plan(entries, 150), { { 1, RESIDENCY_ACTION_RELEASE } });
+		Expect("then referenced", Plan(entries, 50), { { 1, RESIDENCY_ACTION_RELEASE }, { 0, RESIDENCY_ACTION_MINIMIZE } });
+	}
+
+	//! @brief priorityの低いものを, 最後に使われたframeより優先して縮小
+	void TestPriorityBeforeLru() {
+		std::vector<TextureResidency::Entry> entries = {
+			MakeEntry(1, 1, 10),
+			MakeEntry(1, 0, kIdleUsed), //!< 新しいがpriorityが低い
+			MakeEntry(1, 1, 5),         //!< priorityが同じなら古い方から
+		};
+
+		Expect("priority", Plan(entries, 210), { { 1, RESIDENCY_ACTION_MINIMIZE } });
+		Expect("lru", Plan(entries, 120), { { 1, RESIDENCY_ACTION_MINIMIZE }, { 2, RESIDENCY_ACTION_MINIMIZE } });
+	}
+
+	//! @brief idleFrameCount以内に使われたtextureは解放, 縮小しない
+	void TestInUseKept() {
+		std::vector<TextureResidency::Entry> entries = {
+			MakeEntry(0, 0, kInUseUsed),    //!< 参照なしでも使用中
+			MakeEntry(1, 0, kCurrentFrame),
+			MakeEntry(1, 5, kIdleUsed),
+		};
+
+		Expect("in use kept", Plan(entries, 0), { { 2, RESIDENCY_ACTION_MINIMIZE } });
+	}
+
+	//! @brief 最小mipで使用中のtextureは, 予算に収まる場合のみ戻す
+	void TestRestore() {
+		std::vector<TextureResidency::Entry> entries = {
+			MakeEntry(1, 0, kCurrentFrame, true),
+		};
+
+		Expect("restore over budget", Plan(entries, 99), {});
+		Expect("restore within budget", Plan(entries, 100), { { 0, RESIDENCY_ACTION_RESTORE } });
+
+		// 使われていないtextureを解放すれば収まる
+		entries.push_back(MakeEntry(0, 0, kIdleUsed));
+
+		Expect("restore after release", Plan(entries, 100), { { 1, RESIDENCY_ACTION_RELEASE }, { 0, RESIDENCY_ACTION_RESTORE } });
+
+		// 解放しても収まらない場合は戻さない
+		entries.push_back(MakeEntry(1, 0, kCurrentFrame));
+
+		Expect("restore does not fit", Plan(entries, 150), { { 1, RESIDENCY_ACTION_RELEASE } });
+	}
+
+	//! @brief 使用中のtextureだけで予算を超える場合は何もしない
+	void TestAllInUse() {
+		std::vector<TextureResidency::Entry> entries = {
+			MakeEntry(0, 0, kCurrentFrame),
+			MakeEntry(1, -5, kInUseUsed),
+			MakeEntry(1, 5, kCurrentFrame),
+		};
+
+		TestCheck::Expect(TextureResidency::GetResidentByteSize(entries) > 100, "entries are not over budget");
+		Expect("all in use", Plan(entries, 100), {});
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	TestUnreferencedFirst();
+	TestPriorityBeforeLru();
+	TestInUseKept();
+	TestRestore();
+	TestAllInUse();
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
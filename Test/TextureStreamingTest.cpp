@@ -0,0 +1,217 @@
+//-----------------------------------------------------------------------------------------
+// include
+//-----------------------------------------------------------------------------------------
+// c++
+#include <cmath>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <filesystem>
+
+// engine
+#include <TextureStreaming.h>
+#include <TextureCooker.h>
+
+// test
+#include "TestCheck.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// namespace -anonymouse-
+////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+	constexpr uint64_t kDdsHeaderSize = 4 + 124 + 20; //!< magic, DDS_HEADER, DDS_HEADER_DXT10
+
+	MipRange MakeRange(uint32_t width, uint32_t height, bool isBlockCompressed = false) {
+		return { width, height, MipGenerator::GetLevelCount(width, height), 0, isBlockCompressed };
+	}
+
+	std::string ToString(uint32_t width, uint32_t height) {
+		return std::to_string(width) + "x" + std::to_string(height);
+	}
+
+	//! @brief 必要なlevelは1pixelあたり1texel以下となる最初のlevel. 全mip数未満に収める
+	void TestMipLevel() {
+		MipRange range = MakeRange(1024, 1024); //!< 11 levels
+
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 1024.0f) == 0, "same size");
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 4096.0f) == 0, "larger than texture");
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 256.0f) == 2, "quarter size");
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 200.0f) == 2, "between levels");
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 256.0f, 1.0f) == 3, "bias");
+
+		// 全mip数 - 1で止める
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 1.5f) == 9, "1.5px");
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 1.5f, 8.0f) == 10, "bias clamped to levelCount - 1");
+
+		MipRange partial = range;
+		partial.levelCount = 4; //!< 1x1まで作られていない
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(partial, 16.0f) == 3, "clamped to partial chain");
+
+		// 1pixel以下は最小のmip
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 1.0f) == 10, "1px");
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(range, 0.0f) == 10, "0px");
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(partial, 0.5f) == 3, "subpixel on partial chain");
+	}
+
+	//! @brief 境界球の画面上の大きさ. カメラが内側なら画面の高さ
+	void TestScreenSize() {
+		Sphere sphere = { { 0.0f, 0.0f, 10.0f }, 1.0f };
+
+		float size = TextureStreaming::ComputeScreenSize(sphere, { 0.0f, 0.0f, 0.0f }, 1.0f, 1000.0f);
+		TestCheck::Expect(std::abs(size - 100.0f) < 1e-3f, "screen size " + std::to_string(size));
+
+		float inside = TextureStreaming::ComputeScreenSize(sphere, { 0.0f, 0.5f, 10.0f }, 1.0f, 1000.0f);
+		TestCheck::Expect(inside == 1000.0f, "camera inside sphere " + std::to_string(inside));
+		TestCheck::Expect(TextureStreaming::ComputeMipLevel(MakeRange(1024, 1024), inside) == 0, "inside sphere uses level 0");
+
+		float edge = TextureStreaming::ComputeScreenSize(sphere, { 0.0f, 0.0f, 9.0f }, 1.0f, 1000.0f);
+		TestCheck::Expect(edge == 1000.0f, "camera on sphere " + std::to_string(edge));
+	}
+
+	//! @brief block圧縮は先頭levelが4の倍数. maxSizeで大きいlevelを除く
+	void TestTopLevel() {
+		const uint32_t sizes[][2] = {
+			{ 1024, 1024 }, { 96, 40 }, { 256, 12 }, { 4, 4 }, { 1000, 600 },
+		};
+
+		for (const auto& size : sizes) {
+			MipRange range = MakeRange(size[0], size[1], true);
+
+			for (uint32_t minLevel = 0; minLevel < range.levelCount + 2; ++minLevel) {
+				uint32_t level  = TextureStreaming::GetTopLevel(range, minLevel);
+				uint32_t width  = TextureStreaming::GetLevelWidth(range, level);
+				uint32_t height = TextureStreaming::GetLevelHeight(range, level);
+
+				std::string name = ToString(size[0], size[1]) + " minLevel " + std::to_string(minLevel) + " -> " + std::to_string(level);
+
+				TestCheck::Expect(width % 4 == 0 && height % 4 == 0, name + ": " + ToString(width, height) + " is not a multiple of 4");
+				TestCheck::Expect(level <= minLevel, name + ": went past minLevel");
+			}
+		}
+
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(1024, 1024, true), 9) == 8, "bc 2x2 -> 4x4");
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(96, 40, true), 2) == 1, "bc 24x10 -> 48x20");
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(96, 40, false), 2) == 2, "uncompressed keeps 24x10");
+
+		// maxSize
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(1024, 1024), 0, 256) == 2, "maxSize 256");
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(1024, 1024), 3, 256) == 3, "minLevel above maxSize");
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(1024, 256), 0, 128) == 3, "maxSize uses the longer side");
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(300, 200), 0, 1000) == 0, "maxSize larger than texture");
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(1024, 1024), 0, 0) == 0, "maxSize 0 is unlimited");
+		TestCheck::Expect(TextureStreaming::GetTopLevel(MakeRange(1024, 1024), 20) == 10, "minLevel clamped");
+	}
+
+	//! @brief 優先度の降順, 同じ優先度はidの昇順
+	void TestSelectRequests() {
+		std::vector<TextureStreaming::Candidate> candidates = {
+			{ 5, 0, 1.0f }, { 3, 1, 2.0f }, { 9, 0, 1.0f }, { 1, 2, 1.0f }, { 7, 0, 3.0f },
+		};
+
+		std::vector<TextureStreaming::Candidate> selected = TextureStreaming::SelectRequests(candidates, 3);
+
+		const uint32_t kExpected[] = { 7, 3, 1, 5, 9 };
+
+		TestCheck::Expect(selected.size() == 3, "selected count " + std::to_string(selected.size()));
+
+		for (size_t i = 0; i < candidates.size(); ++i) {
+			TestCheck::Expect(candidates[i].id == kExpected[i], "order at " + std::to_string(i) + ": " + std::to_string(candidates[i].id));
+		}
+
+		for (size_t i = 0; i < selected.size(); ++i) {
+			TestCheck::Expect(selected[i].id == kExpected[i], "selected at " + std::to_string(i));
+		}
+
+		// 並び替え済みでも同じ結果
+		TestCheck::Expect(TextureStreaming::SelectRequests(candidates, 3).back().id == 1, "stable on sorted input");
+		TestCheck::Expect(TextureStreaming::SelectRequests(candidates, 10).size() == candidates.size(), "maxCount above size");
+		TestCheck::Expect(TextureStreaming::SelectRequests(candidates, 0).empty(), "maxCount 0");
+	}
+
+	//! @brief ReadLevelsがWriteで書き込んだDDSのtopLevel以降のblockを読み込む
+	void TestReadLevels(const std::string& directoryPath, TextureCompression compression) {
+		std::string filePath = directoryPath + "/levels.dds";
+
+		MipChain chain = MipGenerator::CreateChain(32, 16); //!< 32x16 ~ 1x1 の6 level
+		for (size_t i = 0; i < chain.pixels.size(); ++i) {
+			chain.pixels[i] = static_cast<uint8_t>(i * 37 + (i >> 7));
+		}
+		MipGenerator::Generate(chain, {});
+
+		TextureCooker::CookOptions options = {};
+		options.compression = compression;
+
+		std::string name = "compression " + std::to_string(compression);
+
+		TestCheck::Expect(TextureCooker::Write(filePath, chain, options, 1), name + ": write");
+
+		std::vector<uint8_t> file;
+		{
+			std::ifstream stream(filePath, std::ios::binary);
+			file.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		}
+
+		TextureCooker::CookedInfo info = {};
+		TestCheck::Expect(TextureCooker::ReadInfo(filePath, info), name + ": read info");
+		TestCheck::Expect(info.width == 32 && info.height == 16 && info.levelCount == 6, name + ": info");
+
+		// 各levelのblockは圧縮したものがheaderの後に順に並ぶ
+		uint64_t blockSize = BlockCompressor::GetBlockSize(compression);
+		uint64_t offset    = kDdsHeaderSize;
+
+		std::vector<uint64_t> offsets;
+
+		for (uint32_t level = 0; level < info.levelCount; ++level) {
+			std::vector<uint8_t> blocks = TextureCooker::Compress(chain.levels[level], compression);
+
+			uint64_t byteSize = TextureCooker::GetLevelByteSize(info, level);
+			uint64_t expected = ((chain.levels[level].width + 3) / 4) * ((chain.levels[level].height + 3) / 4) * blockSize;
+
+			TestCheck::Expect(byteSize == expected && blocks.size() == expected, name + ": level " + std::to_string(level) + " byte size");
+			TestCheck::Expect(offset + byteSize <= file.size() && std::equal(blocks.begin(), blocks.end(), file.begin() + offset), name + ": level " + std::to_string(level) + " layout");
+
+			offsets.push_back(offset);
+			offset += byteSize;
+		}
+
+		TestCheck::Expect(offset == file.size(), name + ": file size " + std::to_string(file.size()) + ", expected " + std::to_string(offset));
+
+		for (uint32_t topLevel = 0; topLevel < info.levelCount; ++topLevel) {
+			std::vector<uint8_t> blocks;
+
+			bool isRead = TextureCooker::ReadLevels(filePath, info, topLevel, blocks);
+
+			TestCheck::Expect(isRead && blocks.size() == file.size() - offsets[topLevel]
+				&& std::equal(blocks.begin(), blocks.end(), file.begin() + offsets[topLevel]),
+				name + ": ReadLevels(" + std::to_string(topLevel) + ")");
+		}
+
+		std::vector<uint8_t> blocks;
+		TestCheck::Expect(!TextureCooker::ReadLevels(filePath, info, info.levelCount, blocks), name + ": topLevel out of range");
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// main
+////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+	TestMipLevel();
+	TestScreenSize();
+	TestTopLevel();
+	TestSelectRequests();
+
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "TextureStreamingTest";
+	std::filesystem::create_directories(directory);
+
+	TestReadLevels(directory.string(), TEXTURE_COMPRESSION_BC1);
+	TestReadLevels(directory.string(), TEXTURE_COMPRESSION_BC7);
+
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+
+	return TestCheck::GetExitCode();
+}
\ No newline at end of file
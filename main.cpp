@@ -16,15 +16,88 @@
 #include <Camera2D.h>
 // Light
 #include <Light.h>
+// Texture
+#include <TextureManager.h>
+// Model
+#include <ModelBenchmark.h>
 
 // c++
 #include <list>
+#include <vector>
+#include <string>
 #include <memory>
+#include <filesystem>
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // メイン関数
 ////////////////////////////////////////////////////////////////////////////////////////////
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int) {
+
+	//=========================================================================================
+	// texture cook. "--cook-texture" の場合はwindowを作らずに終了する
+	//=========================================================================================
+	{
+		std::vector<std::string>    filePaths;
+		TextureCooker::CookOptions options;
+
+		if (TextureCooker::ParseCommandLine(lpCmdLine, filePaths, options)) {
+			CoInitializeEx(0, COINIT_MULTITHREADED);
+
+			int result = 0;
+
+			for (const auto& filePath : filePaths) {
+				if (!TextureMethod::CookTexture(filePath, options)) { //!< 失敗はCookTexture内でlog出力
+					result = 1;
+				}
+			}
+
+			CoUninitialize();
+			return result;
+		}
+	}
+
+	//=========================================================================================
+	// atlas. "--build-atlas" の場合はwindowを作らずに終了する
+	//=========================================================================================
+	{
+		std::string                outputPath;
+		std::vector<std::string>   filePaths;
+		AtlasOptions               options;
+		TextureCooker::CookOptions cookOptions;
+
+		if (AtlasPacker::ParseCommandLine(lpCmdLine, outputPath, filePaths, options, cookOptions)) {
+			CoInitializeEx(0, COINIT_MULTITHREADED);
+
+			bool result = TextureMethod::BuildAtlas(outputPath, filePaths, options, cookOptions); //!< 失敗はBuildAtlas内でlog出力
+
+			CoUninitialize();
+			return result ? 0 : 1;
+		}
+	}
+
+	//=========================================================================================
+	// obj parse計測. "--benchmark-obj" の場合はwindowを作らずに終了する. 結果はLogに出力
+	//=========================================================================================
+	{
+		std::string filePath;
+		uint32_t    faceCount      = 0;
+		uint32_t    iterationCount = 0;
+
+		if (ModelBenchmark::ParseCommandLine(lpCmdLine, filePath, faceCount, iterationCount)) {
+			if (filePath.empty()) { //!< 指定がない場合は格子を生成
+				filePath = (std::filesystem::temp_directory_path() / "benchmark_grid.obj").string();
+				ModelBenchmark::WriteGridObj(filePath, faceCount);
+			}
+
+			std::filesystem::path path(filePath);
+			std::string directoryPath = path.has_parent_path() ? path.parent_path().string() : ".";
+
+			ModelBenchmark::ObjParse(directoryPath, path.filename().string(), iterationCount);
+			ModelBenchmark::ObjParseScaling(directoryPath, path.filename().string(), iterationCount);
+
+			return 0;
+		}
+	}
 
 	//=========================================================================================
 	// 初期化